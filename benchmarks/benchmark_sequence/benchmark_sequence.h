@@ -0,0 +1,6 @@
+#ifndef BENCHMARK_SEQUENCE_H
+#define BENCHMARK_SEQUENCE_H
+
+void benchmarkSequence();
+
+#endif
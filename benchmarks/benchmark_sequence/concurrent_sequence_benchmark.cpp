@@ -0,0 +1,46 @@
+#include "../../include/ConcurrentSequence.h"
+#include "../../include/Sequence.h"
+#include "runBenchmarkMethods.h"
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <class Append>
+void appendFromThreads(size_t threads, size_t perThread, Append append) {
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			for (size_t i = 0; i < perThread; i++) {
+				append(t * perThread + i);
+			}
+		});
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+// 2e6 ints appended by 1, 8 and 64 threads: one Sequence behind a mutex against ConcurrentSequence
+void benchmarkConcurrent() {
+	const size_t total = 2000000;
+	for (size_t threads : { size_t(1), size_t(8), size_t(64) }) {
+		std::string suffix = " (" + std::to_string(threads) + " threads)";
+		runBenchmark(("push_back 2e6 ints: mutex + Sequence" + suffix).c_str(), [&] {
+			Sequence<int> seq;
+			std::mutex lock;
+			appendFromThreads(threads, total / threads, [&](size_t value) {
+				std::lock_guard<std::mutex> guard(lock);
+				seq.push_back(static_cast<int>(value));
+			});
+			keepAlive(seq);
+		});
+		runBenchmark(("push_back 2e6 ints: ConcurrentSequence" + suffix).c_str(), [&] {
+			ConcurrentSequence<int> seq;
+			appendFromThreads(threads, total / threads, [&](size_t value) {
+				seq.push_back(static_cast<int>(value));
+			});
+			keepAlive(seq.getSize());
+		});
+	}
+}
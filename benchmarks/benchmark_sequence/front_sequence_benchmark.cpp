@@ -0,0 +1,46 @@
+#include "../../include/Sequence.h"
+#include "runBenchmarkMethods.h"
+#include <deque>
+#include <string>
+
+template <class Container>
+void benchmarkQueue(const char* name, size_t depth, size_t operations) {
+	runBenchmark(name, [&] {
+		Container queue;
+		for (size_t i = 0; i < operations; i++) {
+			queue.push_back(static_cast<int>(i));
+			if (queue.size() > depth) {
+				queue.pop_front();
+			}
+		}
+		keepAlive(queue);
+	});
+}
+
+// std::deque-like adapter, so that the same loop drives both containers
+struct SequenceQueue {
+	Sequence<int> sequence;
+
+	void push_back(int value) { sequence.push_back(value); }
+	void push_front(int value) { sequence.push_front(value); }
+	void pop_front() { sequence.pop_front(); }
+	size_t size() const { return sequence.getSize(); }
+};
+
+template <class Container>
+void benchmarkPushFront(const char* name, size_t count) {
+	runBenchmark(name, [&] {
+		Container container;
+		for (size_t i = 0; i < count; i++) {
+			container.push_front(static_cast<int>(i));
+		}
+		keepAlive(container);
+	});
+}
+
+void benchmarkFront() {
+	benchmarkQueue<SequenceQueue>("queue: push_back/pop_front 1e6, depth 1e4 (Sequence)", 10000, 1000000);
+	benchmarkQueue<std::deque<int>>("queue: push_back/pop_front 1e6, depth 1e4 (deque)", 10000, 1000000);
+	benchmarkPushFront<SequenceQueue>("push_front 1e6 (Sequence)", 1000000);
+	benchmarkPushFront<std::deque<int>>("push_front 1e6 (deque)", 1000000);
+}
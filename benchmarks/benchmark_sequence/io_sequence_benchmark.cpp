@@ -0,0 +1,100 @@
+#include "../../include/SequenceBinary.h"
+#include "runBenchmarkMethods.h"
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <io.h>
+#define SEQUENCE_BENCHMARK_FILENO _fileno
+#define SEQUENCE_BENCHMARK_LSEEK _lseek
+#define SEQUENCE_BENCHMARK_WRITE _write
+#else
+#include <unistd.h>
+#define SEQUENCE_BENCHMARK_FILENO fileno
+#define SEQUENCE_BENCHMARK_LSEEK lseek
+#define SEQUENCE_BENCHMARK_WRITE write
+#endif
+
+// checkpointing 1e6 ints through the text operators against the binary format, both in memory
+void benchmarkIO() {
+	const size_t count = 1000000;
+	Sequence<int> data(count);
+	for (size_t i = 0; i < count; i++) {
+		data.push_back(static_cast<int>(i * 2654435761u));
+	}
+
+	std::string text;
+	runBenchmark("int: write 1e6 (<< per element)", [&] {
+		std::ostringstream os;
+		os << data.getSize() << ' ';
+		for (int value : data) {
+			os << value << ' ';
+		}
+		text = os.str();
+		keepAlive(text);
+	});
+	runBenchmark("int: write 1e6 (operator<< Sequence)", [&] {
+		std::ostringstream os;
+		os << data;
+		keepAlive(os);
+	});
+	runBenchmark("int: write 1e6 (print, no header)", [&] {
+		std::ostringstream os;
+		data.print(os, FormatOptions{ .header = false });
+		keepAlive(os);
+	});
+	runBenchmark("int: read 1e6 (operator>>)", [&] {
+		std::istringstream is(text);
+		Sequence<int> seq;
+		is >> seq;
+		keepAlive(seq);
+	});
+
+	std::FILE* file = std::tmpfile();
+	if (file != nullptr) {
+		int fd = SEQUENCE_BENCHMARK_FILENO(file);
+		SEQUENCE_BENCHMARK_WRITE(fd, text.data(), static_cast<unsigned>(text.size()));
+		runBenchmark("int: read 1e6 (readText, fd)", [&] {
+			SEQUENCE_BENCHMARK_LSEEK(fd, 0, SEEK_SET);
+			Sequence<int> seq;
+			readText(fd, seq);
+			keepAlive(seq);
+		});
+		std::fclose(file);
+	}
+
+	std::ostringstream decimals;
+	decimals << count << ' ';
+	for (size_t i = 0; i < count; i++) {
+		decimals << static_cast<double>(data[i]) / 7.0 << ' ';
+	}
+	const std::string doubles = decimals.str();
+	Sequence<double> fractions;
+	std::istringstream(doubles) >> fractions;
+	runBenchmark("double: write 1e6 (operator<< Sequence)", [&] {
+		std::ostringstream os;
+		os << fractions;
+		keepAlive(os);
+	});
+	runBenchmark("double: read 1e6 (operator>>)", [&] {
+		std::istringstream is(doubles);
+		Sequence<double> seq;
+		is >> seq;
+		keepAlive(seq);
+	});
+
+	std::string binary;
+	runBenchmark("int: write 1e6 (writeBinary)", [&] {
+		std::ostringstream os;
+		writeBinary(os, data);
+		binary = os.str();
+		keepAlive(binary);
+	});
+	runBenchmark("int: read 1e6 (readBinary)", [&] {
+		std::istringstream is(binary);
+		Sequence<int> seq;
+		readBinary(is, seq);
+		keepAlive(seq);
+	});
+}
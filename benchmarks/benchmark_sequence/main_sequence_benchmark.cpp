@@ -0,0 +1,22 @@
+void benchmarkRelocation();
+void benchmarkFront();
+void benchmarkRemoval();
+void benchmarkSearch();
+void benchmarkParallel();
+void benchmarkSort();
+void benchmarkIO();
+void benchmarkConcurrent();
+void benchmarkQueues();
+
+
+void benchmarkSequence() {
+	benchmarkRelocation();
+	benchmarkFront();
+	benchmarkRemoval();
+	benchmarkSearch();
+	benchmarkParallel();
+	benchmarkSort();
+	benchmarkIO();
+	benchmarkConcurrent();
+	benchmarkQueues();
+}
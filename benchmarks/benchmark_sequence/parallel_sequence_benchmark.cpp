@@ -0,0 +1,34 @@
+#include "../../include/Sequence.h"
+#include "runBenchmarkMethods.h"
+#include <cmath>
+#include <string>
+
+void benchmarkParallel() {
+	const size_t count = 8000000;
+	Sequence<double> seq(count);
+	for (size_t i = 0; i < count; i++) {
+		seq.push_back(static_cast<double>(i % 1000));
+	}
+	std::string threads = " (" + std::to_string(ThreadPool::shared().getThreadCount()) + " threads)";
+
+	runBenchmark("count in 8e6 doubles: seq", [&] {
+		keepAlive(seq.count(std::execution::seq, 7.0));
+	});
+	runBenchmark(("count in 8e6 doubles: par" + threads).c_str(), [&] {
+		keepAlive(seq.count(std::execution::par, 7.0));
+	});
+	runBenchmark("reduce 8e6 doubles: seq", [&] {
+		keepAlive(seq.reduce(std::execution::seq, 0.0, [](double a, double b) { return a + b; }));
+	});
+	runBenchmark(("reduce 8e6 doubles: par" + threads).c_str(), [&] {
+		keepAlive(seq.reduce(std::execution::par, 0.0, [](double a, double b) { return a + b; }));
+	});
+	runBenchmark("transform 8e6 doubles with sqrt: seq", [&] {
+		seq.transform(std::execution::seq, [](double value) { return std::sqrt(value); });
+		keepAlive(seq[0]);
+	});
+	runBenchmark(("transform 8e6 doubles with sqrt: par" + threads).c_str(), [&] {
+		seq.transform(std::execution::par, [](double value) { return std::sqrt(value); });
+		keepAlive(seq[0]);
+	});
+}
@@ -0,0 +1,126 @@
+#include "../../include/SequenceQueue.h"
+#include "runBenchmarkMethods.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// the hand-off the queues replace: a Sequence used as a FIFO behind a mutex and a condition variable
+struct LockedHandOff {
+	Sequence<int> items;
+	std::mutex lock;
+	std::condition_variable ready;
+
+	void push(int value) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			items.push_back(value);
+		}
+		ready.notify_one();
+	}
+	int pop() {
+		std::unique_lock<std::mutex> guard(lock);
+		ready.wait(guard, [&] { return !items.isEmpty(); });
+		int value = items.front();
+		items.pop_front();
+		return value;
+	}
+};
+
+template <class Queue>
+void handOff(Queue& queue, int count, size_t batch) {
+	std::thread producer([&] {
+		int values[64];
+		for (int next = 0; next < count;) {
+			size_t want = (batch < static_cast<size_t>(count - next)) ? batch : static_cast<size_t>(count - next);
+			for (size_t i = 0; i < want; i++) {
+				values[i] = next + static_cast<int>(i);
+			}
+			size_t pushed = (want == 1) ? (queue.tryPush(next) ? 1 : 0) : queue.tryPushN(values, want);
+			next += static_cast<int>(pushed);
+			if (pushed == 0) {
+				std::this_thread::yield();
+			}
+		}
+	});
+	int values[64];
+	long long sum = 0;
+	for (int received = 0; received < count;) {
+		size_t popped = (batch == 1) ? (queue.tryPop(values[0]) ? 1 : 0) : queue.tryPopN(values, batch);
+		for (size_t i = 0; i < popped; i++) {
+			sum += values[i];
+		}
+		received += static_cast<int>(popped);
+		if (popped == 0) {
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+	keepAlive(sum);
+}
+
+// 1e6 ints from one thread to another, one by one and in batches of 64, and the cost of a push + pop pair on one thread
+void benchmarkQueues() {
+	const int count = 1000000;
+	runBenchmark("hand off 1e6 ints: mutex + condvar Sequence", [&] {
+		LockedHandOff queue;
+		std::thread producer([&] {
+			for (int i = 0; i < count; i++) {
+				queue.push(i);
+			}
+		});
+		long long sum = 0;
+		for (int i = 0; i < count; i++) {
+			sum += queue.pop();
+		}
+		producer.join();
+		keepAlive(sum);
+	});
+	runBenchmark("hand off 1e6 ints: SpscQueue", [&] {
+		SpscQueue<int> queue(1024);
+		handOff(queue, count, 1);
+	});
+	runBenchmark("hand off 1e6 ints: SpscQueue, batches of 64", [&] {
+		SpscQueue<int> queue(1024);
+		handOff(queue, count, 64);
+	});
+	runBenchmark("hand off 1e6 ints: MpmcQueue", [&] {
+		MpmcQueue<int> queue(1024);
+		handOff(queue, count, 1);
+	});
+	runBenchmark("hand off 1e6 ints: MpmcQueue, batches of 64", [&] {
+		MpmcQueue<int> queue(1024);
+		handOff(queue, count, 64);
+	});
+
+	runBenchmark("push + pop 1e6 ints, one thread: mutex + Sequence", [&] {
+		LockedHandOff queue;
+		long long sum = 0;
+		for (int i = 0; i < count; i++) {
+			queue.push(i);
+			sum += queue.pop();
+		}
+		keepAlive(sum);
+	});
+	runBenchmark("push + pop 1e6 ints, one thread: SpscQueue", [&] {
+		SpscQueue<int> queue(64);
+		long long sum = 0;
+		int value = 0;
+		for (int i = 0; i < count; i++) {
+			queue.tryPush(i);
+			queue.tryPop(value);
+			sum += value;
+		}
+		keepAlive(sum);
+	});
+	runBenchmark("push + pop 1e6 ints, one thread: MpmcQueue", [&] {
+		MpmcQueue<int> queue(64);
+		long long sum = 0;
+		int value = 0;
+		for (int i = 0; i < count; i++) {
+			queue.tryPush(i);
+			queue.tryPop(value);
+			sum += value;
+		}
+		keepAlive(sum);
+	});
+}
@@ -0,0 +1,99 @@
+#include "../../include/Sequence.h"
+#include "runBenchmarkMethods.h"
+#include <string>
+
+// copy-only wrappers reproduce the element-by-element copy relocation Sequence used before
+struct CopiedString {
+	std::string value;
+
+	CopiedString(const std::string& value) : value(value) {}
+	CopiedString(const CopiedString& other) : value(other.value) {}
+	CopiedString& operator=(const CopiedString& other) { value = other.value; return *this; }
+};
+
+struct CopiedInt {
+	int value;
+
+	CopiedInt(int value) : value(value) {}
+	CopiedInt(const CopiedInt& other) : value(other.value) {}
+	CopiedInt& operator=(const CopiedInt& other) { value = other.value; return *this; }
+};
+
+template <class type, class Make>
+void benchmarkRelocationOf(const char* pushName, const char* insertName, const char* removeName, Make make) {
+	const size_t pushCount = 1000000;
+	const size_t shiftCount = 20000;
+	const size_t shiftRepeats = 200;
+
+	runBenchmark(pushName, [&] {
+		Sequence<type> seq(16, 16);
+		for (size_t i = 0; i < pushCount; i++) {
+			seq.push_back(type(make(i)));
+		}
+		keepAlive(seq);
+	});
+
+	Sequence<type> base(shiftCount + shiftRepeats);
+	for (size_t i = 0; i < shiftCount; i++) {
+		base.push_back(type(make(i)));
+	}
+	runBenchmark(insertName, [&] {
+		Sequence<type> seq(base);
+		for (size_t i = 0; i < shiftRepeats; i++) {
+			seq.insertAt(0, base[i]);
+		}
+		keepAlive(seq);
+	});
+	runBenchmark(removeName, [&] {
+		Sequence<type> seq(base);
+		for (size_t i = 0; i < shiftRepeats; i++) {
+			seq.removeAt(0);
+		}
+		keepAlive(seq);
+	});
+}
+
+// a + b + ... used to copy the partial result at every +, the expression now copies each operand once
+void benchmarkConcatenation() {
+	const size_t partSize = 20000;
+	const size_t repeats = 20;
+	Sequence<int> p[8];
+	for (Sequence<int>& part : p) {
+		for (size_t i = 0; i < partSize; i++) {
+			part.push_back(static_cast<int>(i));
+		}
+	}
+
+	runBenchmark("int: 8-operand + x20 (copy per step)", [&] {
+		for (size_t r = 0; r < repeats; r++) {
+			Sequence<int> result(p[0]);
+			for (size_t i = 1; i < 8; i++) {
+				Sequence<int> next(result);
+				next.concat(p[i]);
+				result = std::move(next);
+			}
+			keepAlive(result);
+		}
+	});
+	runBenchmark("int: 8-operand + x20 (one allocation)", [&] {
+		for (size_t r = 0; r < repeats; r++) {
+			Sequence<int> result = p[0] + p[1] + p[2] + p[3] + p[4] + p[5] + p[6] + p[7];
+			keepAlive(result);
+		}
+	});
+}
+
+void benchmarkRelocation() {
+	auto makeString = [](size_t i) { return std::string(48, static_cast<char>('a' + i % 26)); };
+	auto makeInt = [](size_t i) { return static_cast<int>(i); };
+
+	benchmarkRelocationOf<CopiedString>("string: push_back 1e6 (copy relocation)",
+		"string: insertAt(0) x200 on 2e4 (copy relocation)", "string: removeAt(0) x200 on 2e4 (copy relocation)", makeString);
+	benchmarkRelocationOf<std::string>("string: push_back 1e6 (move relocation)",
+		"string: insertAt(0) x200 on 2e4 (move relocation)", "string: removeAt(0) x200 on 2e4 (move relocation)", makeString);
+	benchmarkRelocationOf<CopiedInt>("int: push_back 1e6 (element-wise)",
+		"int: insertAt(0) x200 on 2e4 (element-wise)", "int: removeAt(0) x200 on 2e4 (element-wise)", makeInt);
+	benchmarkRelocationOf<int>("int: push_back 1e6 (memcpy/memmove)",
+		"int: insertAt(0) x200 on 2e4 (memcpy/memmove)", "int: removeAt(0) x200 on 2e4 (memcpy/memmove)", makeInt);
+	benchmarkConcatenation();
+}
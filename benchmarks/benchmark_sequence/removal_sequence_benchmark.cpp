@@ -0,0 +1,54 @@
+#include "../../include/Sequence.h"
+#include "runBenchmarkMethods.h"
+
+static Sequence<int> makeEntries(size_t count) {
+	Sequence<int> seq(count);
+	for (size_t i = 0; i < count; i++) {
+		seq.push_back(static_cast<int>(i % 3));
+	}
+	return seq;
+}
+
+void benchmarkRemoval() {
+	const size_t smallCount = 50000;
+	const size_t count = 1000000;
+	Sequence<int> small = makeEntries(smallCount);
+	Sequence<int> entries = makeEntries(count);
+
+	// what removeAll used to do: one removeAt, and one tail shift, per match
+	runBenchmark("removeAt per match, 1/3 of 5e4", [&] {
+		Sequence<int> seq(small);
+		for (size_t i = 0; i < seq.getSize(); i++) {
+			if (seq[i] == 0) {
+				seq.removeAt(i);
+				i--;
+			}
+		}
+		keepAlive(seq);
+	});
+	runBenchmark("removeAll, 1/3 of 5e4", [&] {
+		Sequence<int> seq(small);
+		seq.removeAll(0);
+		keepAlive(seq);
+	});
+	runBenchmark("removeAll, 1/3 of 1e6", [&] {
+		Sequence<int> seq(entries);
+		seq.removeAll(0);
+		keepAlive(seq);
+	});
+	runBenchmark("removeIf, 1/3 of 1e6", [&] {
+		Sequence<int> seq(entries);
+		seq.removeIf([](int value) { return value == 0; });
+		keepAlive(seq);
+	});
+
+	Sequence<size_t> indices(count / 3 + 1);
+	for (size_t i = 0; i < count; i += 3) {
+		indices.push_back(i);
+	}
+	runBenchmark("removeAt(indices), 1/3 of 1e6", [&] {
+		Sequence<int> seq(entries);
+		seq.removeAt(indices);
+		keepAlive(seq);
+	});
+}
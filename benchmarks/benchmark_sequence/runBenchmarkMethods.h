@@ -0,0 +1,35 @@
+#ifndef RUN_BENCHMARK_METHODS_H
+#define RUN_BENCHMARK_METHODS_H
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+template <class Func>
+double runBenchmark(const char* name, Func func, size_t repetitions = 5) {
+	double best = 0;
+	for (size_t i = 0; i < repetitions; i++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		if (i == 0 || elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+	std::cout << std::left << std::setw(56) << name << std::right << std::setw(12) << std::fixed << std::setprecision(3) << best << std::endl;
+	return best;
+}
+
+// keeps the optimizer from dropping a benchmarked result
+template <class type>
+void keepAlive(const type& value) {
+	static const void* volatile sink;
+	sink = &value;
+	(void)sink;
+#if defined(__GNUC__) || defined(__clang__)
+	// the value itself has to be computed, not only its address taken
+	asm volatile("" : : "r"(&value) : "memory");
+#endif
+}
+
+#endif
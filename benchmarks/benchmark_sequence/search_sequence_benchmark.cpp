@@ -0,0 +1,149 @@
+#include "../../include/SortedSequence.h"
+#include "runBenchmarkMethods.h"
+#include <string>
+
+template <class type>
+void benchmarkSearchOf(const char* typeName) {
+	const size_t count = 4000000;
+	Sequence<type> seq(count);
+	for (size_t i = 0; i < count; i++) {
+		seq.push_back(static_cast<type>(i % 100));
+	}
+	const type absent = static_cast<type>(101);
+
+	const SimdLevel levels[] = { SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512 };
+	const char* levelNames[] = { "scalar", "sse2", "avx2", "avx512" };
+	for (size_t i = 0; i < 4; i++) {
+		if (levels[i] > simdLevel()) {
+			break;
+		}
+		std::string findName = std::string(typeName) + ": find absent in 4e6 (" + levelNames[i] + ")";
+		runBenchmark(findName.c_str(), [&] {
+			size_t found = SimdSearch<type>::find(&seq[0], seq.getSize(), absent, levels[i]);
+			keepAlive(found);
+		});
+		std::string countName = std::string(typeName) + ": containsLotsOf in 4e6 (" + levelNames[i] + ")";
+		runBenchmark(countName.c_str(), [&] {
+			size_t found = SimdSearch<type>::count(&seq[0], seq.getSize(), static_cast<type>(7), levels[i]);
+			keepAlive(found);
+		});
+	}
+}
+
+// the element-by-element loop operator== used before
+template <class type>
+bool equalByElements(const Sequence<type>& a, const Sequence<type>& b) {
+	if (a.getSize() != b.getSize()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.getSize(); i++) {
+		if (a[i] != b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void benchmarkComparison() {
+	const size_t count = 4000000;
+	Sequence<int> a(count);
+	for (size_t i = 0; i < count; i++) {
+		a.push_back(static_cast<int>(i));
+	}
+	Sequence<int> b(a);
+	b[count - 1] = -1;
+
+	runBenchmark("int: == on 4e6, element loop", [&] {
+		bool equal = equalByElements(a, b);
+		keepAlive(equal);
+	});
+	runBenchmark("int: == on 4e6, memcmp", [&] {
+		bool equal = (a == b);
+		keepAlive(equal);
+	});
+	runBenchmark("int: <=> on 4e6, std::lexicographical_compare", [&] {
+		bool less = std::lexicographical_compare(&a[0], &a[0] + count, &b[0], &b[0] + count);
+		keepAlive(less);
+	});
+	runBenchmark("int: <=> on 4e6, vectorized mismatch", [&] {
+		bool less = (a <=> b) < 0;
+		keepAlive(less);
+	});
+}
+
+// 1000 lookups of present and absent keys
+void benchmarkSortedLookup() {
+	const size_t count = 1000000;
+	Sequence<int> seq(count);
+	for (size_t i = 0; i < count; i++) {
+		seq.push_back(static_cast<int>(i * 2));
+	}
+	SortedSequence<int> sorted(seq);
+
+	runBenchmark("int: 1000 contains in 1e6, linear", [&] {
+		size_t found = 0;
+		for (int key = 0; key < 1000; key++) {
+			found += seq.contains(key * 1999) ? 1 : 0;
+		}
+		keepAlive(found);
+	});
+	runBenchmark("int: 1000 contains in 1e6, SortedSequence", [&] {
+		size_t found = 0;
+		for (int key = 0; key < 1000; key++) {
+			found += sorted.contains(key * 1999) ? 1 : 0;
+		}
+		keepAlive(found);
+	});
+	runBenchmark("int: 1000 containsLotsOf in 1e6, SortedSequence", [&] {
+		size_t found = 0;
+		for (int key = 0; key < 1000; key++) {
+			found += sorted.containsLotsOf(key * 1999);
+		}
+		keepAlive(found);
+	});
+}
+
+// the dedup pattern: look a value up, append it when it is new
+void benchmarkIndexedLookup() {
+	const size_t count = 1000000;
+	Sequence<long long> seq(count);
+	for (size_t i = 0; i < count; i++) {
+		seq.push_back(static_cast<long long>(i * 7919 % 1000003));
+	}
+	Sequence<long long> indexed(seq);
+	indexed.enableIndex();
+
+	runBenchmark("long long: 1000 contains in 1e6, scan", [&] {
+		size_t found = 0;
+		for (long long key = 0; key < 1000; key++) {
+			found += seq.contains(key * 997) ? 1 : 0;
+		}
+		keepAlive(found);
+	});
+	runBenchmark("long long: 1000 contains in 1e6, index", [&] {
+		size_t found = 0;
+		for (long long key = 0; key < 1000; key++) {
+			found += indexed.contains(key * 997) ? 1 : 0;
+		}
+		keepAlive(found);
+	});
+	runBenchmark("long long: 1e5 contains + push_back, index", [&] {
+		Sequence<long long> unique;
+		unique.enableIndex();
+		for (size_t i = 0; i < 100000; i++) {
+			if (!unique.contains(seq[i] % 50000)) {
+				unique.push_back(seq[i] % 50000);
+			}
+		}
+		keepAlive(unique.getSize());
+	});
+}
+
+void benchmarkSearch() {
+	benchmarkSearchOf<int>("int");
+	benchmarkSearchOf<float>("float");
+	benchmarkSearchOf<short>("short");
+	benchmarkComparison();
+	benchmarkSortedLookup();
+	benchmarkIndexedLookup();
+}
@@ -0,0 +1,59 @@
+#include "../../include/Sequence.h"
+#include "runBenchmarkMethods.h"
+#include <algorithm>
+#include <random>
+#include <string>
+
+// every run sorts a fresh copy of the same shuffled data
+template <class type>
+void benchmarkSortOf(const char* typeName, size_t count) {
+	std::mt19937_64 random(1);
+	Sequence<type> data(count);
+	for (size_t i = 0; i < count; i++) {
+		data.push_back(static_cast<type>(random()));
+	}
+	std::string prefix = std::string(typeName) + ": " + std::to_string(count) + " shuffled, ";
+
+	runBenchmark((prefix + "std::sort").c_str(), [&] {
+		Sequence<type> seq(data);
+		std::sort(&seq[0], &seq[0] + seq.getSize());
+		keepAlive(seq[0]);
+	});
+	runBenchmark((prefix + "introsort").c_str(), [&] {
+		Sequence<type> seq(data);
+		seq.sort([](type a, type b) { return a < b; });
+		keepAlive(seq[0]);
+	});
+	runBenchmark((prefix + "sort (radix)").c_str(), [&] {
+		Sequence<type> seq(data);
+		seq.sort();
+		keepAlive(seq[0]);
+	});
+	runBenchmark((prefix + "sort(par)").c_str(), [&] {
+		Sequence<type> seq(data);
+		seq.sort(std::execution::par);
+		keepAlive(seq[0]);
+	});
+}
+
+void benchmarkSort() {
+	benchmarkSortOf<int>("int", 4000000);
+	benchmarkSortOf<uint64_t>("uint64_t", 4000000);
+	benchmarkSortOf<double>("double", 4000000);
+
+	std::mt19937 random(2);
+	Sequence<std::string> words(200000);
+	for (size_t i = 0; i < 200000; i++) {
+		words.push_back(std::to_string(random()));
+	}
+	runBenchmark("string: 200000 shuffled, std::sort", [&] {
+		Sequence<std::string> seq(words);
+		std::sort(&seq[0], &seq[0] + seq.getSize());
+		keepAlive(seq[0]);
+	});
+	runBenchmark("string: 200000 shuffled, sort", [&] {
+		Sequence<std::string> seq(words);
+		seq.sort();
+		keepAlive(seq[0]);
+	});
+}
@@ -0,0 +1,9 @@
+#include "benchmark_sequence/benchmark_sequence.h"
+#include <iostream>
+#define MAGENTA "\033[35m"
+#define RESET "\033[0m"
+
+void mainBenchmarking() {
+	std::cerr << MAGENTA << "BENCHMARKS (best of several runs, ms)" << RESET << std::endl;
+	benchmarkSequence();
+}
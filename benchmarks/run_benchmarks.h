@@ -0,0 +1,6 @@
+#ifndef RUN_BENCHMARKS_H
+#define RUN_BENCHMARKS_H
+
+void mainBenchmarking();
+
+#endif
@@ -0,0 +1,379 @@
+#ifndef CONCURRENT_SEQUENCE_H
+#define CONCURRENT_SEQUENCE_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#ifndef SEQUENCE_NO_UNIQUE_ADDRESS
+#if defined(_MSC_VER)
+#define SEQUENCE_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define SEQUENCE_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
+
+// Sequence that many threads append to at once. An append reserves its indices with a compare-exchange on the size,
+// retried only when another append got in first, and constructs the elements in place, so it never blocks on another
+// append unless it has to wait for a new segment.
+// Elements live in segments that are never moved or freed before the sequence is: references stay valid.
+// Segment 0 holds firstSegment elements and segment k > 0 holds firstSegment << (k - 1); the fixed table of segments
+// covers the indices below maxSize, and appends past it throw std::bad_array_new_length.
+// The thread that reserves the first index of a segment allocates it; appends into the same segment yield until it is there.
+// An element is published once its constructor has returned: isPublished(i), at(i) and operator[] may run concurrently
+// with appends, operator[] only on published indices. Indices below getSize() are reserved, not necessarily published.
+// If a segment cannot be allocated, the appends into it throw std::bad_alloc until clear().
+// clear(), reserve() and destruction must not run concurrently with anything else.
+template <class type, class Alloc = std::allocator<type>>
+class ConcurrentSequence {
+public:
+	using value_type = type;
+	using allocator_type = Alloc;
+	using size_type = size_t;
+	using reference = type&;
+	using const_reference = const type&;
+
+	static constexpr size_t firstSegment = 64;
+	// the indices the segment table covers, half the range of size_t
+	static constexpr size_t maxSize = size_t(1) << (std::numeric_limits<size_t>::digits - 1);
+
+	ConcurrentSequence() noexcept(std::is_nothrow_default_constructible_v<Alloc>) = default;
+	explicit ConcurrentSequence(const Alloc& allocator) noexcept;
+	ConcurrentSequence(const ConcurrentSequence&) = delete;
+	ConcurrentSequence& operator=(const ConcurrentSequence&) = delete;
+	~ConcurrentSequence() noexcept;
+
+	[[nodiscard]] size_t getSize() const noexcept;
+	[[nodiscard]] size_t getCapacity() const noexcept;
+	[[nodiscard]] bool isEmpty() const noexcept;
+	[[nodiscard]] bool isPublished(size_t index) const noexcept;
+	// throws std::out_of_range past the size and for an element that is not published (yet, or because its constructor threw)
+	[[nodiscard]] type& at(size_t index);
+	[[nodiscard]] const type& at(size_t index) const;
+	[[nodiscard]] type& operator[] (size_t index) noexcept;
+	[[nodiscard]] const type& operator[] (size_t index) const noexcept;
+	[[nodiscard]] Alloc get_allocator() const noexcept;
+
+	// the appends return the index of the (first) new element
+	size_t push_back(const type& value);
+	size_t push_back(type&& value);
+	template <class... Args>
+	type& emplace_back(Args&&... args);
+	// n value-initialized elements or n copies of value at consecutive indices
+	size_t grow_by(size_t count);
+	size_t grow_by(size_t count, const type& value);
+
+	// throws std::bad_array_new_length past maxSize, like the appends
+	void reserve(size_t newBiggerCapacity);
+	void clear() noexcept;
+
+private:
+	using AllocTraits = std::allocator_traits<Alloc>;
+	using StateAlloc = typename AllocTraits::template rebind_alloc<std::atomic<uint8_t>>;
+	using StateTraits = std::allocator_traits<StateAlloc>;
+
+	static constexpr uint8_t empty = 0;
+	static constexpr uint8_t published = 1;
+	static constexpr size_t firstSegmentBits = std::bit_width(firstSegment) - 1;
+	static constexpr size_t segmentCount = std::numeric_limits<size_t>::digits - firstSegmentBits;
+	static_assert((firstSegment << (segmentCount - 1)) == maxSize, "ConcurrentSequence: the segments must reach maxSize");
+
+	struct Segment {
+		std::atomic<type*> elements{ nullptr };
+		std::atomic<uint8_t>* states = nullptr;
+		std::atomic<bool> failed{ false };
+	};
+
+	Segment segments[segmentCount];
+	std::atomic<size_t> size{ 0 };
+	SEQUENCE_NO_UNIQUE_ADDRESS Alloc allocator;
+
+	[[nodiscard]] static size_t segmentOf(size_t index) noexcept;
+	[[nodiscard]] static size_t segmentStart(size_t segment) noexcept;
+	[[nodiscard]] static size_t segmentLength(size_t segment) noexcept;
+
+	void allocateSegment(size_t segment);
+	// the segment of index, allocated by this thread when it reserved the segment's first index or waited for otherwise
+	[[nodiscard]] type* segmentFor(size_t first, size_t count, size_t index);
+	[[nodiscard]] std::atomic<uint8_t>& stateOf(size_t index) const noexcept;
+	[[nodiscard]] type* slotOf(size_t index) const noexcept;
+	template <class Construct>
+	size_t append(size_t count, Construct construct);
+	void destroyAll() noexcept;
+};
+
+
+template <class type, class Alloc>
+inline ConcurrentSequence<type, Alloc>::ConcurrentSequence(const Alloc& allocator) noexcept : allocator(allocator) {}
+
+template <class type, class Alloc>
+ConcurrentSequence<type, Alloc>::~ConcurrentSequence() noexcept {
+	destroyAll();
+}
+
+template <class type, class Alloc>
+inline size_t ConcurrentSequence<type, Alloc>::segmentOf(size_t index) noexcept {
+	return static_cast<size_t>(std::bit_width(index >> firstSegmentBits));
+}
+
+template <class type, class Alloc>
+inline size_t ConcurrentSequence<type, Alloc>::segmentStart(size_t segment) noexcept {
+	return (segment == 0) ? 0 : (firstSegment << (segment - 1));
+}
+
+template <class type, class Alloc>
+inline size_t ConcurrentSequence<type, Alloc>::segmentLength(size_t segment) noexcept {
+	return (segment == 0) ? firstSegment : (firstSegment << (segment - 1));
+}
+
+template <class type, class Alloc>
+inline size_t ConcurrentSequence<type, Alloc>::getSize() const noexcept {
+	return size.load(std::memory_order_acquire);
+}
+
+template <class type, class Alloc>
+size_t ConcurrentSequence<type, Alloc>::getCapacity() const noexcept {
+	size_t capacity = 0;
+	// segments are allocated by different threads, not necessarily in order
+	for (size_t segment = 0; segment < segmentCount; segment++) {
+		if (segments[segment].elements.load(std::memory_order_acquire) != nullptr) {
+			capacity += segmentLength(segment);
+		}
+	}
+	return capacity;
+}
+
+template <class type, class Alloc>
+inline bool ConcurrentSequence<type, Alloc>::isEmpty() const noexcept {
+	return getSize() == 0;
+}
+
+template <class type, class Alloc>
+inline std::atomic<uint8_t>& ConcurrentSequence<type, Alloc>::stateOf(size_t index) const noexcept {
+	size_t segment = segmentOf(index);
+	return segments[segment].states[index - segmentStart(segment)];
+}
+
+template <class type, class Alloc>
+inline type* ConcurrentSequence<type, Alloc>::slotOf(size_t index) const noexcept {
+	size_t segment = segmentOf(index);
+	return segments[segment].elements.load(std::memory_order_acquire) + (index - segmentStart(segment));
+}
+
+template <class type, class Alloc>
+bool ConcurrentSequence<type, Alloc>::isPublished(size_t index) const noexcept {
+	if (index >= getSize() || segments[segmentOf(index)].elements.load(std::memory_order_acquire) == nullptr) {
+		return false;
+	}
+	return stateOf(index).load(std::memory_order_acquire) == published;
+}
+
+template <class type, class Alloc>
+type& ConcurrentSequence<type, Alloc>::at(size_t index) {
+	if (index >= getSize()) {
+		throw std::out_of_range("Index out of range");
+	}
+	if (!isPublished(index)) {
+		throw std::out_of_range("Element is not published yet");
+	}
+	return *slotOf(index);
+}
+
+template <class type, class Alloc>
+const type& ConcurrentSequence<type, Alloc>::at(size_t index) const {
+	if (index >= getSize()) {
+		throw std::out_of_range("Index out of range");
+	}
+	if (!isPublished(index)) {
+		throw std::out_of_range("Element is not published yet");
+	}
+	return *slotOf(index);
+}
+
+template <class type, class Alloc>
+inline type& ConcurrentSequence<type, Alloc>::operator[](size_t index) noexcept {
+	return *slotOf(index);
+}
+
+template <class type, class Alloc>
+inline const type& ConcurrentSequence<type, Alloc>::operator[](size_t index) const noexcept {
+	return *slotOf(index);
+}
+
+template <class type, class Alloc>
+inline Alloc ConcurrentSequence<type, Alloc>::get_allocator() const noexcept {
+	return allocator;
+}
+
+template <class type, class Alloc>
+void ConcurrentSequence<type, Alloc>::allocateSegment(size_t segment) {
+	Segment& target = segments[segment];
+	size_t length = segmentLength(segment);
+	StateAlloc stateAllocator(allocator);
+	std::atomic<uint8_t>* states = nullptr;
+	type* elements = nullptr;
+	try {
+		states = StateTraits::allocate(stateAllocator, length);
+		for (size_t i = 0; i < length; i++) {
+			new (states + i) std::atomic<uint8_t>(empty);
+		}
+		elements = AllocTraits::allocate(allocator, length);
+	}
+	catch (...) {
+		if (states != nullptr) {
+			StateTraits::deallocate(stateAllocator, states, length);
+		}
+		target.failed.store(true, std::memory_order_release);
+		throw;
+	}
+	target.states = states;
+	target.elements.store(elements, std::memory_order_release);
+}
+
+template <class type, class Alloc>
+type* ConcurrentSequence<type, Alloc>::segmentFor(size_t first, size_t count, size_t index) {
+	size_t segment = segmentOf(index);
+	Segment& target = segments[segment];
+	type* elements = target.elements.load(std::memory_order_acquire);
+	if (elements != nullptr) {
+		return elements;
+	}
+	size_t start = segmentStart(segment);
+	if (start >= first && start - first < count) {
+		allocateSegment(segment);
+		return target.elements.load(std::memory_order_relaxed);
+	}
+	while ((elements = target.elements.load(std::memory_order_acquire)) == nullptr) {
+		if (target.failed.load(std::memory_order_acquire)) {
+			throw std::bad_alloc();
+		}
+		std::this_thread::yield();
+	}
+	return elements;
+}
+
+template <class type, class Alloc>
+template <class Construct>
+size_t ConcurrentSequence<type, Alloc>::append(size_t count, Construct construct) {
+	if (count == 0) {
+		return getSize();
+	}
+	size_t first = size.load(std::memory_order_relaxed);
+	do {
+		if (count > maxSize - first) {
+			throw std::bad_array_new_length();
+		}
+	} while (!size.compare_exchange_weak(first, first + count, std::memory_order_acq_rel, std::memory_order_relaxed));
+	size_t index = first;
+	try {
+		while (index < first + count) {
+			size_t segment = segmentOf(index);
+			type* elements = segmentFor(first, count, index);
+			size_t start = segmentStart(segment);
+			size_t end = (start + segmentLength(segment) < first + count) ? start + segmentLength(segment) : first + count;
+			for (; index < end; index++) {
+				construct(elements + (index - start));
+				segments[segment].states[index - start].store(published, std::memory_order_release);
+			}
+		}
+	}
+	catch (...) {
+		// the indices left stay unpublished, but the appends waiting for a segment this one reserved must not wait forever
+		for (size_t segment = segmentOf(index) + 1; segment < segmentCount && segmentStart(segment) < first + count; segment++) {
+			if (segments[segment].elements.load(std::memory_order_acquire) == nullptr && !segments[segment].failed.load(std::memory_order_acquire)) {
+				try {
+					allocateSegment(segment);
+				}
+				catch (...) {}
+			}
+		}
+		throw;
+	}
+	return first;
+}
+
+template <class type, class Alloc>
+size_t ConcurrentSequence<type, Alloc>::push_back(const type& value) {
+	return append(1, [&](type* slot) { AllocTraits::construct(allocator, slot, value); });
+}
+
+template <class type, class Alloc>
+size_t ConcurrentSequence<type, Alloc>::push_back(type&& value) {
+	return append(1, [&](type* slot) { AllocTraits::construct(allocator, slot, std::move(value)); });
+}
+
+template <class type, class Alloc>
+template <class... Args>
+type& ConcurrentSequence<type, Alloc>::emplace_back(Args&&... args) {
+	type* constructed = nullptr;
+	append(1, [&](type* slot) {
+		AllocTraits::construct(allocator, slot, std::forward<Args>(args)...);
+		constructed = slot;
+	});
+	return *constructed;
+}
+
+template <class type, class Alloc>
+size_t ConcurrentSequence<type, Alloc>::grow_by(size_t count) {
+	return append(count, [&](type* slot) { AllocTraits::construct(allocator, slot); });
+}
+
+template <class type, class Alloc>
+size_t ConcurrentSequence<type, Alloc>::grow_by(size_t count, const type& value) {
+	return append(count, [&](type* slot) { AllocTraits::construct(allocator, slot, value); });
+}
+
+template <class type, class Alloc>
+void ConcurrentSequence<type, Alloc>::reserve(size_t newBiggerCapacity) {
+	if (newBiggerCapacity > maxSize) {
+		throw std::bad_array_new_length();
+	}
+	for (size_t segment = 0; segment < segmentCount && segmentStart(segment) < newBiggerCapacity; segment++) {
+		if (segments[segment].elements.load(std::memory_order_relaxed) == nullptr) {
+			segments[segment].failed.store(false, std::memory_order_relaxed);
+			allocateSegment(segment);
+		}
+	}
+}
+
+template <class type, class Alloc>
+void ConcurrentSequence<type, Alloc>::clear() noexcept {
+	destroyAll();
+}
+
+template <class type, class Alloc>
+void ConcurrentSequence<type, Alloc>::destroyAll() noexcept {
+	size_t count = size.load(std::memory_order_acquire);
+	StateAlloc stateAllocator(allocator);
+	for (size_t segment = 0; segment < segmentCount; segment++) {
+		Segment& target = segments[segment];
+		type* elements = target.elements.load(std::memory_order_acquire);
+		if (elements == nullptr) {
+			target.failed.store(false, std::memory_order_relaxed);
+			continue;
+		}
+		size_t length = segmentLength(segment);
+		size_t start = segmentStart(segment);
+		for (size_t i = 0; i < length && start + i < count; i++) {
+			if (target.states[i].load(std::memory_order_acquire) == published) {
+				AllocTraits::destroy(allocator, elements + i);
+			}
+		}
+		AllocTraits::deallocate(allocator, elements, length);
+		StateTraits::deallocate(stateAllocator, target.states, length);
+		target.elements.store(nullptr, std::memory_order_relaxed);
+		target.states = nullptr;
+		target.failed.store(false, std::memory_order_relaxed);
+	}
+	size.store(0, std::memory_order_release);
+}
+
+#endif
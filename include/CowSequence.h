@@ -0,0 +1,591 @@
+#ifndef COW_SEQUENCE_H
+#define COW_SEQUENCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "Sequence.h"
+
+// Copy-on-write Sequence: copies share one reference-counted buffer, and a copy gets its own buffer only when
+// it is first modified (detached). The count is atomic, so copies may be made, read and destroyed on different threads;
+// a single CowSequence still needs the same synchronization as a Sequence.
+// Non-const operator[], at, front, back, data, begin, end, emplace* and edit detach as well, because the returned
+// references can write, and they mark the buffer unsharable: later copies get their own buffer at once, so a write
+// through such a reference never shows in a copy. It stays unsharable until the sequence is cleared or assigned to;
+// read through a const reference to keep sharing.
+template <class type, class Alloc = std::allocator<type>, class GrowthPolicy = GeometricGrowth<>>
+class CowSequence {
+public:
+	using Base = Sequence<type, Alloc, GrowthPolicy>;
+	using value_type = type;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = type&;
+	using const_reference = const type&;
+	using iterator = type*;
+	using const_iterator = const type*;
+
+	// process-wide for each element type: copies that shared a buffer and detaches that had to copy it
+	struct Statistics {
+		size_t sharedCopies;
+		size_t detaches;
+	};
+
+	CowSequence(size_t capacity = 100, size_t capacityGrowthStep = 100, const Alloc& allocator = Alloc());
+	CowSequence(const Base& sequence);
+	CowSequence(Base&& sequence);
+	CowSequence(const CowSequence&);
+	CowSequence(CowSequence&&) noexcept;
+	~CowSequence() noexcept;
+
+	CowSequence& operator=(const CowSequence&);
+	CowSequence& operator=(CowSequence&&) noexcept;
+
+	[[nodiscard]] static Statistics statistics() noexcept;
+	static void resetStatistics() noexcept;
+	// how many CowSequences share this buffer, 0 for a moved-from one
+	[[nodiscard]] size_t useCount() const noexcept;
+	[[nodiscard]] bool isShared() const noexcept;
+
+	[[nodiscard]] const Base& asSequence() const noexcept;
+	// detaches and gives access to the whole Sequence API
+	[[nodiscard]] Base& edit();
+
+	[[nodiscard]] size_t getSize() const noexcept;
+	[[nodiscard]] size_t getCapacity() const noexcept;
+	[[nodiscard]] bool isEmpty() const noexcept;
+	[[nodiscard]] size_t find(const type&) const;
+	[[nodiscard]] size_t findFirst(const type&) const;
+	[[nodiscard]] size_t findLast(const type&) const;
+	[[nodiscard]] bool contains(const type&) const;
+	[[nodiscard]] size_t containsLotsOf(const type&) const;
+	[[nodiscard]] SequenceView<type> slice(size_t from, size_t to) const;
+	[[nodiscard]] SequenceView<type> first(size_t count) const;
+	[[nodiscard]] SequenceView<type> last(size_t count) const;
+
+	[[nodiscard]] const type& front() const;
+	[[nodiscard]] const type& back() const;
+	[[nodiscard]] const type& at(size_t) const;
+	[[nodiscard]] const type& operator[] (size_t) const;
+	[[nodiscard]] const type* data() const noexcept;
+	[[nodiscard]] const_iterator begin() const noexcept;
+	[[nodiscard]] const_iterator end() const noexcept;
+	[[nodiscard]] const_iterator cbegin() const noexcept;
+	[[nodiscard]] const_iterator cend() const noexcept;
+
+	[[nodiscard]] type& front();
+	[[nodiscard]] type& back();
+	[[nodiscard]] type& at(size_t);
+	[[nodiscard]] type& operator[] (size_t);
+	[[nodiscard]] type* data();
+	[[nodiscard]] iterator begin();
+	[[nodiscard]] iterator end();
+
+	CowSequence& push_back(const type&);
+	CowSequence& push_back(type&&);
+	CowSequence& push_front(const type&);
+	CowSequence& push_front(type&&);
+	template <class... Args>
+	type& emplace_back(Args&&...);
+	template <class... Args>
+	type& emplace_front(Args&&...);
+	CowSequence& insertAt(size_t index, const type& value);
+	CowSequence& insertAt(size_t index, type&& value);
+	CowSequence& changeAt(size_t index, const type& value);
+	CowSequence& changeAt(size_t index, type&& value);
+	CowSequence& changeAll(const type& previousValue, const type& nextValue);
+	CowSequence& removeAt(size_t);
+	CowSequence& removeAll(const type&);
+	template <class Predicate>
+	size_t removeIf(Predicate);
+	CowSequence& pop_back();
+	CowSequence& pop_front();
+	// a shared buffer is left to the other copies instead of being copied and emptied
+	void clear();
+	void reserve(size_t newBiggerCapacity);
+	CowSequence& sort();
+
+	void print() const;
+	void print(std::ostream& os, const FormatOptions& options) const;
+	[[nodiscard]] bool operator==(const CowSequence&) const;
+	[[nodiscard]] bool operator!=(const CowSequence&) const;
+
+private:
+	struct Shared {
+		std::atomic<size_t> owners;
+		// only changed by the single owner, so it needs no synchronization
+		bool sharable = true;
+		Base sequence;
+
+		Shared(Base&& sequence) : owners(1), sequence(std::move(sequence)) {}
+	};
+	using SharedAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Shared>;
+	using SharedTraits = std::allocator_traits<SharedAlloc>;
+
+	Shared* shared = nullptr;
+	// a moved-from sequence keeps these for the buffer it builds on its next write
+	SEQUENCE_NO_UNIQUE_ADDRESS Alloc allocator;
+	size_t capacityGrowthStep;
+
+	static inline std::atomic<size_t> sharedCopies{ 0 };
+	static inline std::atomic<size_t> detaches{ 0 };
+
+	[[nodiscard]] static Shared* share(Base&& sequence);
+	static void release(Shared* shared) noexcept;
+	[[nodiscard]] static const Base& emptySequence();
+	[[nodiscard]] const Base& read() const noexcept;
+	[[nodiscard]] Base& write();
+	// write() for callers that hand out a reference into the buffer
+	[[nodiscard]] Base& leak();
+};
+
+
+template <class type, class Alloc, class GrowthPolicy>
+typename CowSequence<type, Alloc, GrowthPolicy>::Shared* CowSequence<type, Alloc, GrowthPolicy>::share(Base&& sequence) {
+	SharedAlloc allocator(sequence.getAllocator());
+	Shared* shared = SharedTraits::allocate(allocator, 1);
+	try {
+		SharedTraits::construct(allocator, shared, std::move(sequence));
+	}
+	catch (...) {
+		SharedTraits::deallocate(allocator, shared, 1);
+		throw;
+	}
+	return shared;
+}
+
+// the last owner sees every write of the others, they happened before their decrements
+template <class type, class Alloc, class GrowthPolicy>
+void CowSequence<type, Alloc, GrowthPolicy>::release(Shared* shared) noexcept {
+	if (shared != nullptr && shared->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		SharedAlloc allocator(shared->sequence.getAllocator());
+		SharedTraits::destroy(allocator, shared);
+		SharedTraits::deallocate(allocator, shared, 1);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+const typename CowSequence<type, Alloc, GrowthPolicy>::Base& CowSequence<type, Alloc, GrowthPolicy>::emptySequence() {
+	static const Base empty(size_t(0), size_t(100));
+	return empty;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const typename CowSequence<type, Alloc, GrowthPolicy>::Base& CowSequence<type, Alloc, GrowthPolicy>::read() const noexcept {
+	return (shared != nullptr) ? shared->sequence : emptySequence();
+}
+
+// a count of 1 cannot grow behind our back: only this object refers to the buffer
+template <class type, class Alloc, class GrowthPolicy>
+typename CowSequence<type, Alloc, GrowthPolicy>::Base& CowSequence<type, Alloc, GrowthPolicy>::write() {
+	if (shared == nullptr) {
+		shared = share(Base(100, capacityGrowthStep, allocator));
+	}
+	else if (shared->owners.load(std::memory_order_acquire) != 1) {
+		Shared* own = share(Base(shared->sequence));
+		release(shared);
+		shared = own;
+		detaches.fetch_add(1, std::memory_order_relaxed);
+	}
+	return shared->sequence;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::Base& CowSequence<type, Alloc, GrowthPolicy>::leak() {
+	Base& sequence = write();
+	shared->sharable = false;
+	return sequence;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>::CowSequence(size_t capacity, size_t capacityGrowthStep, const Alloc& allocator)
+	: shared(share(Base(capacity, capacityGrowthStep, allocator))), allocator(allocator), capacityGrowthStep(capacityGrowthStep) {}
+
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>::CowSequence(const Base& sequence)
+	: shared(share(Base(sequence))), allocator(sequence.getAllocator()), capacityGrowthStep(sequence.getCapacityGrowthStep()) {}
+
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>::CowSequence(Base&& sequence)
+	: allocator(sequence.getAllocator()), capacityGrowthStep(sequence.getCapacityGrowthStep()) {
+	shared = share(std::move(sequence));
+}
+
+// an unsharable buffer is copied right away, references into it may still write
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>::CowSequence(const CowSequence& other)
+	: allocator(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.allocator)), capacityGrowthStep(other.capacityGrowthStep) {
+	if (other.shared != nullptr && !other.shared->sharable) {
+		shared = share(Base(other.shared->sequence));
+		return;
+	}
+	shared = other.shared;
+	if (shared != nullptr) {
+		shared->owners.fetch_add(1, std::memory_order_relaxed);
+		sharedCopies.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>::CowSequence(CowSequence&& other) noexcept
+	: shared(other.shared), allocator(other.allocator), capacityGrowthStep(other.capacityGrowthStep) {
+	other.shared = nullptr;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>::~CowSequence() noexcept {
+	release(shared);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::operator=(const CowSequence& other) {
+	if (shared != other.shared) {
+		CowSequence copy(other);
+		std::swap(shared, copy.shared);
+		if constexpr (std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value) {
+			allocator = other.allocator;
+		}
+		capacityGrowthStep = other.capacityGrowthStep;
+	}
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::operator=(CowSequence&& other) noexcept {
+	if (this != &other) {
+		release(shared);
+		shared = other.shared;
+		other.shared = nullptr;
+		if constexpr (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) {
+			allocator = other.allocator;
+		}
+		capacityGrowthStep = other.capacityGrowthStep;
+	}
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::Statistics CowSequence<type, Alloc, GrowthPolicy>::statistics() noexcept {
+	return Statistics{ sharedCopies.load(std::memory_order_relaxed), detaches.load(std::memory_order_relaxed) };
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void CowSequence<type, Alloc, GrowthPolicy>::resetStatistics() noexcept {
+	sharedCopies.store(0, std::memory_order_relaxed);
+	detaches.store(0, std::memory_order_relaxed);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::useCount() const noexcept {
+	return (shared != nullptr) ? shared->owners.load(std::memory_order_relaxed) : 0;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline bool CowSequence<type, Alloc, GrowthPolicy>::isShared() const noexcept {
+	return useCount() > 1;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const typename CowSequence<type, Alloc, GrowthPolicy>::Base& CowSequence<type, Alloc, GrowthPolicy>::asSequence() const noexcept {
+	return read();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::Base& CowSequence<type, Alloc, GrowthPolicy>::edit() {
+	return leak();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::getSize() const noexcept {
+	return read().getSize();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::getCapacity() const noexcept {
+	return read().getCapacity();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline bool CowSequence<type, Alloc, GrowthPolicy>::isEmpty() const noexcept {
+	return read().isEmpty();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::find(const type& value) const {
+	return read().find(value);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::findFirst(const type& value) const {
+	return read().findFirst(value);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::findLast(const type& value) const {
+	return read().findLast(value);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline bool CowSequence<type, Alloc, GrowthPolicy>::contains(const type& value) const {
+	return read().contains(value);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::containsLotsOf(const type& value) const {
+	return read().containsLotsOf(value);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceView<type> CowSequence<type, Alloc, GrowthPolicy>::slice(size_t from, size_t to) const {
+	return read().slice(from, to);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceView<type> CowSequence<type, Alloc, GrowthPolicy>::first(size_t count) const {
+	return read().first(count);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceView<type> CowSequence<type, Alloc, GrowthPolicy>::last(size_t count) const {
+	return read().last(count);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& CowSequence<type, Alloc, GrowthPolicy>::front() const {
+	return read().front();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& CowSequence<type, Alloc, GrowthPolicy>::back() const {
+	return read().back();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& CowSequence<type, Alloc, GrowthPolicy>::at(size_t index) const {
+	return read().at(index);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& CowSequence<type, Alloc, GrowthPolicy>::operator[](size_t index) const {
+	return read()[index];
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const type* CowSequence<type, Alloc, GrowthPolicy>::data() const noexcept {
+	return read().data();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::const_iterator CowSequence<type, Alloc, GrowthPolicy>::begin() const noexcept {
+	return read().begin();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::const_iterator CowSequence<type, Alloc, GrowthPolicy>::end() const noexcept {
+	return read().end();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::const_iterator CowSequence<type, Alloc, GrowthPolicy>::cbegin() const noexcept {
+	return read().cbegin();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::const_iterator CowSequence<type, Alloc, GrowthPolicy>::cend() const noexcept {
+	return read().cend();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline type& CowSequence<type, Alloc, GrowthPolicy>::front() {
+	return leak().front();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline type& CowSequence<type, Alloc, GrowthPolicy>::back() {
+	return leak().back();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline type& CowSequence<type, Alloc, GrowthPolicy>::at(size_t index) {
+	// a bad index must not cost a copy
+	if (index >= getSize()) {
+		throw std::out_of_range("Index out of range");
+	}
+	return leak()[index];
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline type& CowSequence<type, Alloc, GrowthPolicy>::operator[](size_t index) {
+	return leak()[index];
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline type* CowSequence<type, Alloc, GrowthPolicy>::data() {
+	return leak().data();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::iterator CowSequence<type, Alloc, GrowthPolicy>::begin() {
+	return leak().begin();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename CowSequence<type, Alloc, GrowthPolicy>::iterator CowSequence<type, Alloc, GrowthPolicy>::end() {
+	return leak().end();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::push_back(const type& value) {
+	write().push_back(value);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::push_back(type&& value) {
+	write().push_back(std::move(value));
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::push_front(const type& value) {
+	write().push_front(value);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::push_front(type&& value) {
+	write().push_front(std::move(value));
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class... Args>
+inline type& CowSequence<type, Alloc, GrowthPolicy>::emplace_back(Args&&... args) {
+	return leak().emplace_back(std::forward<Args>(args)...);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class... Args>
+inline type& CowSequence<type, Alloc, GrowthPolicy>::emplace_front(Args&&... args) {
+	return leak().emplace_front(std::forward<Args>(args)...);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::insertAt(size_t index, const type& value) {
+	write().insertAt(index, value);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::insertAt(size_t index, type&& value) {
+	write().insertAt(index, std::move(value));
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::changeAt(size_t index, const type& value) {
+	write().changeAt(index, value);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::changeAt(size_t index, type&& value) {
+	write().changeAt(index, std::move(value));
+	return *this;
+}
+
+// nothing to change means nothing to copy
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::changeAll(const type& previousValue, const type& nextValue) {
+	if (read().contains(previousValue)) {
+		write().changeAll(previousValue, nextValue);
+	}
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::removeAt(size_t index) {
+	write().removeAt(index);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::removeAll(const type& value) {
+	if (read().contains(value)) {
+		write().removeAll(value);
+	}
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Predicate>
+inline size_t CowSequence<type, Alloc, GrowthPolicy>::removeIf(Predicate predicate) {
+	return write().removeIf(predicate);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::pop_back() {
+	if (!isEmpty()) {
+		write().pop_back();
+	}
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::pop_front() {
+	if (!isEmpty()) {
+		write().pop_front();
+	}
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void CowSequence<type, Alloc, GrowthPolicy>::clear() {
+	if (shared != nullptr && shared->owners.load(std::memory_order_acquire) != 1) {
+		const Base& current = shared->sequence;
+		Shared* own = share(Base(current.getCapacity(), current.getCapacityGrowthStep(), current.getAllocator()));
+		release(shared);
+		shared = own;
+		return;
+	}
+	if (shared != nullptr) {
+		shared->sequence.clear();
+		shared->sharable = true;
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void CowSequence<type, Alloc, GrowthPolicy>::reserve(size_t newBiggerCapacity) {
+	if (newBiggerCapacity > getCapacity()) {
+		write().reserve(newBiggerCapacity);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline CowSequence<type, Alloc, GrowthPolicy>& CowSequence<type, Alloc, GrowthPolicy>::sort() {
+	write().sort();
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void CowSequence<type, Alloc, GrowthPolicy>::print() const {
+	read().print();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void CowSequence<type, Alloc, GrowthPolicy>::print(std::ostream& os, const FormatOptions& options) const {
+	read().print(os, options);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+bool CowSequence<type, Alloc, GrowthPolicy>::operator==(const CowSequence& other) const {
+	return shared == other.shared || read() == other.read();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline bool CowSequence<type, Alloc, GrowthPolicy>::operator!=(const CowSequence& other) const {
+	return !(*this == other);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+#include <limits>
+
+// A growth policy answers two questions for Sequence:
+//   grow(capacity, required, step, elementSize) - capacity to use when an insertion overflows the buffer;
+//   fit(required, elementSize)                  - capacity to use when the caller asks for room explicitly (reserve).
+// Both must return a value >= required.
+
+struct LinearGrowth {
+	[[nodiscard]] static size_t grow(size_t capacity, size_t required, size_t step, size_t elementSize) noexcept;
+	[[nodiscard]] static size_t fit(size_t required, size_t elementSize) noexcept;
+};
+
+// capacity * numerator / denominator; the growth step is kept as the minimal increment
+// so that small sequences do not reallocate on every other insertion
+template <size_t numerator = 2, size_t denominator = 1>
+struct GeometricGrowth {
+	static_assert(denominator != 0 && numerator > denominator, "GeometricGrowth: factor must be greater than 1");
+
+	[[nodiscard]] static size_t grow(size_t capacity, size_t required, size_t step, size_t elementSize) noexcept;
+	[[nodiscard]] static size_t fit(size_t required, size_t elementSize) noexcept;
+};
+
+// rounds whatever BasePolicy decides up to a whole number of pages
+template <class BasePolicy = GeometricGrowth<>, size_t pageSize = 4096>
+struct PageRoundedGrowth {
+	static_assert(pageSize != 0, "PageRoundedGrowth: page size cannot be 0");
+
+	[[nodiscard]] static size_t grow(size_t capacity, size_t required, size_t step, size_t elementSize) noexcept;
+	[[nodiscard]] static size_t fit(size_t required, size_t elementSize) noexcept;
+	[[nodiscard]] static size_t roundToPages(size_t capacity, size_t elementSize) noexcept;
+};
+
+
+inline size_t LinearGrowth::grow(size_t capacity, size_t required, size_t step, size_t) noexcept {
+	size_t grown = (capacity > std::numeric_limits<size_t>::max() - step) ? std::numeric_limits<size_t>::max() : capacity + step;
+	return (grown < required) ? required : grown;
+}
+
+inline size_t LinearGrowth::fit(size_t required, size_t) noexcept {
+	return required;
+}
+
+template <size_t numerator, size_t denominator>
+size_t GeometricGrowth<numerator, denominator>::grow(size_t capacity, size_t required, size_t step, size_t elementSize) noexcept {
+	size_t grown = (capacity > std::numeric_limits<size_t>::max() / numerator) ? std::numeric_limits<size_t>::max()
+		: capacity * numerator / denominator;
+	size_t linear = LinearGrowth::grow(capacity, required, step, elementSize);
+	return (grown < linear) ? linear : grown;
+}
+
+template <size_t numerator, size_t denominator>
+inline size_t GeometricGrowth<numerator, denominator>::fit(size_t required, size_t) noexcept {
+	return required;
+}
+
+template <class BasePolicy, size_t pageSize>
+inline size_t PageRoundedGrowth<BasePolicy, pageSize>::grow(size_t capacity, size_t required, size_t step, size_t elementSize) noexcept {
+	return roundToPages(BasePolicy::grow(capacity, required, step, elementSize), elementSize);
+}
+
+template <class BasePolicy, size_t pageSize>
+inline size_t PageRoundedGrowth<BasePolicy, pageSize>::fit(size_t required, size_t elementSize) noexcept {
+	return roundToPages(BasePolicy::fit(required, elementSize), elementSize);
+}
+
+template <class BasePolicy, size_t pageSize>
+size_t PageRoundedGrowth<BasePolicy, pageSize>::roundToPages(size_t capacity, size_t elementSize) noexcept {
+	if (elementSize == 0 || capacity > std::numeric_limits<size_t>::max() / elementSize) {
+		return capacity;
+	}
+	size_t bytes = capacity * elementSize;
+	size_t pages = bytes / pageSize + (bytes % pageSize != 0);
+	if (pages > std::numeric_limits<size_t>::max() / pageSize) {
+		return capacity;
+	}
+	return pages * pageSize / elementSize;
+}
+
+#endif
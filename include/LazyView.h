@@ -0,0 +1,331 @@
+#ifndef LAZY_VIEW_H
+#define LAZY_VIEW_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "GrowthPolicy.h"
+
+// Lazy adaptors: seq.filtered(p).mapped(f).take(n) builds no intermediate sequences, the elements are produced
+// one by one while the view is iterated or collected. A view hands out cursors (done(), get(), next()) and
+// the iterators only wrap them. Every stage runs once per element it sees: a filter keeps the value it tested
+// when its source produces values, so a mapped function before it is not run again by get(). Views hold their source, predicate and function by value but the elements by pointer,
+// so they are valid only while the sequence is alive and unchanged.
+
+template <class type, class Alloc, class GrowthPolicy>
+class Sequence;
+
+template <class Source, class Predicate>
+class FilteredView;
+template <class Source, class Function>
+class MappedView;
+template <class Source>
+class TakeView;
+template <class Source>
+class DropView;
+
+template <class Cursor>
+class LazyIterator {
+private:
+	Cursor cursor;
+public:
+	using value_type = typename Cursor::value_type;
+	using difference_type = std::ptrdiff_t;
+	using iterator_concept = std::input_iterator_tag;
+
+	LazyIterator() = default;
+	explicit LazyIterator(Cursor cursor) : cursor(std::move(cursor)) {}
+
+	[[nodiscard]] decltype(auto) operator*() const { return cursor.get(); }
+	LazyIterator& operator++() { cursor.next(); return *this; }
+	void operator++(int) { cursor.next(); }
+	[[nodiscard]] bool operator==(std::default_sentinel_t) const { return cursor.done(); }
+};
+
+// CRTP base with the chaining and the terminal operations. A view provides value_type, cursor(), isSized and,
+// when isSized is true, knownSize().
+template <class View>
+class LazyView {
+public:
+	template <class Predicate>
+	[[nodiscard]] FilteredView<View, Predicate> filtered(Predicate predicate) const;
+	template <class Function>
+	[[nodiscard]] MappedView<View, Function> mapped(Function function) const;
+	[[nodiscard]] TakeView<View> take(size_t count) const;
+	[[nodiscard]] DropView<View> drop(size_t count) const;
+
+	[[nodiscard]] auto begin() const;
+	[[nodiscard]] std::default_sentinel_t end() const noexcept;
+	// O(1) when the size is known, otherwise one pass that runs the predicates and the mapped functions feeding them,
+	// but no mapped function after the last filter
+	[[nodiscard]] size_t count() const;
+	// a Sequence with the allocator, rebound to the elements, and growth policy given; a known size is allocated once,
+	// otherwise the elements are collected in one pass and the spare capacity is trimmed
+	template <class Growth = GeometricGrowth<>>
+	[[nodiscard]] auto collect() const;
+	template <class Growth = GeometricGrowth<>, class Alloc>
+	[[nodiscard]] auto collect(const Alloc& allocator) const;
+
+private:
+	[[nodiscard]] const View& self() const noexcept;
+};
+
+template <class Source, class Predicate>
+class FilteredView : public LazyView<FilteredView<Source, Predicate>> {
+private:
+	using SourceCursor = decltype(std::declval<const Source&>().cursor());
+	// a source handing out values rather than references is read once per element, get() returns the kept value
+	static constexpr bool keepsValue = !std::is_reference_v<decltype(std::declval<const SourceCursor&>().get())>;
+	struct NoValue {};
+
+	Source source;
+	Predicate predicate;
+public:
+	using value_type = typename Source::value_type;
+	static constexpr bool isSized = false;
+
+	struct Cursor {
+		using value_type = typename Source::value_type;
+
+		SourceCursor source;
+		const Predicate* predicate = nullptr;
+		std::conditional_t<keepsValue, std::optional<value_type>, NoValue> current{};
+
+		[[nodiscard]] bool done() const { return source.done(); }
+		[[nodiscard]] decltype(auto) get() const {
+			if constexpr (keepsValue) {
+				return std::as_const(*current);
+			}
+			else {
+				return source.get();
+			}
+		}
+		void next() { source.next(); skip(); }
+		void skip() {
+			for (; !source.done(); source.next()) {
+				if constexpr (keepsValue) {
+					current.emplace(source.get());
+					if (std::invoke(*predicate, std::as_const(*current))) {
+						return;
+					}
+				}
+				else if (std::invoke(*predicate, source.get())) {
+					return;
+				}
+			}
+		}
+	};
+
+	FilteredView(Source source, Predicate predicate);
+	[[nodiscard]] Cursor cursor() const;
+};
+
+template <class Source, class Function>
+class MappedView : public LazyView<MappedView<Source, Function>> {
+private:
+	using SourceCursor = decltype(std::declval<const Source&>().cursor());
+
+	Source source;
+	Function function;
+public:
+	using value_type = std::remove_cvref_t<std::invoke_result_t<const Function&, decltype(std::declval<const SourceCursor&>().get())>>;
+	static constexpr bool isSized = Source::isSized;
+
+	struct Cursor {
+		using value_type = MappedView::value_type;
+
+		SourceCursor source;
+		const Function* function = nullptr;
+
+		[[nodiscard]] bool done() const { return source.done(); }
+		[[nodiscard]] decltype(auto) get() const { return std::invoke(*function, source.get()); }
+		void next() { source.next(); }
+	};
+
+	MappedView(Source source, Function function);
+	[[nodiscard]] Cursor cursor() const;
+	[[nodiscard]] size_t knownSize() const;
+};
+
+template <class Source>
+class TakeView : public LazyView<TakeView<Source>> {
+private:
+	using SourceCursor = decltype(std::declval<const Source&>().cursor());
+
+	Source source;
+	size_t limit;
+public:
+	using value_type = typename Source::value_type;
+	static constexpr bool isSized = Source::isSized;
+
+	struct Cursor {
+		using value_type = typename Source::value_type;
+
+		SourceCursor source;
+		size_t remaining = 0;
+
+		[[nodiscard]] bool done() const { return remaining == 0 || source.done(); }
+		[[nodiscard]] decltype(auto) get() const { return source.get(); }
+		// the source is not advanced past the last element taken, so no predicate runs beyond it
+		void next() {
+			if (--remaining != 0) {
+				source.next();
+			}
+		}
+	};
+
+	TakeView(Source source, size_t limit);
+	[[nodiscard]] Cursor cursor() const;
+	[[nodiscard]] size_t knownSize() const;
+};
+
+template <class Source>
+class DropView : public LazyView<DropView<Source>> {
+private:
+	Source source;
+	size_t skipped;
+public:
+	using value_type = typename Source::value_type;
+	static constexpr bool isSized = Source::isSized;
+
+	DropView(Source source, size_t skipped);
+	[[nodiscard]] auto cursor() const;
+	[[nodiscard]] size_t knownSize() const;
+};
+
+
+template <class View>
+inline const View& LazyView<View>::self() const noexcept {
+	return static_cast<const View&>(*this);
+}
+
+template <class View>
+template <class Predicate>
+inline FilteredView<View, Predicate> LazyView<View>::filtered(Predicate predicate) const {
+	return FilteredView<View, Predicate>(self(), std::move(predicate));
+}
+
+template <class View>
+template <class Function>
+inline MappedView<View, Function> LazyView<View>::mapped(Function function) const {
+	return MappedView<View, Function>(self(), std::move(function));
+}
+
+template <class View>
+inline TakeView<View> LazyView<View>::take(size_t count) const {
+	return TakeView<View>(self(), count);
+}
+
+template <class View>
+inline DropView<View> LazyView<View>::drop(size_t count) const {
+	return DropView<View>(self(), count);
+}
+
+template <class View>
+inline auto LazyView<View>::begin() const {
+	return LazyIterator<decltype(self().cursor())>(self().cursor());
+}
+
+template <class View>
+inline std::default_sentinel_t LazyView<View>::end() const noexcept {
+	return std::default_sentinel;
+}
+
+template <class View>
+size_t LazyView<View>::count() const {
+	if constexpr (View::isSized) {
+		return self().knownSize();
+	}
+	else {
+		size_t counter = 0;
+		for (auto cursor = self().cursor(); !cursor.done(); cursor.next()) {
+			counter++;
+		}
+		return counter;
+	}
+}
+
+template <class View>
+template <class Growth>
+inline auto LazyView<View>::collect() const {
+	return collect<Growth>(std::allocator<typename View::value_type>());
+}
+
+// views of unknown size are not counted first: that would run their predicates and mapped functions twice
+template <class View>
+template <class Growth, class Alloc>
+auto LazyView<View>::collect(const Alloc& allocator) const {
+	using value_type = typename View::value_type;
+	using ElementAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<value_type>;
+	Sequence<value_type, ElementAlloc, Growth> result(View::isSized ? count() : 0, 100, ElementAlloc(allocator));
+	for (auto cursor = self().cursor(); !cursor.done(); cursor.next()) {
+		result.emplace_back(cursor.get());
+	}
+	if constexpr (!View::isSized) {
+		result.shrink_to_fit();
+	}
+	return result;
+}
+
+template <class Source, class Predicate>
+inline FilteredView<Source, Predicate>::FilteredView(Source source, Predicate predicate) : source(std::move(source)),
+	predicate(std::move(predicate)) {}
+
+template <class Source, class Predicate>
+typename FilteredView<Source, Predicate>::Cursor FilteredView<Source, Predicate>::cursor() const {
+	Cursor cursor{ source.cursor(), &predicate };
+	cursor.skip();
+	return cursor;
+}
+
+template <class Source, class Function>
+inline MappedView<Source, Function>::MappedView(Source source, Function function) : source(std::move(source)),
+	function(std::move(function)) {}
+
+template <class Source, class Function>
+inline typename MappedView<Source, Function>::Cursor MappedView<Source, Function>::cursor() const {
+	return Cursor{ source.cursor(), &function };
+}
+
+template <class Source, class Function>
+inline size_t MappedView<Source, Function>::knownSize() const {
+	return source.knownSize();
+}
+
+template <class Source>
+inline TakeView<Source>::TakeView(Source source, size_t limit) : source(std::move(source)), limit(limit) {}
+
+template <class Source>
+inline typename TakeView<Source>::Cursor TakeView<Source>::cursor() const {
+	return Cursor{ source.cursor(), limit };
+}
+
+template <class Source>
+inline size_t TakeView<Source>::knownSize() const {
+	size_t available = source.knownSize();
+	return (limit < available) ? limit : available;
+}
+
+template <class Source>
+inline DropView<Source>::DropView(Source source, size_t skipped) : source(std::move(source)), skipped(skipped) {}
+
+template <class Source>
+auto DropView<Source>::cursor() const {
+	auto cursor = source.cursor();
+	for (size_t i = 0; i < skipped && !cursor.done(); i++) {
+		cursor.next();
+	}
+	return cursor;
+}
+
+template <class Source>
+inline size_t DropView<Source>::knownSize() const {
+	size_t available = source.knownSize();
+	return (skipped < available) ? available - skipped : 0;
+}
+
+#endif
@@ -0,0 +1,692 @@
+#ifndef MAPPED_SEQUENCE_H
+#define MAPPED_SEQUENCE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include "SequenceBinary.h"
+#include "SequenceView.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+enum class AccessHint {
+	Normal,
+	Sequential,
+	Random,
+	WillNeed
+};
+
+// Sequence of trivially copyable elements living in a memory-mapped file, in the format of writeBinary:
+// the 32-byte header followed by the raw elements, so readBinary loads such a file and writeBinary output opens here.
+// Opening maps the file instead of reading it, and processes mapping the same file share the page cache.
+// Growing extends the file (ftruncate) and the mapping (mremap on Linux, a new mapping elsewhere), which moves
+// the elements: like Sequence, pointers and views are invalidated by push_back and reserve.
+// The count in the header is written by sync() and close(); after a crash the file still opens, with the last synced count.
+// MappedSequence<const type> maps the file read-only: it has no modifiers and its accessors hand out const references,
+// so a write fails to compile instead of faulting on the read-only pages.
+template <class type>
+class MappedSequence {
+public:
+	using value_type = std::remove_const_t<type>;
+private:
+	static_assert(std::is_trivially_copyable_v<value_type>, "MappedSequence: elements must be trivially copyable");
+	static_assert(alignof(value_type) <= SequenceBinary::headerSize, "MappedSequence: elements must fit the alignment after the header");
+	static_assert(SequenceBinary::isRawReadable<value_type>, "MappedSequence: enums need a fixed underlying type");
+	static constexpr bool readOnly = std::is_const_v<type>;
+public:
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = type&;
+	using const_reference = const type&;
+	using iterator = type*;
+	using const_iterator = const type*;
+
+	// a writable sequence creates the file when it does not exist; throws std::system_error on I/O failures
+	// and SequenceFormatError when the file holds something else than a sequence of this type
+	explicit MappedSequence(const std::string& path);
+	MappedSequence(const MappedSequence&) = delete;
+	MappedSequence& operator=(const MappedSequence&) = delete;
+	MappedSequence(MappedSequence&&) noexcept;
+	MappedSequence& operator=(MappedSequence&&) noexcept;
+	~MappedSequence() noexcept;
+
+	[[nodiscard]] size_t getSize() const noexcept;
+	[[nodiscard]] size_t getCapacity() const noexcept;
+	[[nodiscard]] bool isEmpty() const noexcept;
+	[[nodiscard]] bool isOpen() const noexcept;
+	[[nodiscard]] static constexpr bool isReadOnly() noexcept;
+
+	[[nodiscard]] size_t find(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] size_t findFirst(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] size_t findLast(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] bool contains(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] size_t containsLotsOf(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] SequenceView<value_type> slice(size_t from, size_t to) const;
+	[[nodiscard]] SequenceView<value_type> first(size_t count) const;
+	[[nodiscard]] SequenceView<value_type> last(size_t count) const;
+	[[nodiscard]] operator SequenceView<value_type>() const noexcept;
+
+	[[nodiscard]] type& at(size_t);
+	[[nodiscard]] const type& at(size_t) const;
+	[[nodiscard]] type& operator[] (size_t) noexcept;
+	[[nodiscard]] const type& operator[] (size_t) const noexcept;
+	[[nodiscard]] type& front();
+	[[nodiscard]] type& back();
+	[[nodiscard]] const type& front() const;
+	[[nodiscard]] const type& back() const;
+	[[nodiscard]] type* data() noexcept;
+	[[nodiscard]] const type* data() const noexcept;
+	[[nodiscard]] iterator begin() noexcept;
+	[[nodiscard]] iterator end() noexcept;
+	[[nodiscard]] const_iterator begin() const noexcept;
+	[[nodiscard]] const_iterator end() const noexcept;
+
+	// the modifiers throw std::logic_error once the sequence is closed and std::bad_array_new_length past maxCapacity
+	MappedSequence& push_back(const value_type&) requires (!readOnly);
+	MappedSequence& push_back(const value_type*, size_t) requires (!readOnly);
+	MappedSequence& pop_back() requires (!readOnly);
+	void clear() requires (!readOnly);
+	void reserve(size_t newBiggerCapacity) requires (!readOnly);
+
+	// writes the header and flushes the dirty pages to the file, nothing to do on a read-only mapping
+	void sync();
+	// madvise on POSIX; on Windows only WillNeed does something (PrefetchVirtualMemory)
+	void advise(AccessHint hint) const;
+	// syncs, trims the file to the elements in use and unmaps it
+	void close();
+
+	static constexpr size_t maxCapacity = (static_cast<size_t>(-1) - SequenceBinary::headerSize) / sizeof(type);
+
+private:
+	static constexpr size_t headerSize = SequenceBinary::headerSize;
+	static constexpr size_t initialBytes = 4096;
+
+#if defined(_WIN32)
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#else
+	int fd = -1;
+#endif
+	unsigned char* base = nullptr;
+	size_t mappedBytes = 0;
+	size_t size = 0;
+	size_t capacity = 0;
+
+	[[nodiscard]] type* elements() const noexcept;
+	void requireOpen() const;
+	void writeHeader() noexcept;
+	void grow(size_t required);
+	void release() noexcept;
+
+	void openFile(const std::string& path);
+	[[nodiscard]] size_t fileSize() const;
+	void resizeFile(size_t bytes);
+	void map(size_t bytes);
+	void remap(size_t bytes);
+	void unmap() noexcept;
+	void closeFile() noexcept;
+	[[noreturn]] static void fail(const char* what);
+};
+
+
+template <class type>
+MappedSequence<type>::MappedSequence(const std::string& path) {
+	openFile(path);
+	try {
+		size_t bytes = fileSize();
+		if (bytes == 0 && !readOnly) {
+			// a new file: header, then room for a page of elements
+			bytes = (initialBytes > headerSize + sizeof(type)) ? initialBytes : headerSize + sizeof(type);
+			resizeFile(bytes);
+			map(bytes);
+			writeHeader();
+		}
+		else {
+			if (bytes < headerSize) {
+				throw SequenceFormatError("Truncated header", bytes);
+			}
+			map(bytes);
+			SequenceBinary::Header header = SequenceBinary::decodeHeader(base);
+			SequenceBinary::checkHeader<value_type, SequenceBinary::Raw>(header);
+			if (header.endianness != SequenceBinary::nativeEndianness) {
+				throw SequenceFormatError("Payload endianness differs, the file cannot be mapped", 6);
+			}
+			if (header.payloadBytes > bytes - headerSize) {
+				throw SequenceFormatError("Truncated payload", bytes);
+			}
+			size = static_cast<size_t>(header.count);
+			size_t invalid = SequenceBinary::findInvalid(reinterpret_cast<const value_type*>(base + headerSize), size);
+			if (invalid != size) {
+				throw SequenceFormatError("Element " + std::to_string(invalid) + " is not a value of the element type",
+					headerSize + invalid * sizeof(type));
+			}
+		}
+		capacity = (mappedBytes - headerSize) / sizeof(type);
+	}
+	catch (...) {
+		release();
+		throw;
+	}
+}
+
+template <class type>
+MappedSequence<type>::MappedSequence(MappedSequence&& other) noexcept :
+#if defined(_WIN32)
+	file(other.file), mapping(other.mapping),
+#else
+	fd(other.fd),
+#endif
+	base(other.base), mappedBytes(other.mappedBytes), size(other.size), capacity(other.capacity) {
+#if defined(_WIN32)
+	other.file = INVALID_HANDLE_VALUE;
+	other.mapping = nullptr;
+#else
+	other.fd = -1;
+#endif
+	other.base = nullptr;
+	other.mappedBytes = other.size = other.capacity = 0;
+}
+
+template <class type>
+MappedSequence<type>& MappedSequence<type>::operator=(MappedSequence&& other) noexcept {
+	if (this != &other) {
+		this->~MappedSequence();
+		new (this) MappedSequence(std::move(other));
+	}
+	return *this;
+}
+
+template <class type>
+MappedSequence<type>::~MappedSequence() noexcept {
+	try {
+		close();
+	}
+	catch (...) {
+		release();
+	}
+}
+
+template <class type>
+inline type* MappedSequence<type>::elements() const noexcept {
+	return reinterpret_cast<type*>(base + headerSize);
+}
+
+template <class type>
+inline void MappedSequence<type>::requireOpen() const {
+	if (base == nullptr) {
+		throw std::logic_error("MappedSequence: not open for writing");
+	}
+}
+
+template <class type>
+inline void MappedSequence<type>::writeHeader() noexcept {
+	SequenceBinary::Header header = SequenceBinary::headerFor<value_type, SequenceBinary::Raw>(size, size * sizeof(type));
+	SequenceBinary::encodeHeader(header, base);
+}
+
+template <class type>
+inline size_t MappedSequence<type>::getSize() const noexcept {
+	return size;
+}
+
+template <class type>
+inline size_t MappedSequence<type>::getCapacity() const noexcept {
+	return capacity;
+}
+
+template <class type>
+inline bool MappedSequence<type>::isEmpty() const noexcept {
+	return size == 0;
+}
+
+template <class type>
+inline bool MappedSequence<type>::isOpen() const noexcept {
+	return base != nullptr;
+}
+
+template <class type>
+constexpr bool MappedSequence<type>::isReadOnly() noexcept {
+	return readOnly;
+}
+
+template <class type>
+inline size_t MappedSequence<type>::find(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return SequenceView<value_type>(*this).find(value);
+}
+
+template <class type>
+inline size_t MappedSequence<type>::findFirst(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return SequenceView<value_type>(*this).find(value);
+}
+
+template <class type>
+inline size_t MappedSequence<type>::findLast(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return SequenceView<value_type>(*this).findLast(value);
+}
+
+template <class type>
+inline bool MappedSequence<type>::contains(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return SequenceView<value_type>(*this).contains(value);
+}
+
+template <class type>
+inline size_t MappedSequence<type>::containsLotsOf(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return SequenceView<value_type>(*this).containsLotsOf(value);
+}
+
+template <class type>
+inline SequenceView<typename MappedSequence<type>::value_type> MappedSequence<type>::slice(size_t from, size_t to) const {
+	return SequenceView<value_type>(*this).slice(from, to);
+}
+
+template <class type>
+inline SequenceView<typename MappedSequence<type>::value_type> MappedSequence<type>::first(size_t count) const {
+	return SequenceView<value_type>(*this).first(count);
+}
+
+template <class type>
+inline SequenceView<typename MappedSequence<type>::value_type> MappedSequence<type>::last(size_t count) const {
+	return SequenceView<value_type>(*this).last(count);
+}
+
+template <class type>
+inline MappedSequence<type>::operator SequenceView<value_type>() const noexcept {
+	return SequenceView<value_type>((base != nullptr) ? elements() : nullptr, size);
+}
+
+template <class type>
+inline type& MappedSequence<type>::at(size_t index) {
+	if (index >= size) {
+		throw std::out_of_range("Index out of range");
+	}
+	return elements()[index];
+}
+
+template <class type>
+inline const type& MappedSequence<type>::at(size_t index) const {
+	if (index >= size) {
+		throw std::out_of_range("Index out of range");
+	}
+	return elements()[index];
+}
+
+template <class type>
+inline type& MappedSequence<type>::operator[](size_t index) noexcept {
+	return elements()[index];
+}
+
+template <class type>
+inline const type& MappedSequence<type>::operator[](size_t index) const noexcept {
+	return elements()[index];
+}
+
+template <class type>
+inline type& MappedSequence<type>::front() {
+	if (isEmpty()) {
+		throw std::out_of_range("Cannot call front() on an empty MappedSequence");
+	}
+	return elements()[0];
+}
+
+template <class type>
+inline type& MappedSequence<type>::back() {
+	if (isEmpty()) {
+		throw std::out_of_range("Cannot call back() on an empty MappedSequence");
+	}
+	return elements()[size - 1];
+}
+
+template <class type>
+inline const type& MappedSequence<type>::front() const {
+	if (isEmpty()) {
+		throw std::out_of_range("Cannot call front() on an empty MappedSequence");
+	}
+	return elements()[0];
+}
+
+template <class type>
+inline const type& MappedSequence<type>::back() const {
+	if (isEmpty()) {
+		throw std::out_of_range("Cannot call back() on an empty MappedSequence");
+	}
+	return elements()[size - 1];
+}
+
+template <class type>
+inline type* MappedSequence<type>::data() noexcept {
+	return (base != nullptr) ? elements() : nullptr;
+}
+
+template <class type>
+inline const type* MappedSequence<type>::data() const noexcept {
+	return (base != nullptr) ? elements() : nullptr;
+}
+
+template <class type>
+inline typename MappedSequence<type>::iterator MappedSequence<type>::begin() noexcept {
+	return data();
+}
+
+template <class type>
+inline typename MappedSequence<type>::iterator MappedSequence<type>::end() noexcept {
+	return data() + size;
+}
+
+template <class type>
+inline typename MappedSequence<type>::const_iterator MappedSequence<type>::begin() const noexcept {
+	return data();
+}
+
+template <class type>
+inline typename MappedSequence<type>::const_iterator MappedSequence<type>::end() const noexcept {
+	return data() + size;
+}
+
+template <class type>
+MappedSequence<type>& MappedSequence<type>::push_back(const value_type& value) requires (!readOnly) {
+	requireOpen();
+	if (size == capacity) {
+		// value may live in the mapping that is about to move
+		type copy = value;
+		grow(size + 1);
+		elements()[size++] = copy;
+		return *this;
+	}
+	elements()[size++] = value;
+	return *this;
+}
+
+template <class type>
+MappedSequence<type>& MappedSequence<type>::push_back(const value_type* values, size_t count) requires (!readOnly) {
+	requireOpen();
+	if (count > maxCapacity - size) {
+		throw std::bad_array_new_length();
+	}
+	if (count > capacity - size) {
+		if (values >= data() && values < data() + capacity) {
+			size_t offset = static_cast<size_t>(values - data());
+			grow(size + count);
+			values = data() + offset;
+		}
+		else {
+			grow(size + count);
+		}
+	}
+	std::memmove(static_cast<void*>(elements() + size), values, count * sizeof(type));
+	size += count;
+	return *this;
+}
+
+template <class type>
+MappedSequence<type>& MappedSequence<type>::pop_back() requires (!readOnly) {
+	requireOpen();
+	if (size > 0) {
+		size--;
+	}
+	return *this;
+}
+
+template <class type>
+void MappedSequence<type>::clear() requires (!readOnly) {
+	requireOpen();
+	size = 0;
+}
+
+template <class type>
+void MappedSequence<type>::reserve(size_t newBiggerCapacity) requires (!readOnly) {
+	requireOpen();
+	if (newBiggerCapacity > maxCapacity) {
+		throw std::bad_array_new_length();
+	}
+	if (newBiggerCapacity > capacity) {
+		resizeFile(headerSize + newBiggerCapacity * sizeof(type));
+		remap(headerSize + newBiggerCapacity * sizeof(type));
+		capacity = newBiggerCapacity;
+	}
+}
+
+// doubling keeps the number of remaps logarithmic
+template <class type>
+void MappedSequence<type>::grow(size_t required) {
+	size_t doubled = (capacity > maxCapacity / 2) ? maxCapacity : capacity * 2;
+	reserve((doubled < required) ? required : doubled);
+}
+
+template <class type>
+void MappedSequence<type>::sync() {
+	if (readOnly || base == nullptr) {
+		return;
+	}
+	writeHeader();
+#if defined(_WIN32)
+	if (!FlushViewOfFile(base, mappedBytes) || !FlushFileBuffers(file)) {
+		fail("MappedSequence: FlushViewOfFile");
+	}
+#else
+	if (::msync(base, mappedBytes, MS_SYNC) != 0) {
+		fail("MappedSequence: msync");
+	}
+#endif
+}
+
+template <class type>
+void MappedSequence<type>::advise(AccessHint hint) const {
+	if (base == nullptr) {
+		return;
+	}
+#if defined(_WIN32)
+	if (hint == AccessHint::WillNeed) {
+		WIN32_MEMORY_RANGE_ENTRY range{ base, mappedBytes };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+#else
+	int advice = (hint == AccessHint::Sequential) ? MADV_SEQUENTIAL
+		: (hint == AccessHint::Random) ? MADV_RANDOM
+		: (hint == AccessHint::WillNeed) ? MADV_WILLNEED : MADV_NORMAL;
+	if (::madvise(base, mappedBytes, advice) != 0) {
+		fail("MappedSequence: madvise");
+	}
+#endif
+}
+
+template <class type>
+void MappedSequence<type>::close() {
+	if (base == nullptr) {
+		closeFile();
+		return;
+	}
+	if constexpr (!readOnly) {
+		sync();
+		unmap();
+		resizeFile(headerSize + size * sizeof(type));
+	}
+	release();
+}
+
+template <class type>
+void MappedSequence<type>::release() noexcept {
+	unmap();
+	closeFile();
+	size = capacity = 0;
+}
+
+template <class type>
+inline void MappedSequence<type>::fail(const char* what) {
+#if defined(_WIN32)
+	throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+#else
+	throw std::system_error(errno, std::generic_category(), what);
+#endif
+}
+
+#if defined(_WIN32)
+
+template <class type>
+void MappedSequence<type>::openFile(const std::string& path) {
+	bool writable = !readOnly;
+	file = CreateFileA(path.c_str(), writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		nullptr, writable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		fail("MappedSequence: CreateFile");
+	}
+}
+
+template <class type>
+size_t MappedSequence<type>::fileSize() const {
+	LARGE_INTEGER bytes;
+	if (!GetFileSizeEx(file, &bytes)) {
+		fail("MappedSequence: GetFileSizeEx");
+	}
+	return static_cast<size_t>(bytes.QuadPart);
+}
+
+template <class type>
+void MappedSequence<type>::resizeFile(size_t bytes) {
+	LARGE_INTEGER position;
+	position.QuadPart = static_cast<LONGLONG>(bytes);
+	// the file cannot change size while a view of it is mapped
+	bool mapped = base != nullptr;
+	if (mapped) {
+		unmap();
+	}
+	if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+		fail("MappedSequence: SetEndOfFile");
+	}
+	if (mapped) {
+		map(bytes);
+	}
+}
+
+template <class type>
+void MappedSequence<type>::map(size_t bytes) {
+	bool writable = !readOnly;
+	mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+		static_cast<DWORD>(static_cast<uint64_t>(bytes) >> 32), static_cast<DWORD>(bytes), nullptr);
+	if (mapping == nullptr) {
+		fail("MappedSequence: CreateFileMapping");
+	}
+	base = static_cast<unsigned char*>(MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, bytes));
+	if (base == nullptr) {
+		fail("MappedSequence: MapViewOfFile");
+	}
+	mappedBytes = bytes;
+}
+
+template <class type>
+void MappedSequence<type>::remap(size_t bytes) {
+	if (mappedBytes != bytes) {
+		unmap();
+		map(bytes);
+	}
+}
+
+template <class type>
+void MappedSequence<type>::unmap() noexcept {
+	if (base != nullptr) {
+		UnmapViewOfFile(base);
+		base = nullptr;
+	}
+	if (mapping != nullptr) {
+		CloseHandle(mapping);
+		mapping = nullptr;
+	}
+	mappedBytes = 0;
+}
+
+template <class type>
+void MappedSequence<type>::closeFile() noexcept {
+	if (file != INVALID_HANDLE_VALUE) {
+		CloseHandle(file);
+		file = INVALID_HANDLE_VALUE;
+	}
+}
+
+#else
+
+template <class type>
+void MappedSequence<type>::openFile(const std::string& path) {
+	fd = !readOnly ? ::open(path.c_str(), O_RDWR | O_CREAT, 0644) : ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		fail("MappedSequence: open");
+	}
+}
+
+template <class type>
+size_t MappedSequence<type>::fileSize() const {
+	struct stat status;
+	if (::fstat(fd, &status) != 0) {
+		fail("MappedSequence: fstat");
+	}
+	return static_cast<size_t>(status.st_size);
+}
+
+template <class type>
+void MappedSequence<type>::resizeFile(size_t bytes) {
+	if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+		fail("MappedSequence: ftruncate");
+	}
+}
+
+template <class type>
+void MappedSequence<type>::map(size_t bytes) {
+	int protection = !readOnly ? (PROT_READ | PROT_WRITE) : PROT_READ;
+	void* address = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+	if (address == MAP_FAILED) {
+		fail("MappedSequence: mmap");
+	}
+	base = static_cast<unsigned char*>(address);
+	mappedBytes = bytes;
+}
+
+// mremap can extend the mapping in place or move it without touching the pages
+template <class type>
+void MappedSequence<type>::remap(size_t bytes) {
+#if defined(__linux__)
+	void* address = ::mremap(base, mappedBytes, bytes, MREMAP_MAYMOVE);
+	if (address == MAP_FAILED) {
+		fail("MappedSequence: mremap");
+	}
+	base = static_cast<unsigned char*>(address);
+	mappedBytes = bytes;
+#else
+	unmap();
+	map(bytes);
+#endif
+}
+
+template <class type>
+void MappedSequence<type>::unmap() noexcept {
+	if (base != nullptr) {
+		::munmap(base, mappedBytes);
+		base = nullptr;
+	}
+	mappedBytes = 0;
+}
+
+template <class type>
+void MappedSequence<type>::closeFile() noexcept {
+	if (fd >= 0) {
+		::close(fd);
+		fd = -1;
+	}
+}
+
+#endif
+
+#endif
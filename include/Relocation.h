@@ -0,0 +1,128 @@
+#ifndef RELOCATION_H
+#define RELOCATION_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Types for which moving an object to another address and forgetting the source
+// is the same as copying its bytes. Specialize it for your own types, e.g.
+//   template <> struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
+template <class type>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<type>> {};
+
+template <class type>
+inline constexpr bool isTriviallyRelocatable = IsTriviallyRelocatable<type>::value;
+
+// Element moves on raw storage. Slots are either live (hold a constructed object) or raw.
+template <class type>
+struct Relocation {
+	static constexpr bool isNothrow = isTriviallyRelocatable<type> || std::is_nothrow_move_constructible_v<type>;
+
+	// constructs copies of [source, source + count) in the raw slots at destination through the allocator
+	template <class Alloc>
+	static void copy(Alloc& allocator, const type* source, size_t count, type* destination);
+	// moves live [source, source + count) to raw destination, the source slots become raw
+	static void relocate(type* source, size_t count, type* destination) noexcept(isNothrow);
+	// live [first, first + count) moves to [first + gap, first + gap + count), [first, first + gap) becomes raw
+	static void openGap(type* first, size_t count, size_t gap) noexcept(isNothrow && std::is_nothrow_move_assignable_v<type>);
+	// live [first + gap, first + gap + count) moves to [first, first + count), the gap ends up raw at the back
+	static void closeGap(type* first, size_t gap, size_t count) noexcept(isNothrow && std::is_nothrow_move_assignable_v<type>);
+};
+
+
+template <class type>
+template <class Alloc>
+void Relocation<type>::copy(Alloc& allocator, const type* source, size_t count, type* destination) {
+	if constexpr (std::is_trivially_copyable_v<type>) {
+		if (count > 0) {
+			std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(type));
+		}
+	}
+	else {
+		size_t constructed = 0;
+		try {
+			for (; constructed < count; ++constructed) {
+				std::allocator_traits<Alloc>::construct(allocator, destination + constructed, source[constructed]);
+			}
+		}
+		catch (...) {
+			std::destroy_n(destination, constructed);
+			throw;
+		}
+	}
+}
+
+template <class type>
+void Relocation<type>::relocate(type* source, size_t count, type* destination) noexcept(isNothrow) {
+	if constexpr (isTriviallyRelocatable<type>) {
+		if (count > 0) {
+			std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(type));
+		}
+	}
+	else if constexpr (std::is_nothrow_move_constructible_v<type>) {
+		for (size_t i = 0; i < count; ++i) {
+			new (destination + i) type(std::move(source[i]));
+		}
+		std::destroy_n(source, count);
+	}
+	else {
+		size_t constructed = 0;
+		try {
+			for (; constructed < count; ++constructed) {
+				new (destination + constructed) type(std::move_if_noexcept(source[constructed]));
+			}
+		}
+		catch (...) {
+			std::destroy_n(destination, constructed);
+			throw;
+		}
+		std::destroy_n(source, count);
+	}
+}
+
+template <class type>
+void Relocation<type>::openGap(type* first, size_t count, size_t gap) noexcept(isNothrow && std::is_nothrow_move_assignable_v<type>) {
+	if (count == 0 || gap == 0) {
+		return;
+	}
+	if constexpr (isTriviallyRelocatable<type>) {
+		std::memmove(static_cast<void*>(first + gap), static_cast<const void*>(first), count * sizeof(type));
+	}
+	else {
+		// sources from rawFrom on land in raw slots, the ones before it are assigned over live ones
+		size_t rawFrom = (count > gap) ? count - gap : 0;
+		for (size_t i = count; i-- > rawFrom;) {
+			new (first + i + gap) type(std::move(first[i]));
+		}
+		for (size_t i = rawFrom; i-- > 0;) {
+			first[i + gap] = std::move(first[i]);
+		}
+		std::destroy_n(first, (gap < count) ? gap : count);
+	}
+}
+
+template <class type>
+void Relocation<type>::closeGap(type* first, size_t gap, size_t count) noexcept(isNothrow && std::is_nothrow_move_assignable_v<type>) {
+	if (count == 0 || gap == 0) {
+		return;
+	}
+	if constexpr (isTriviallyRelocatable<type>) {
+		std::memmove(static_cast<void*>(first), static_cast<const void*>(first + gap), count * sizeof(type));
+	}
+	else {
+		size_t rawUntil = (gap < count) ? gap : count;
+		for (size_t i = 0; i < rawUntil; ++i) {
+			new (first + i) type(std::move(first[i + gap]));
+		}
+		for (size_t i = rawUntil; i < count; ++i) {
+			first[i] = std::move(first[i + gap]);
+		}
+		std::destroy(first + ((gap > count) ? gap : count), first + gap + count);
+	}
+}
+
+#endif
@@ -3,21 +3,127 @@
 
 #include <string>
 #include <iostream>
-
+#include <memory>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstring>
+#include <execution>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
+#include "GrowthPolicy.h"
+#include "Relocation.h"
+#include "SequenceIndex.h"
+#include "SequenceSort.h"
+#include "SequenceText.h"
+#include "SequenceView.h"
+#include "SimdSearch.h"
+#include "ThreadPool.h"
+
+#if defined(_MSC_VER)
+#define SEQUENCE_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define SEQUENCE_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+class SmallSequence;
+
+// what operator<=> returns: the category of the elements' own <=>, or a weak ordering built from their operator<
 template <class type>
+using SequenceOrdering = typename std::conditional_t<std::three_way_comparable<type>,
+	std::compare_three_way_result<type>, std::type_identity<std::weak_ordering>>::type;
+
+// std::execution::par and par_unseq run on ThreadPool::shared(), seq and unseq on the calling thread
+template <class Policy>
+concept ExecutionPolicy = std::is_execution_policy_v<std::remove_cvref_t<Policy>>;
+
+template <class type, class Alloc = std::allocator<type>, class GrowthPolicy = GeometricGrowth<>>
 class Sequence {
+	static_assert(std::is_same_v<typename std::allocator_traits<Alloc>::value_type, type>, "Sequence: Alloc::value_type must be the element type");
+
+	using AllocTraits = std::allocator_traits<Alloc>;
+	static constexpr bool isMoveAssignNoexcept = AllocTraits::propagate_on_container_move_assignment::value
+		|| AllocTraits::is_always_equal::value;
 private:
 	size_t size;
 	size_t capacity;
-	type* elements = nullptr;
+	type* storage = nullptr;//start of the buffer
+	type* elements = nullptr;//first element, the slots between storage and elements are free
 	size_t capacityGrowthStep = 100;//not NULL
+	SEQUENCE_NO_UNIQUE_ADDRESS Alloc allocator;
+	std::unique_ptr<SequenceIndex<type>> valueIndex;//only after enableIndex()
+
+	[[nodiscard]] type* allocateStorage(size_t);
+	void deallocateStorage(type*, size_t) noexcept;
+	void releaseStorage() noexcept;
+	void destroyTail(size_t newSize) noexcept;
+	[[nodiscard]] bool owns(const type*) const noexcept;
+	[[nodiscard]] size_t frontRoom() const noexcept;
+	[[nodiscard]] size_t backRoom() const noexcept;
+	[[nodiscard]] bool hasSlackFor(size_t count) const noexcept;
+	void moveBlockTo(size_t head);
+	void reallocate(size_t newCapacity, size_t head, size_t gapIndex, size_t gapCount);
+	void openGapAt(size_t index, size_t count);
+	void closeGapAt(size_t index, size_t count);
+	// emplace_back without touching the index beyond recording the new element
+	template <class... Args>
+	type& constructBack(Args&&...);
+	[[nodiscard]] static SequenceOrdering<type> compareElements(const type&, const type&);
+	template <class Policy>
+	[[nodiscard]] bool runsInParallel() const noexcept;
+	template <class Compare>
+	static constexpr bool sortsByRadix = SequenceSort<type>::hasRadix && (std::is_same_v<Compare, std::less<type>> || std::is_same_v<Compare, std::less<>>);
+	template <class Policy, class Compare>
+	Sequence& sortElements(Compare comp, bool stable);
+	void indexInserted(size_t position, size_t count) noexcept;
+	void indexErasing(size_t position) noexcept;
+	void indexForget(size_t position) noexcept;
+	void indexRemember(size_t position) noexcept;
+	void invalidateIndex() noexcept;
+	void copyIndexSetting(const Sequence&);
+	[[nodiscard]] const SequenceIndex<type>* freshIndex() const noexcept;
+	[[nodiscard]] size_t indexSizeInBytes() const noexcept;
+
+	template <class, size_t, class, class>
+	friend class SmallSequence;
+	template <class, class, class, class>
+	friend class SortedSequence;
+	friend class SequenceBinary;
+	template <class, class>
+	friend class QueueStorage;
 public:
-	Sequence(size_t capacity = 100, size_t capacityGrowthStep = 100);
-	Sequence(const type* elems, const size_t size, size_t capacity = 100,size_t capacityGrowthStep = 100);
-	Sequence(const Sequence<type>&);
+	using value_type = type;
+	using allocator_type = Alloc;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = type&;
+	using const_reference = const type&;
+	using pointer = type*;
+	using const_pointer = const type*;
+	// the elements are contiguous, so plain pointers are the iterators
+	using iterator = type*;
+	using const_iterator = const type*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	Sequence(size_t capacity = 100, size_t capacityGrowthStep = 100, const Alloc& allocator = Alloc());
+	Sequence(const type* elems, const size_t size, size_t capacity = 100,size_t capacityGrowthStep = 100, const Alloc& allocator = Alloc());
+	explicit Sequence(const Alloc& allocator);
+	Sequence(const Sequence&);
+	Sequence(const Sequence&, const Alloc& allocator);
 	Sequence(Sequence&&) noexcept;
+	Sequence(Sequence&&, const Alloc& allocator);
 	~Sequence() noexcept;
 
+	[[nodiscard]] Alloc getAllocator() const noexcept;
 	void setCapacityGrowthStep(size_t) noexcept;
 	[[nodiscard]] size_t getCapacityGrowthStep() const noexcept;
 	[[nodiscard]] size_t getSize() const noexcept;
@@ -37,180 +143,669 @@ public:
 	[[nodiscard]] type& back();
 	[[nodiscard]] const type& front() const;
 	[[nodiscard]] const type& back() const;
-	Sequence<type>& push_back(const type&);
-	Sequence<type>& push_back(const Sequence<type>&);
-	Sequence<type>& push_back(const type*, size_t);
-	Sequence<type>& push_front(const type&);
-	Sequence<type>& push_front(const Sequence<type>&);
-	Sequence<type>& push_front(const type*, size_t);
-	Sequence<type>& pop_back() noexcept;
-	Sequence<type>& pop_front() noexcept;
-	Sequence<type>& insertAt(size_t index, const type& value);
-	Sequence<type>& changeAt(size_t index, const type& value);
-	Sequence<type>& changeAll(const type& previousValue, const type& nextValue);
-	Sequence<type>& removeAt(size_t);
-	Sequence<type>& removeAll(const type&);
-	Sequence<type>& concat(const Sequence<type>&);
+	Sequence& push_back(const type&);
+	Sequence& push_back(type&&);
+	Sequence& push_back(const Sequence&);
+	Sequence& push_back(const type*, size_t);
+	Sequence& push_front(const type&);
+	Sequence& push_front(type&&);
+	Sequence& push_front(const Sequence&);
+	Sequence& push_front(const type*, size_t);
+	template <class... Args>
+	type& emplace_back(Args&&...);
+	template <class... Args>
+	type& emplace_front(Args&&...);
+	template <class... Args>
+	type& emplaceAt(size_t index, Args&&...);
+	Sequence& pop_back() noexcept;
+	Sequence& pop_front() noexcept;
+	Sequence& insertAt(size_t index, const type& value);
+	Sequence& insertAt(size_t index, type&& value);
+	Sequence& changeAt(size_t index, const type& value);
+	Sequence& changeAt(size_t index, type&& value);
+	Sequence& changeAll(const type& previousValue, const type& nextValue);
+	Sequence& removeAt(size_t);
+	size_t removeAt(const Sequence<size_t>& indices);
+	Sequence& removeAll(const type&);
+	template <class Predicate>
+	size_t removeIf(Predicate);
+	template <class Predicate>
+	size_t replaceIf(Predicate, const type& value);
+
+	// smaller sequences run the execution policy overloads on the calling thread
+	static constexpr size_t parallelThreshold = 32768;
+	template <ExecutionPolicy Policy>
+	[[nodiscard]] size_t count(Policy&&, const type& value) const;
+	template <ExecutionPolicy Policy>
+	[[nodiscard]] size_t containsLotsOf(Policy&&, const type& value) const;
+	template <ExecutionPolicy Policy>
+	[[nodiscard]] bool contains(Policy&&, const type& value) const;
+	template <ExecutionPolicy Policy>
+	[[nodiscard]] size_t find(Policy&&, const type& value) const;
+	template <ExecutionPolicy Policy>
+	[[nodiscard]] size_t findFirst(Policy&&, const type& value) const;
+	template <ExecutionPolicy Policy, class Func>
+	void forEach(Policy&&, Func func);
+	template <ExecutionPolicy Policy, class Func>
+	void forEach(Policy&&, Func func) const;
+	template <ExecutionPolicy Policy, class Func>
+	Sequence& transform(Policy&&, Func func);
+	template <ExecutionPolicy Policy, class Result, class BinaryOperation>
+	[[nodiscard]] Result reduce(Policy&&, Result init, BinaryOperation operation) const;
+	template <ExecutionPolicy Policy>
+	Sequence& changeAll(Policy&&, const type& previousValue, const type& nextValue);
+
+	// ascending by operator<, integral and floating point elements are radix sorted
+	Sequence& sort();
+	template <class Compare> requires (!ExecutionPolicy<Compare>)
+	Sequence& sort(Compare comp);
+	Sequence& stableSort();
+	template <class Compare> requires (!ExecutionPolicy<Compare>)
+	Sequence& stableSort(Compare comp);
+	// sorts pieces on the thread pool, then merges them pairwise
+	template <ExecutionPolicy Policy>
+	Sequence& sort(Policy&&);
+	template <ExecutionPolicy Policy, class Compare>
+	Sequence& sort(Policy&&, Compare comp);
+	template <ExecutionPolicy Policy>
+	Sequence& stableSort(Policy&&);
+	template <ExecutionPolicy Policy, class Compare>
+	Sequence& stableSort(Policy&&, Compare comp);
+
+	// Opt-in hash index: find, findFirst, findLast, contains and containsLotsOf become lookups instead of scans.
+	// push_back, push_front, insertAt, changeAt, removeAt, pop_back, pop_front and clear keep it up to date,
+	// bulk operations such as sort or removeIf, emplace* and the non-const operator[], at, front, back, data, begin
+	// and end, whose results can be written through, make the next lookup rebuild it.
+	// Concurrent const lookups are safe: one of them rebuilds under the index's mutex while the others wait.
+	void enableIndex();
+	void disableIndex() noexcept;
+	[[nodiscard]] bool hasIndex() const noexcept;
+	Sequence& concat(const Sequence&);
 	[[nodiscard]] type& at(size_t);
 	[[nodiscard]] const type& at(size_t) const;
+	[[nodiscard]] type* data() noexcept;
+	[[nodiscard]] const type* data() const noexcept;
+	[[nodiscard]] iterator begin() noexcept;
+	[[nodiscard]] iterator end() noexcept;
+	[[nodiscard]] const_iterator begin() const noexcept;
+	[[nodiscard]] const_iterator end() const noexcept;
+	[[nodiscard]] const_iterator cbegin() const noexcept;
+	[[nodiscard]] const_iterator cend() const noexcept;
+	[[nodiscard]] reverse_iterator rbegin() noexcept;
+	[[nodiscard]] reverse_iterator rend() noexcept;
+	[[nodiscard]] const_reverse_iterator rbegin() const noexcept;
+	[[nodiscard]] const_reverse_iterator rend() const noexcept;
+	[[nodiscard]] const_reverse_iterator crbegin() const noexcept;
+	[[nodiscard]] const_reverse_iterator crend() const noexcept;
+	// read-only windows over [from, to), the first or the last count elements, without copying them;
+	// they stay valid until the sequence reallocates or shifts its elements
+	[[nodiscard]] SequenceView<type> slice(size_t from, size_t to) const;
+	[[nodiscard]] SequenceView<type> first(size_t count) const;
+	[[nodiscard]] SequenceView<type> last(size_t count) const;
+	[[nodiscard]] operator SequenceView<type>() const noexcept;
+	// lazy adaptors, nothing is evaluated until the result is iterated or collect()ed
+	template <class Predicate>
+	[[nodiscard]] FilteredView<SequenceView<type>, Predicate> filtered(Predicate predicate) const;
+	template <class Function>
+	[[nodiscard]] MappedView<SequenceView<type>, Function> mapped(Function function) const;
+	[[nodiscard]] SequenceView<type> take(size_t count) const noexcept;
+	[[nodiscard]] SequenceView<type> drop(size_t count) const noexcept;
+	[[nodiscard]] ChunkedView<type> chunked(size_t chunkSize) const;
 	void print() const;
-	void swap(Sequence<type>&) noexcept;
+	void print(std::ostream& os, const FormatOptions& options) const;
+	void swap(Sequence&) noexcept;
 	[[nodiscard]] size_t totalSizeInBytes() const;
 	[[nodiscard]] size_t dataSizeInBytes() const;
 
 	[[nodiscard]] type& operator[] (size_t);
 	[[nodiscard]] const type& operator[] (size_t) const;
-	Sequence<type>& operator=(const Sequence<type>&);
-	Sequence<type>& operator=(Sequence<type>&&) noexcept;
-	Sequence<type>& operator+=(const Sequence<type>&);
+	Sequence& operator=(const Sequence&);
+	Sequence& operator=(Sequence&&) noexcept(isMoveAssignNoexcept);
+	Sequence& operator+=(const Sequence&);
 
-	[[nodiscard]] bool operator==(const Sequence<type>&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
-	[[nodiscard]] bool operator!=(const Sequence<type>&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] bool operator==(const Sequence&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] bool operator!=(const Sequence&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] SequenceOrdering<type> operator<=>(const Sequence&) const;
 };
 
-template <class type>
-Sequence<type>::Sequence(const type* elems, const size_t size, size_t capacity, size_t step) : size(size), capacityGrowthStep(step), capacity(capacity) {
+// One operand of a SequenceSum: an lvalue is borrowed by pointer, an rvalue is moved in and owned.
+template <class type, class Alloc, class GrowthPolicy>
+class SequenceOperand {
+private:
+	using Base = Sequence<type, Alloc, GrowthPolicy>;
+
+	const Base* borrowed = nullptr;
+	std::optional<Base> owned;
+public:
+	SequenceOperand() noexcept = default;
+	SequenceOperand(const Base& operand) noexcept;
+	SequenceOperand(Base&& operand) noexcept;
+
+	[[nodiscard]] const Base& get() const noexcept;
+};
+
+// What a + b + c evaluates to: the operands are only remembered, materialize() or the conversion to Sequence allocates
+// the total size once and copies every operand once. A moved-from left operand (std::move(a) + b) lends its buffer,
+// which is reused without allocating when it already has room; other rvalue operands are moved into the expression.
+// Lvalue operands are held by pointer, so an expression kept in an auto variable must not outlive them.
+// The read accessors look through the operands without building the result.
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+class SequenceSum {
+private:
+	using Base = Sequence<type, Alloc, GrowthPolicy>;
+	using Operand = SequenceOperand<type, Alloc, GrowthPolicy>;
+
+	template <class, class, class, size_t>
+	friend class SequenceSum;
+
+	Base head;
+	std::array<Operand, count> parts;
+
+	[[nodiscard]] const type* locate(size_t index) const noexcept;
+public:
+	SequenceSum(Base&& head, std::array<Operand, count>&& parts) noexcept;
+
+	[[nodiscard]] size_t getSize() const noexcept;
+	[[nodiscard]] bool isEmpty() const noexcept;
+	[[nodiscard]] const type& operator[] (size_t) const;
+	[[nodiscard]] const type& at(size_t) const;
+	[[nodiscard]] const type& front() const;
+	[[nodiscard]] const type& back() const;
+	[[nodiscard]] size_t find(const type&) const;
+	[[nodiscard]] bool contains(const type&) const;
+	[[nodiscard]] size_t containsLotsOf(const type&) const;
+
+	// the result gets the allocator and growth step of the left operand
+	[[nodiscard]] Base materialize() const&;
+	[[nodiscard]] Base materialize() &&;
+	[[nodiscard]] operator Base() const&;
+	[[nodiscard]] operator Base() &&;
+	void print() const;
+
+	template <size_t more>
+	[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, count + 1 + more> append(SequenceSum<type, Alloc, GrowthPolicy, more>&& tail) &&;
+	[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, count + 1> append(Operand&& tail) &&;
+};
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>::Sequence(const type* elems, const size_t size, size_t capacity, size_t step, const Alloc& allocator) : size(size), 
+           capacityGrowthStep(step), capacity(capacity), allocator(allocator) {
 	if (size > capacity) {
 		throw std::invalid_argument("Sequence constructor: size cannot be greater than capacity");
 	}
 
-	elements = new type[capacity];
+	storage = elements = allocateStorage(capacity);
+	try {
+		Relocation<type>::copy(this->allocator, elems, size, elements);
+	}
+	catch (...) {
+		deallocateStorage(storage, capacity);
+		throw;
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>::Sequence(size_t capacity, size_t capacityGrowthStep, const Alloc& allocator) : capacity(capacity),
+           capacityGrowthStep(capacityGrowthStep), size(0), allocator(allocator) {
+	storage = elements = allocateStorage(capacity);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>::Sequence(const Alloc& allocator) : Sequence(100, 100, allocator) {}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>::~Sequence() noexcept {
+	releaseStorage();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline Alloc Sequence<type, Alloc, GrowthPolicy>::getAllocator() const noexcept {
+	return allocator;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline type* Sequence<type, Alloc, GrowthPolicy>::allocateStorage(size_t count) {
+	if (count == 0) {
+		return nullptr;
+	}
+	if (count > AllocTraits::max_size(allocator)) {
+		throw std::bad_array_new_length();
+	}
+	return AllocTraits::allocate(allocator, count);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::deallocateStorage(type* storage, size_t count) noexcept {
+	if (storage != nullptr) {
+		AllocTraits::deallocate(allocator, storage, count);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::releaseStorage() noexcept {
+	std::destroy_n(elements, size);
+	deallocateStorage(storage, capacity);
+	storage = nullptr;
+	elements = nullptr;
+	size = 0;
+	capacity = 0;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline bool Sequence<type, Alloc, GrowthPolicy>::owns(const type* pointer) const noexcept {
+	return std::less_equal<const type*>()(elements, pointer) && std::less<const type*>()(pointer, elements + size);
+}
 
-	for (size_t i = 0; i < size; ++i) {
-		elements[i] = elems[i];
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::destroyTail(size_t newSize) noexcept {
+	if (newSize < size) {
+		std::destroy(elements + newSize, elements + size);
+		size = newSize;
+		if (size == 0) {
+			elements = storage;
+		}
 	}
 }
 
-template <class type>
-inline Sequence<type>::Sequence(size_t capacity, size_t capacityGrowthStep) : capacity(capacity),
-           capacityGrowthStep(capacityGrowthStep), size(0) {
-	elements = new type[capacity];
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::frontRoom() const noexcept {
+	return static_cast<size_t>(elements - storage);
 }
 
-template <class type>
-inline Sequence<type>::~Sequence() noexcept {
-	delete[] elements;
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::backRoom() const noexcept {
+	return capacity - frontRoom() - size;
 }
 
-template <class type>
-inline size_t Sequence<type>::getSize() const noexcept {
+// moving the whole block is worth it only while the free slots left afterwards are a fair share of the size,
+// otherwise a nearly full buffer would be shifted on every insertion instead of growing
+template <class type, class Alloc, class GrowthPolicy>
+inline bool Sequence<type, Alloc, GrowthPolicy>::hasSlackFor(size_t count) const noexcept {
+	return capacity - size >= count && capacity - size - count >= size / 8;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::getSize() const noexcept {
 	return size;
 }
 
-template <class type>
-inline size_t Sequence<type>::getCapacity() const noexcept {
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::getCapacity() const noexcept {
 	return capacity;
 }
 
-template <class type>
-inline type& Sequence<type>::operator[] (size_t index) {
+template <class type, class Alloc, class GrowthPolicy>
+inline type& Sequence<type, Alloc, GrowthPolicy>::operator[] (size_t index) {
+	invalidateIndex();
 	return elements[index];
 }
 
-template <class type>
-inline const type& Sequence<type>::operator[] (size_t index) const {
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& Sequence<type, Alloc, GrowthPolicy>::operator[] (size_t index) const {
 	return elements[index];
 }
 
-template <class type>
-inline type& Sequence<type>::front() {
+template <class type, class Alloc, class GrowthPolicy>
+inline type* Sequence<type, Alloc, GrowthPolicy>::data() noexcept {
+	invalidateIndex();
+	return elements;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline const type* Sequence<type, Alloc, GrowthPolicy>::data() const noexcept {
+	return elements;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::iterator Sequence<type, Alloc, GrowthPolicy>::begin() noexcept {
+	invalidateIndex();
+	return elements;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::iterator Sequence<type, Alloc, GrowthPolicy>::end() noexcept {
+	invalidateIndex();
+	return elements + size;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_iterator Sequence<type, Alloc, GrowthPolicy>::begin() const noexcept {
+	return elements;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_iterator Sequence<type, Alloc, GrowthPolicy>::end() const noexcept {
+	return elements + size;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_iterator Sequence<type, Alloc, GrowthPolicy>::cbegin() const noexcept {
+	return elements;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_iterator Sequence<type, Alloc, GrowthPolicy>::cend() const noexcept {
+	return elements + size;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::reverse_iterator Sequence<type, Alloc, GrowthPolicy>::rbegin() noexcept {
+	return reverse_iterator(end());
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::reverse_iterator Sequence<type, Alloc, GrowthPolicy>::rend() noexcept {
+	return reverse_iterator(begin());
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_reverse_iterator Sequence<type, Alloc, GrowthPolicy>::rbegin() const noexcept {
+	return const_reverse_iterator(end());
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_reverse_iterator Sequence<type, Alloc, GrowthPolicy>::rend() const noexcept {
+	return const_reverse_iterator(begin());
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_reverse_iterator Sequence<type, Alloc, GrowthPolicy>::crbegin() const noexcept {
+	return const_reverse_iterator(cend());
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline typename Sequence<type, Alloc, GrowthPolicy>::const_reverse_iterator Sequence<type, Alloc, GrowthPolicy>::crend() const noexcept {
+	return const_reverse_iterator(cbegin());
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+SequenceView<type> Sequence<type, Alloc, GrowthPolicy>::slice(size_t from, size_t to) const {
+	if (from > to || to > size) {
+		throw std::out_of_range("Index out of range");
+	}
+	return SequenceView<type>(elements + from, to - from);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceView<type> Sequence<type, Alloc, GrowthPolicy>::first(size_t count) const {
+	return slice(0, count);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceView<type> Sequence<type, Alloc, GrowthPolicy>::last(size_t count) const {
+	if (count > size) {
+		throw std::out_of_range("Index out of range");
+	}
+	return slice(size - count, size);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>::operator SequenceView<type>() const noexcept {
+	return SequenceView<type>(elements, size);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Predicate>
+inline FilteredView<SequenceView<type>, Predicate> Sequence<type, Alloc, GrowthPolicy>::filtered(Predicate predicate) const {
+	return SequenceView<type>(elements, size).filtered(std::move(predicate));
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Function>
+inline MappedView<SequenceView<type>, Function> Sequence<type, Alloc, GrowthPolicy>::mapped(Function function) const {
+	return SequenceView<type>(elements, size).mapped(std::move(function));
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceView<type> Sequence<type, Alloc, GrowthPolicy>::take(size_t count) const noexcept {
+	return SequenceView<type>(elements, size).take(count);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceView<type> Sequence<type, Alloc, GrowthPolicy>::drop(size_t count) const noexcept {
+	return SequenceView<type>(elements, size).drop(count);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline ChunkedView<type> Sequence<type, Alloc, GrowthPolicy>::chunked(size_t chunkSize) const {
+	return ChunkedView<type>(SequenceView<type>(elements, size), chunkSize);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline type& Sequence<type, Alloc, GrowthPolicy>::front() {
 	if (isEmpty()) {
 		throw std::out_of_range("Cannot call front() on an empty Sequence");
 	}
+	invalidateIndex();
 	return elements[0];
 }
 
-template <class type>
-inline type& Sequence<type>::back() {
+template <class type, class Alloc, class GrowthPolicy>
+inline type& Sequence<type, Alloc, GrowthPolicy>::back() {
 	if (isEmpty()) {
 		throw std::out_of_range("Cannot call back() on an empty Sequence");
 	}
+	invalidateIndex();
 	return elements[size - 1];
 }
 
-template <class type>
-inline const type& Sequence<type>::front() const {
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& Sequence<type, Alloc, GrowthPolicy>::front() const {
 	if (isEmpty()) {
 		throw std::out_of_range("Cannot call front() on an empty Sequence");
 	}
 	return elements[0];
 }
 
-template <class type>
-inline const type& Sequence<type>::back() const{
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& Sequence<type, Alloc, GrowthPolicy>::back() const{
 	if (isEmpty()) {
 		throw std::out_of_range("Cannot call back() on an empty Sequence");
 	}
 	return elements[size - 1];
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::push_back(const type& value) {
-	if (size >= capacity) {
-		resize(capacity + capacityGrowthStep);
-	}
-	elements[size] = value;
-	++size;
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_back(const type& value) {
+	constructBack(value);
 	return *this;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::push_front(const type& value) {
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_back(type&& value) {
+	constructBack(std::move(value));
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_front(const type& value) {
 	return insertAt(0, value);
 }
 
-template <class type>
-inline bool Sequence<type>::isEmpty() const noexcept {
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_front(type&& value) {
+	return insertAt(0, std::move(value));
+}
+
+// when full, the new element is built in the new buffer before the old one is released,
+// so arguments referring into the sequence stay valid
+template <class type, class Alloc, class GrowthPolicy>
+template <class... Args>
+type& Sequence<type, Alloc, GrowthPolicy>::constructBack(Args&&... args) {
+	if (backRoom() > 0) {
+		AllocTraits::construct(allocator, elements + size, std::forward<Args>(args)...);
+		size++;
+		indexInserted(size - 1, 1);
+		return elements[size - 1];
+	}
+	if (hasSlackFor(1)) {
+		// the arguments may refer to elements that are about to be moved towards the front
+		type value(std::forward<Args>(args)...);
+		openGapAt(size, 1);
+		AllocTraits::construct(allocator, elements + size, std::move(value));
+		size++;
+		indexInserted(size - 1, 1);
+		return elements[size - 1];
+	}
+
+	size_t newCapacity = GrowthPolicy::grow(capacity, size + 1, capacityGrowthStep, sizeof(type));
+	type* newStorage = allocateStorage(newCapacity);
+	try {
+		AllocTraits::construct(allocator, newStorage + size, std::forward<Args>(args)...);
+	}
+	catch (...) {
+		deallocateStorage(newStorage, newCapacity);
+		throw;
+	}
+	try {
+		Relocation<type>::relocate(elements, size, newStorage);
+	}
+	catch (...) {
+		std::destroy_at(newStorage + size);
+		deallocateStorage(newStorage, newCapacity);
+		throw;
+	}
+	deallocateStorage(storage, capacity);
+	storage = elements = newStorage;
+	capacity = newCapacity;
+	size++;
+	indexInserted(size - 1, 1);
+	return elements[size - 1];
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class... Args>
+inline type& Sequence<type, Alloc, GrowthPolicy>::emplace_back(Args&&... args) {
+	type& element = constructBack(std::forward<Args>(args)...);
+	invalidateIndex();
+	return element;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class... Args>
+inline type& Sequence<type, Alloc, GrowthPolicy>::emplace_front(Args&&... args) {
+	return emplaceAt(0, std::forward<Args>(args)...);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class... Args>
+type& Sequence<type, Alloc, GrowthPolicy>::emplaceAt(size_t index, Args&&... args) {
+	if (index > size) {
+		throw std::out_of_range("Index out of range");
+	}
+	if (index == size) {
+		return emplace_back(std::forward<Args>(args)...);
+	}
+
+	// the arguments may refer to elements that are about to be shifted
+	type value(std::forward<Args>(args)...);
+	insertAt(index, std::move(value));
+	invalidateIndex();
+	return elements[index];
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline bool Sequence<type, Alloc, GrowthPolicy>::isEmpty() const noexcept {
 	return size == 0;
 }
 
-template <class type>
-inline bool Sequence<type>::isFull() const noexcept {
+template <class type, class Alloc, class GrowthPolicy>
+inline bool Sequence<type, Alloc, GrowthPolicy>::isFull() const noexcept {
 	return size == capacity;
 }
 
-template <class type>
-void Sequence<type>::clear() noexcept {
-	size = 0;
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::clear() noexcept {
+	destroyTail(0);
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (valueIndex) {
+			valueIndex->clear();
+		}
+	}
 }
 
-template <class type>
-Sequence<type>::Sequence(const Sequence<type>& other) : size(other.size), capacity(other.capacity), 
-           capacityGrowthStep(other.capacityGrowthStep)
-{
-	elements = new type[capacity];
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>::Sequence(const Sequence<type, Alloc, GrowthPolicy>& other)
+           : Sequence(other, AllocTraits::select_on_container_copy_construction(other.allocator)) {}
 
-	for (size_t i = 0; i < size; i++) {
-		elements[i] = other[i];
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>::Sequence(const Sequence<type, Alloc, GrowthPolicy>& other, const Alloc& allocator) : size(other.size), 
+           capacity(other.capacity), capacityGrowthStep(other.capacityGrowthStep), allocator(allocator)
+{
+	copyIndexSetting(other);
+	storage = elements = allocateStorage(capacity);
+	try {
+		Relocation<type>::copy(this->allocator, other.elements, size, elements);
+	}
+	catch (...) {
+		deallocateStorage(storage, capacity);
+		throw;
 	}
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::operator=(const Sequence<type>& other) {
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::operator=(const Sequence<type, Alloc, GrowthPolicy>& other) {
 	if (this != &other) {
-		delete[] elements;
-		capacity = other.getCapacity();
-		size = other.getSize();
-		capacityGrowthStep = other.capacityGrowthStep;
-		elements = new type[capacity];
-		for (size_t i = 0; i < size; i++)
-		{
-			elements[i] = other[i];
+		if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+			if (allocator != other.allocator) {
+				releaseStorage();
+			}
+			allocator = other.allocator;
+		}
+		type* newElements = allocateStorage(other.capacity);
+		try {
+			Relocation<type>::copy(allocator, other.elements, other.size, newElements);
 		}
+		catch (...) {
+			deallocateStorage(newElements, other.capacity);
+			throw;
+		}
+		releaseStorage();
+		storage = elements = newElements;
+		size = other.size;
+		capacity = other.capacity;
+		capacityGrowthStep = other.capacityGrowthStep;
+		copyIndexSetting(other);
 	}
 	return *this;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::operator=(Sequence<type>&& other) noexcept {
+// the buffer is taken over when the allocator propagates or compares equal,
+// otherwise the elements are moved one by one into storage from our own allocator
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::operator=(Sequence<type, Alloc, GrowthPolicy>&& other) noexcept(isMoveAssignNoexcept) {
 	if (this != &other) {
-		delete[] elements;
+		if constexpr (!isMoveAssignNoexcept) {
+			if (allocator != other.allocator) {
+				Sequence<type, Alloc, GrowthPolicy> moved(std::move(other), allocator);
+				releaseStorage();
+				storage = moved.storage;
+				elements = moved.elements;
+				size = moved.size;
+				capacity = moved.capacity;
+				capacityGrowthStep = moved.capacityGrowthStep;
+				moved.storage = nullptr;
+				moved.elements = nullptr;
+				moved.size = 0;
+				moved.capacity = 0;
+				valueIndex = std::move(moved.valueIndex);
+				return *this;
+			}
+		}
+		releaseStorage();
+		if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+			allocator = std::move(other.allocator);
+		}
 		
+		storage = other.storage;
 		elements = other.elements;
 		size = other.size;
 		capacity = other.capacity;
 		capacityGrowthStep = other.capacityGrowthStep;
 
+		valueIndex = std::move(other.valueIndex);
+
+		other.storage = nullptr;
 		other.elements = nullptr;
 		other.size = 0;
 		other.capacity = 0;
@@ -219,8 +814,16 @@ Sequence<type>& Sequence<type>::operator=(Sequence<type>&& other) noexcept {
 	return *this;
 }
 
-template <class type>
-bool Sequence<type>::contains(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+template <class type, class Alloc, class GrowthPolicy>
+bool Sequence<type, Alloc, GrowthPolicy>::contains(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (const SequenceIndex<type>* fresh = freshIndex()) {
+			return fresh->count(value) > 0;
+		}
+	}
+	if constexpr (SimdSearch<type>::isSupported) {
+		return SimdSearch<type>::find(elements, size, value) != size;
+	}
 	for (size_t i = 0; i < size; i++)
 	{
 		if (elements[i] == value) {
@@ -230,8 +833,16 @@ bool Sequence<type>::contains(const type& value) const noexcept(noexcept(std::de
 	return false;
 }
 
-template <class type>
-size_t Sequence<type>::containsLotsOf(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+template <class type, class Alloc, class GrowthPolicy>
+size_t Sequence<type, Alloc, GrowthPolicy>::containsLotsOf(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (const SequenceIndex<type>* fresh = freshIndex()) {
+			return fresh->count(value);
+		}
+	}
+	if constexpr (SimdSearch<type>::isSupported) {
+		return SimdSearch<type>::count(elements, size, value);
+	}
 	size_t counter = 0;
 	for (size_t i = 0; i < size; i++)
 	{
@@ -242,94 +853,179 @@ size_t Sequence<type>::containsLotsOf(const type& value) const noexcept(noexcept
 	return counter;
 }
 
-template <class type>
-void Sequence<type>::resize(size_t newCapacity) {
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::resize(size_t newCapacity) {
 	if (newCapacity != capacity) {
-		type* newElements = new type[newCapacity];
+		type* newStorage = allocateStorage(newCapacity);
 		size_t newSize = (size > newCapacity) ? newCapacity : size;
-		for (size_t i = 0; i < newSize; i++)
-		{
-			newElements[i] = elements[i];
+		try {
+			Relocation<type>::relocate(elements, newSize, newStorage);
+		}
+		catch (...) {
+			deallocateStorage(newStorage, newCapacity);
+			throw;
+		}
+		std::destroy(elements + newSize, elements + size);
+		deallocateStorage(storage, capacity);
+		storage = elements = newStorage;
+		if (newSize < size) {
+			invalidateIndex();
 		}
-		delete[] elements;
-		elements = newElements;
 		size = newSize;
 		capacity = newCapacity;
 	}
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::changeAt(size_t index, const type& value) {
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::changeAt(size_t index, const type& value) {
 	if (index >= size)
 	{
 		throw std::out_of_range("Index out of range");
 	}
 
-	elements[index] = value;
+	if (!valueIndex) {
+		elements[index] = value;
+		return *this;
+	}
+	if (owns(&value)) {
+		return changeAt(index, type(value));
+	}
+	indexForget(index);
+	try {
+		elements[index] = value;
+	}
+	catch (...) {
+		invalidateIndex();
+		throw;
+	}
+	indexRemember(index);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::changeAt(size_t index, type&& value) {
+	if (index >= size)
+	{
+		throw std::out_of_range("Index out of range");
+	}
 
+	if (!valueIndex) {
+		elements[index] = std::move(value);
+		return *this;
+	}
+	if (owns(&value)) {
+		type moved(std::move(value));
+		return changeAt(index, std::move(moved));
+	}
+	indexForget(index);
+	try {
+		elements[index] = std::move(value);
+	}
+	catch (...) {
+		invalidateIndex();
+		throw;
+	}
+	indexRemember(index);
 	return *this;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::removeAt(size_t index) {
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::removeAt(size_t index) {
 	if (index >= size) {
 		throw std::out_of_range("Index out of range");
 	}
 
-	for (size_t i = index; i < size - 1; i++)
-	{
-		elements[i] = elements[i + 1];
-	}
+	indexErasing(index);
+	std::destroy_at(elements + index);
 	size--;
+	closeGapAt(index, 1);
 	return *this;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::insertAt(size_t index, const type& value) {
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::insertAt(size_t index, const type& value) {
 	if (index > size) {
 		throw std::out_of_range("Index out of range");
 	}
 
-	if (size == capacity)
-	{
-		resize(capacity + capacityGrowthStep);
+	if (owns(&value)) {
+		return insertAt(index, type(value));
+	}
+
+	openGapAt(index, 1);
+	try {
+		AllocTraits::construct(allocator, elements + index, value);
+	}
+	catch (...) {
+		closeGapAt(index, 1);
+		throw;
 	}
 	size++;
+	indexInserted(index, 1);
 
-	for (size_t i = size - 1; i > index; i--)
-	{
-		elements[i] = elements[i - 1];
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::insertAt(size_t index, type&& value) {
+	if (index > size) {
+		throw std::out_of_range("Index out of range");
 	}
-	elements[index] = value;
+	if (owns(&value)) {
+		type moved(std::move(value));
+		return insertAt(index, std::move(moved));
+	}
+
+	openGapAt(index, 1);
+	try {
+		AllocTraits::construct(allocator, elements + index, std::move(value));
+	}
+	catch (...) {
+		closeGapAt(index, 1);
+		throw;
+	}
+	size++;
+	indexInserted(index, 1);
 
 	return *this;
 }
 
-template <class type>
-inline Sequence<type>& Sequence<type>::pop_back() noexcept {
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::pop_back() noexcept {
 	if (size > 0)
 	{
-		size--;
+		indexErasing(size - 1);
+		destroyTail(size - 1);
 	}
 	return *this;
 }
 
-template<class type>
-Sequence<type>& Sequence<type>::pop_front() noexcept {
-	return removeAt(0);
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::pop_front() noexcept {
+	if (size > 0)
+	{
+		indexErasing(0);
+		std::destroy_at(elements);
+		elements++;
+		size--;
+		if (size == 0) {
+			elements = storage;
+		}
+	}
+	return *this;
 }
 
-template<class type>
-inline type& Sequence<type>::at(size_t index) {
+template <class type, class Alloc, class GrowthPolicy>
+inline type& Sequence<type, Alloc, GrowthPolicy>::at(size_t index) {
 	if (index >= size) {
 		throw std::out_of_range("Index out of range");
 	}
-
+	invalidateIndex();
 	return elements[index];
 }
 
-template<class type>
-inline const type& Sequence<type>::at(size_t index) const {
+template <class type, class Alloc, class GrowthPolicy>
+inline const type& Sequence<type, Alloc, GrowthPolicy>::at(size_t index) const {
 	if (index >= size) {
 		throw std::out_of_range("Index out of range");
 	}
@@ -337,70 +1033,545 @@ inline const type& Sequence<type>::at(size_t index) const {
 	return elements[index];
 }
 
-template <class type>
-void Sequence<type>::reserve(size_t newBiggerCapacity) {
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::reserve(size_t newBiggerCapacity) {
 	if (newBiggerCapacity > capacity)
 	{
-		resize(newBiggerCapacity);
+		resize(GrowthPolicy::fit(newBiggerCapacity, sizeof(type)));
+	}
+	else if (newBiggerCapacity > capacity - frontRoom())
+	{
+		// the reserved room has to be usable by push_back
+		moveBlockTo(0);
 	}
 }
 
-template <class type>
-void Sequence<type>::shrink_to_fit() {
-	resize(size);
+// places the elements head slots into the buffer, the caller makes sure they fit
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::moveBlockTo(size_t head) {
+	size_t currentHead = frontRoom();
+	if (head > currentHead) {
+		Relocation<type>::openGap(elements, size, head - currentHead);
+	}
+	else if (head < currentHead) {
+		Relocation<type>::closeGap(storage + head, currentHead - head, size);
+	}
+	elements = storage + head;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::removeAll(const type& value) {
-	for (size_t i = 0; i < size; i++)
-	{
-		if (elements[i] == value)
-		{
-			removeAt(i);
-			i--;
+// moves the elements into a new buffer, head slots in, leaving [gapIndex, gapIndex + gapCount) raw
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::reallocate(size_t newCapacity, size_t head, size_t gapIndex, size_t gapCount) {
+	type* newStorage = allocateStorage(newCapacity);
+	type* newElements = newStorage + head;
+	try {
+		if constexpr (Relocation<type>::isNothrow) {
+			Relocation<type>::relocate(elements, gapIndex, newElements);
+			Relocation<type>::relocate(elements + gapIndex, size - gapIndex, newElements + gapIndex + gapCount);
+		}
+		else {
+			// in one piece, so that a throwing copy leaves the sequence untouched
+			Relocation<type>::relocate(elements, size, newElements);
 		}
 	}
-
-	return *this;
+	catch (...) {
+		deallocateStorage(newStorage, newCapacity);
+		throw;
+	}
+	deallocateStorage(storage, capacity);
+	storage = newStorage;
+	elements = newElements;
+	capacity = newCapacity;
+	if constexpr (!Relocation<type>::isNothrow) {
+		Relocation<type>::openGap(elements + gapIndex, size - gapIndex, gapCount);
+	}
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::changeAll(const type& previousValue, const type& nextValue) {
-	for (size_t i = 0; i < size; i++)
-	{
-		if (elements[i] == previousValue)
-		{
-			changeAt(i, nextValue);
+// leaves [index, index + count) raw without counting it in size, the caller fills it or closes it again.
+// The shorter side of the block moves, so insertions at either end are O(1) while there is free room there
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::openGapAt(size_t index, size_t count) {
+	if (count == 0) {
+		return;
+	}
+	bool frontIsShorter = index < size - index;
+	if (count > (frontIsShorter ? frontRoom() : backRoom())) {
+		if (!hasSlackFor(count)) {
+			size_t newCapacity = GrowthPolicy::grow(capacity, size + count, capacityGrowthStep, sizeof(type));
+			size_t left = newCapacity - size - count;
+			reallocate(newCapacity, frontIsShorter ? left - left / 2 : 0, index, count);
+			return;
 		}
+		// recentre the block in the free room, the next move is at least size / 16 insertions away
+		size_t left = capacity - size - count;
+		moveBlockTo(frontIsShorter ? count + (left - left / 2) : left / 2);
 	}
-	return *this;
-}
 
-template <class type>
-void Sequence<type>::print() const {
-	std::cout << "Sequence (capacity = " << capacity << ", size = " << size << "): ";
-	for (size_t i = 0; i < size; i++)
-	{
-		std::cout << elements[i] << " ";
+	if (frontIsShorter) {
+		Relocation<type>::closeGap(elements - count, count, index);
+		elements -= count;
+	}
+	else {
+		Relocation<type>::openGap(elements + index, size - index, count);
 	}
-	std::cout << std::endl;
 }
 
-template<class type>
-std::ostream& operator<<(std::ostream& os, const Sequence<type>& sequence) {
-	os << "Sequence (capacity = " << sequence.getCapacity() << ", size = " << sequence.getSize() << "): ";
-	for (size_t i = 0; i < sequence.getSize(); i++)
-	{
-		os << sequence[i] << " ";
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::closeGapAt(size_t index, size_t count) {
+	if (index < size - index) {
+		Relocation<type>::openGap(elements, index, count);
+		elements += count;
+	}
+	else {
+		Relocation<type>::closeGap(elements + index, count, size - index);
+	}
+	if (size == 0) {
+		elements = storage;
 	}
-	os << std::endl;
-	
-	return os;
 }
 
-template<class type>
-std::istream& operator>>(std::istream& is, Sequence<type>& seq) {
-	size_t n;
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::shrink_to_fit() {
+	resize(size);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::removeAll(const type& value) {
+	if (owns(&value)) {
+		type copy(value);
+		return removeAll(copy);
+	}
+
+	removeIf([&value](const type& element) { return element == value; });
+	return *this;
+}
+
+// kept elements are moved down over the removed ones in a single pass
+template <class type, class Alloc, class GrowthPolicy>
+template <class Predicate>
+size_t Sequence<type, Alloc, GrowthPolicy>::removeIf(Predicate predicate) {
+	invalidateIndex();
+	size_t kept = 0;
+	size_t i = 0;
+	try {
+		for (; i < size; i++)
+		{
+			if (!predicate(static_cast<const type&>(elements[i])))
+			{
+				if (kept != i) {
+					elements[kept] = std::move(elements[i]);
+				}
+				kept++;
+			}
+		}
+	}
+	catch (...) {
+		// the elements the predicate has not accepted yet stay
+		for (; i < size; i++, kept++) {
+			if (kept != i) {
+				elements[kept] = std::move(elements[i]);
+			}
+		}
+		destroyTail(kept);
+		throw;
+	}
+
+	size_t removed = size - kept;
+	destroyTail(kept);
+	return removed;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Predicate>
+size_t Sequence<type, Alloc, GrowthPolicy>::replaceIf(Predicate predicate, const type& value) {
+	invalidateIndex();
+	size_t replaced = 0;
+	for (size_t i = 0; i < size; i++)
+	{
+		if (predicate(static_cast<const type&>(elements[i])))
+		{
+			elements[i] = value;
+			replaced++;
+		}
+	}
+	return replaced;
+}
+
+// indices may come in any order and repeat; the runs between them are shifted once each
+template <class type, class Alloc, class GrowthPolicy>
+size_t Sequence<type, Alloc, GrowthPolicy>::removeAt(const Sequence<size_t>& indices) {
+	if (indices.isEmpty()) {
+		return 0;
+	}
+	bool isIncreasing = static_cast<const void*>(&indices) != static_cast<const void*>(this);
+	for (size_t i = 1; i < indices.getSize() && isIncreasing; i++) {
+		isIncreasing = indices[i - 1] < indices[i];
+	}
+	if (!isIncreasing) {
+		Sequence<size_t> sorted(indices);
+		sorted.sort();
+		sorted.resize(static_cast<size_t>(std::unique(sorted.begin(), sorted.end()) - sorted.begin()));
+		return removeAt(sorted);
+	}
+	if (indices[indices.getSize() - 1] >= size) {
+		throw std::out_of_range("Index out of range");
+	}
+
+	invalidateIndex();
+	size_t count = indices.getSize();
+	size_t write = indices[0];
+	for (size_t i = 0; i < count; i++) {
+		std::destroy_at(elements + indices[i]);
+		size_t runStart = indices[i] + 1;
+		size_t runEnd = (i + 1 < count) ? indices[i + 1] : size;
+		Relocation<type>::closeGap(elements + write, runStart - write, runEnd - runStart);
+		write += runEnd - runStart;
+	}
+	size -= count;
+	if (size == 0) {
+		elements = storage;
+	}
+	return count;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::changeAll(const type& previousValue, const type& nextValue) {
+	if (owns(&previousValue) || owns(&nextValue)) {
+		type previous(previousValue);
+		type next(nextValue);
+		return changeAll(previous, next);
+	}
+
+	replaceIf([&previousValue](const type& element) { return element == previousValue; }, nextValue);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Policy>
+inline bool Sequence<type, Alloc, GrowthPolicy>::runsInParallel() const noexcept {
+	using Bare = std::remove_cvref_t<Policy>;
+	if constexpr (std::is_same_v<Bare, std::execution::parallel_policy> || std::is_same_v<Bare, std::execution::parallel_unsequenced_policy>) {
+		return size >= parallelThreshold;
+	}
+	return false;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+size_t Sequence<type, Alloc, GrowthPolicy>::count(Policy&&, const type& value) const {
+	if (!runsInParallel<Policy>() || valueIndex) {
+		return containsLotsOf(value);
+	}
+
+	std::atomic<size_t> total{ 0 };
+	ThreadPool::shared().parallelFor(size, parallelThreshold / 4, [this, &value, &total](size_t begin, size_t end) {
+		size_t found = 0;
+		if constexpr (SimdSearch<type>::isSupported) {
+			found = SimdSearch<type>::count(elements + begin, end - begin, value);
+		}
+		else {
+			for (size_t i = begin; i < end; i++) {
+				if (elements[i] == value) {
+					found++;
+				}
+			}
+		}
+		total.fetch_add(found, std::memory_order_relaxed);
+	});
+	return total.load();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::containsLotsOf(Policy&& policy, const type& value) const {
+	return count(std::forward<Policy>(policy), value);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+inline bool Sequence<type, Alloc, GrowthPolicy>::contains(Policy&& policy, const type& value) const {
+	return findFirst(std::forward<Policy>(policy), value) != size;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::find(Policy&& policy, const type& value) const {
+	return findFirst(std::forward<Policy>(policy), value);
+}
+
+// every piece searches in blocks and gives up as soon as a match before it is known
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+size_t Sequence<type, Alloc, GrowthPolicy>::findFirst(Policy&&, const type& value) const {
+	if (!runsInParallel<Policy>() || valueIndex) {
+		return find(value);
+	}
+
+	const size_t block = 4096;
+	std::atomic<size_t> first{ size };
+	ThreadPool::shared().parallelFor(size, parallelThreshold / 4, [this, &value, &first](size_t begin, size_t end) {
+		for (size_t from = begin; from < end && first.load(std::memory_order_relaxed) > from; from += block) {
+			size_t to = (end - from > block) ? from + block : end;
+			size_t found = to;
+			if constexpr (SimdSearch<type>::isSupported) {
+				found = from + SimdSearch<type>::find(elements + from, to - from, value);
+			}
+			else {
+				for (size_t i = from; i < to && found == to; i++) {
+					if (elements[i] == value) {
+						found = i;
+					}
+				}
+			}
+			if (found != to) {
+				size_t known = first.load(std::memory_order_relaxed);
+				while (found < known && !first.compare_exchange_weak(known, found, std::memory_order_relaxed)) {}
+				return;
+			}
+		}
+	});
+	return first.load();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy, class Func>
+void Sequence<type, Alloc, GrowthPolicy>::forEach(Policy&&, Func func) {
+	invalidateIndex();
+	if (!runsInParallel<Policy>()) {
+		for (size_t i = 0; i < size; i++) {
+			func(elements[i]);
+		}
+		return;
+	}
+	ThreadPool::shared().parallelFor(size, parallelThreshold / 4, [this, &func](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			func(elements[i]);
+		}
+	});
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy, class Func>
+void Sequence<type, Alloc, GrowthPolicy>::forEach(Policy&&, Func func) const {
+	if (!runsInParallel<Policy>()) {
+		for (size_t i = 0; i < size; i++) {
+			func(static_cast<const type&>(elements[i]));
+		}
+		return;
+	}
+	ThreadPool::shared().parallelFor(size, parallelThreshold / 4, [this, &func](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			func(static_cast<const type&>(elements[i]));
+		}
+	});
+}
+
+// replaces every element with func(element)
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy, class Func>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::transform(Policy&& policy, Func func) {
+	forEach(std::forward<Policy>(policy), [&func](type& element) {
+		element = func(static_cast<const type&>(element));
+	});
+	return *this;
+}
+
+// like std::reduce the operation has to be associative and commutative, the pieces are combined in an unspecified grouping;
+// Result has to be constructible from an element
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy, class Result, class BinaryOperation>
+Result Sequence<type, Alloc, GrowthPolicy>::reduce(Policy&&, Result init, BinaryOperation operation) const {
+	if (!runsInParallel<Policy>()) {
+		for (size_t i = 0; i < size; i++) {
+			init = operation(std::move(init), elements[i]);
+		}
+		return init;
+	}
+
+	std::mutex partialsMutex;
+	std::vector<std::pair<size_t, Result>> partials;
+	ThreadPool::shared().parallelFor(size, parallelThreshold / 4, [&](size_t begin, size_t end) {
+		Result partial(elements[begin]);
+		for (size_t i = begin + 1; i < end; i++) {
+			partial = operation(std::move(partial), elements[i]);
+		}
+		std::lock_guard<std::mutex> lock(partialsMutex);
+		partials.emplace_back(begin, std::move(partial));
+	});
+	std::sort(partials.begin(), partials.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+	for (auto& partial : partials) {
+		init = operation(std::move(init), std::move(partial.second));
+	}
+	return init;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::changeAll(Policy&& policy, const type& previousValue, const type& nextValue) {
+	if (!runsInParallel<Policy>()) {
+		return changeAll(previousValue, nextValue);
+	}
+	if (owns(&previousValue) || owns(&nextValue)) {
+		type previous(previousValue);
+		type next(nextValue);
+		return changeAll(std::forward<Policy>(policy), previous, next);
+	}
+
+	forEach(std::forward<Policy>(policy), [&previousValue, &nextValue](type& element) {
+		if (element == previousValue) {
+			element = nextValue;
+		}
+	});
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Policy, class Compare>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::sortElements(Compare comp, bool stable) {
+	if (size < 2) {
+		return *this;
+	}
+	invalidateIndex();
+	// radix sort and the merges of radix sorted pieces work through a buffer as big as the sequence
+	type* scratch = nullptr;
+	if constexpr (sortsByRadix<Compare>) {
+		if (size >= SequenceSort<type>::radixThreshold) {
+			scratch = allocateStorage(size);
+		}
+	}
+	auto sortPiece = [this, scratch, &comp, stable](size_t begin, size_t end) {
+		if constexpr (sortsByRadix<Compare>) {
+			if (scratch != nullptr) {
+				SequenceSort<type>::radixSort(elements + begin, end - begin, scratch + begin);
+				return;
+			}
+		}
+		if (stable) {
+			std::stable_sort(elements + begin, elements + end, comp);
+		}
+		else {
+			SequenceSort<type>::introsort(elements + begin, end - begin, comp);
+		}
+	};
+
+	try {
+		if (!runsInParallel<Policy>()) {
+			sortPiece(0, size);
+		}
+		else {
+			// a power of two pieces, one for each worker and one for the calling thread
+			ThreadPool& pool = ThreadPool::shared();
+			size_t pieces = 1;
+			while (pieces * 2 <= pool.getThreadCount() + 1 && size / (pieces * 2) >= parallelThreshold / 4) {
+				pieces *= 2;
+			}
+			auto bound = [this, pieces](size_t piece) {
+				return size * piece / pieces;
+			};
+			pool.parallelFor(pieces, 1, [&](size_t begin, size_t end) {
+				for (size_t piece = begin; piece < end; piece++) {
+					sortPiece(bound(piece), bound(piece + 1));
+				}
+			});
+			for (size_t width = 1; width < pieces; width *= 2) {
+				pool.parallelFor(pieces / (width * 2), 1, [&](size_t begin, size_t end) {
+					for (size_t merge = begin; merge < end; merge++) {
+						size_t low = bound(merge * width * 2);
+						size_t middle = bound(merge * width * 2 + width);
+						size_t high = bound((merge + 1) * width * 2);
+						if constexpr (sortsByRadix<Compare>) {
+							std::merge(elements + low, elements + middle, elements + middle, elements + high, scratch + low, SequenceSort<type>::radixLess);
+							std::memcpy(static_cast<void*>(elements + low), scratch + low, (high - low) * sizeof(type));
+						}
+						else {
+							std::inplace_merge(elements + low, elements + middle, elements + high, comp);
+						}
+					}
+				});
+			}
+		}
+	}
+	catch (...) {
+		deallocateStorage(scratch, size);
+		throw;
+	}
+	deallocateStorage(scratch, size);
+	return *this;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::sort() {
+	return sortElements<std::execution::sequenced_policy>(std::less<>(), false);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Compare> requires (!ExecutionPolicy<Compare>)
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::sort(Compare comp) {
+	return sortElements<std::execution::sequenced_policy>(comp, false);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::stableSort() {
+	return sortElements<std::execution::sequenced_policy>(std::less<>(), true);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <class Compare> requires (!ExecutionPolicy<Compare>)
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::stableSort(Compare comp) {
+	return sortElements<std::execution::sequenced_policy>(comp, true);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::sort(Policy&&) {
+	return sortElements<Policy>(std::less<>(), false);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy, class Compare>
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::sort(Policy&&, Compare comp) {
+	return sortElements<Policy>(comp, false);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy>
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::stableSort(Policy&&) {
+	return sortElements<Policy>(std::less<>(), true);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+template <ExecutionPolicy Policy, class Compare>
+inline Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::stableSort(Policy&&, Compare comp) {
+	return sortElements<Policy>(comp, true);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::print() const {
+	SequenceText::write(std::cout, *this, FormatOptions());
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::print(std::ostream& os, const FormatOptions& options) const {
+	SequenceText::write(os, *this, options);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+std::ostream& operator<<(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& sequence) {
+	SequenceText::write(os, sequence, FormatOptions());
+	return os;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+std::istream& operator>>(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	// numbers skip the locale-aware extraction; a malformed input leaves the elements read so far and failbit
+	if constexpr (isTextNumber<type>) {
+		try {
+			SequenceText::read(is, seq);
+		}
+		catch (const SequenceFormatError&) {}
+		return is;
+	}
+	size_t n;
 	is >> n;
 	if (!is) return is;
 
@@ -417,12 +1588,15 @@ std::istream& operator>>(std::istream& is, Sequence<type>& seq) {
 	return is;
 }
 
-template<class type>
-bool Sequence<type>::operator==(const Sequence<type>& seq) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+template <class type, class Alloc, class GrowthPolicy>
+bool Sequence<type, Alloc, GrowthPolicy>::operator==(const Sequence<type, Alloc, GrowthPolicy>& seq) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
 	if (getSize() != seq.getSize())
 	{
 		return false;
 	}
+	if constexpr (isTriviallyComparable<type>) {
+		return size == 0 || std::memcmp(elements, seq.elements, size * sizeof(type)) == 0;
+	}
 	for (size_t i = 0; i < getSize(); ++i) {
 		if ((*this)[i] != seq[i])
 		{
@@ -432,13 +1606,49 @@ bool Sequence<type>::operator==(const Sequence<type>& seq) const noexcept(noexce
 	return true;
 }
 
-template<class type>
-bool Sequence<type>::operator!=(const Sequence<type>& seq) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+template <class type, class Alloc, class GrowthPolicy>
+bool Sequence<type, Alloc, GrowthPolicy>::operator!=(const Sequence<type, Alloc, GrowthPolicy>& seq) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
 	return !(*this == seq);
 }
 
-template <class type>
-void Sequence<type>::swap(Sequence<type>& other) noexcept {
+// lexicographic, like std::lexicographical_compare_three_way; a proper prefix orders first
+template <class type, class Alloc, class GrowthPolicy>
+SequenceOrdering<type> Sequence<type, Alloc, GrowthPolicy>::operator<=>(const Sequence<type, Alloc, GrowthPolicy>& seq) const {
+	size_t common = (size < seq.size) ? size : seq.size;
+	size_t i = 0;
+	if constexpr (isTriviallyComparable<type>) {
+		// equal bytes are equal elements, so only the first differing element needs a real comparison
+		if (common > 0) {
+			i = SimdCompare::firstMismatch(elements, seq.elements, common * sizeof(type)) / sizeof(type);
+		}
+	}
+	for (; i < common; i++) {
+		SequenceOrdering<type> order = compareElements(elements[i], seq.elements[i]);
+		if (order != 0) {
+			return order;
+		}
+	}
+	return size <=> seq.size;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+SequenceOrdering<type> Sequence<type, Alloc, GrowthPolicy>::compareElements(const type& a, const type& b) {
+	if constexpr (std::three_way_comparable<type>) {
+		return a <=> b;
+	}
+	else {
+		if (a < b) {
+			return std::weak_ordering::less;
+		}
+		if (b < a) {
+			return std::weak_ordering::greater;
+		}
+		return std::weak_ordering::equivalent;
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::swap(Sequence<type, Alloc, GrowthPolicy>& other) noexcept {
 	size_t savedSize = getSize();
 	size = other.getSize();
 	other.size = savedSize;
@@ -451,98 +1661,383 @@ void Sequence<type>::swap(Sequence<type>& other) noexcept {
 	capacityGrowthStep = other.getCapacityGrowthStep();
 	other.capacityGrowthStep = savedStep;
 
+	type* savedStorage = storage;
+	storage = other.storage;
+	other.storage = savedStorage;
+
 	type* savedElements = elements;
 	elements = other.elements;
 	other.elements = savedElements;
+
+	valueIndex.swap(other.valueIndex);
+
+	// like the standard containers, swapping buffers of unequal non-propagating allocators is undefined
+	if constexpr (AllocTraits::propagate_on_container_swap::value) {
+		using std::swap;
+		swap(allocator, other.allocator);
+	}
 }
 
-template <class type>
-void swap(Sequence<type>& a, Sequence<type>& b) noexcept {
+template <class type, class Alloc, class GrowthPolicy>
+void swap(Sequence<type, Alloc, GrowthPolicy>& a, Sequence<type, Alloc, GrowthPolicy>& b) noexcept {
 	a.swap(b);
 }
 
-template<class type>
-inline Sequence<type>::Sequence(Sequence&& other) noexcept: elements(other.elements), size(other.size), capacity(other.capacity),
-      capacityGrowthStep(other.capacityGrowthStep) {
+template <class type, class Alloc, class GrowthPolicy>
+inline Sequence<type, Alloc, GrowthPolicy>::Sequence(Sequence&& other) noexcept: storage(other.storage), elements(other.elements), size(other.size),
+      capacity(other.capacity), capacityGrowthStep(other.capacityGrowthStep), allocator(std::move(other.allocator)),
+      valueIndex(std::move(other.valueIndex)) {
+	other.storage = nullptr;
 	other.elements = nullptr;
 	other.size = 0;
 	other.capacity = 0;
 	other.capacityGrowthStep = 1;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::push_back(const Sequence<type>& other) {
-	size_t otherSize = other.size;
-	reserve((size + otherSize >= capacity) ? size + otherSize + capacityGrowthStep : size + otherSize);
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>::Sequence(Sequence&& other, const Alloc& allocator) : size(0), capacity(0),
+      capacityGrowthStep(other.capacityGrowthStep), allocator(allocator) {
+	valueIndex = std::move(other.valueIndex);
+	if (this->allocator == other.allocator) {
+		storage = other.storage;
+		elements = other.elements;
+		size = other.size;
+		capacity = other.capacity;
+		other.storage = nullptr;
+		other.elements = nullptr;
+		other.size = 0;
+		other.capacity = 0;
+		other.capacityGrowthStep = 1;
+		return;
+	}
 
-	for (size_t i = 0; i < otherSize; ++i) {
-		elements[size++] = other.elements[i];
+	storage = elements = allocateStorage(other.capacity);
+	capacity = other.capacity;
+	try {
+		for (; size < other.size; ++size) {
+			AllocTraits::construct(this->allocator, elements + size, std::move_if_noexcept(other.elements[size]));
+		}
 	}
+	catch (...) {
+		releaseStorage();
+		throw;
+	}
+	other.clear();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_back(const Sequence<type, Alloc, GrowthPolicy>& other) {
+	size_t otherSize = other.size;
+	openGapAt(size, otherSize);
+
+	Relocation<type>::copy(allocator, other.elements, otherSize, elements + size);
+	size += otherSize;
+	indexInserted(size - otherSize, otherSize);
 	
 	return *this;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::push_back(const type* array, size_t arraySize) {
-	reserve((size + arraySize >= capacity)?size + arraySize + capacityGrowthStep : size + arraySize);
-
-	for (size_t i = 0; i < arraySize; ++i) {
-		elements[size++] = array[i];
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_back(const type* array, size_t arraySize) {
+	if (owns(array)) {
+		Sequence<type, Alloc, GrowthPolicy> copy(array, arraySize, arraySize, 1, allocator);
+		return push_back(copy.elements, copy.size);
 	}
+	openGapAt(size, arraySize);
+
+	Relocation<type>::copy(allocator, array, arraySize, elements + size);
+	size += arraySize;
+	indexInserted(size - arraySize, arraySize);
 
 	return *this;
 }
 
-template<class type>
-Sequence<type>& Sequence<type>::push_front(const Sequence<type>& other) {
-	size_t otherSize = other.size;
-	reserve((size + otherSize >= capacity) ? size + otherSize + capacityGrowthStep : size + otherSize);
-	size += otherSize;
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_front(const Sequence<type, Alloc, GrowthPolicy>& other) {
+	if (this == &other) {
+		Sequence<type, Alloc, GrowthPolicy> copy(other, allocator);
+		return push_front(copy.elements, copy.size);
+	}
+	return push_front(other.elements, other.size);
+}
 
-	for (size_t i = size + otherSize - 1; i >= size - otherSize; i--) {
-		elements[i] = elements[i - otherSize];
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::push_front(const type* other, size_t otherSize) {
+	if (owns(other)) {
+		Sequence<type, Alloc, GrowthPolicy> copy(other, otherSize, otherSize, 1, allocator);
+		return push_front(copy.elements, copy.size);
+	}
+	if (otherSize == 0) {
+		return *this;
 	}
-	for (size_t i = 0; i < otherSize; i++) {
-		elements[i] = other[i];
+
+	openGapAt(0, otherSize);
+	try {
+		Relocation<type>::copy(allocator, other, otherSize, elements);
 	}
+	catch (...) {
+		closeGapAt(0, otherSize);
+		throw;
+	}
+	size += otherSize;
+	indexInserted(0, otherSize);
 
 	return *this;
 }
 
-template<class type>
-Sequence<type>& Sequence<type>::push_front(const type* other, size_t otherSize) {
-	reserve((size + otherSize >= capacity) ? size + otherSize + capacityGrowthStep : size + otherSize);
-	size += otherSize;
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::concat(const Sequence<type, Alloc, GrowthPolicy>& other) {
+	return this->push_back(other);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceOperand<type, Alloc, GrowthPolicy>::SequenceOperand(const Base& operand) noexcept : borrowed(&operand) {}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline SequenceOperand<type, Alloc, GrowthPolicy>::SequenceOperand(Base&& operand) noexcept : owned(std::move(operand)) {}
 
-	for (size_t i = size + otherSize - 1; i >= size - otherSize; i--) {
-		elements[i] = elements[i - otherSize];
+template <class type, class Alloc, class GrowthPolicy>
+inline const Sequence<type, Alloc, GrowthPolicy>& SequenceOperand<type, Alloc, GrowthPolicy>::get() const noexcept {
+	return (borrowed != nullptr) ? *borrowed : *owned;
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+inline SequenceSum<type, Alloc, GrowthPolicy, count>::SequenceSum(Base&& head, std::array<Operand, count>&& parts) noexcept
+	: head(std::move(head)), parts(std::move(parts)) {}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+size_t SequenceSum<type, Alloc, GrowthPolicy, count>::getSize() const noexcept {
+	size_t total = head.getSize();
+	for (const Operand& part : parts) {
+		total += part.get().getSize();
 	}
-	for (size_t i = 0; i < otherSize; i++) {
-		elements[i] = other[i];
+	return total;
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+inline bool SequenceSum<type, Alloc, GrowthPolicy, count>::isEmpty() const noexcept {
+	return getSize() == 0;
+}
+
+// nullptr past the end
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+const type* SequenceSum<type, Alloc, GrowthPolicy, count>::locate(size_t index) const noexcept {
+	if (index < head.getSize()) {
+		return head.data() + index;
 	}
+	index -= head.getSize();
+	for (const Operand& part : parts) {
+		const Base& operand = part.get();
+		if (index < operand.getSize()) {
+			return operand.data() + index;
+		}
+		index -= operand.getSize();
+	}
+	return nullptr;
+}
 
-	return *this;
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+inline const type& SequenceSum<type, Alloc, GrowthPolicy, count>::operator[] (size_t index) const {
+	return *locate(index);
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::concat(const Sequence<type>& other) {
-	return this->push_back(other);
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+const type& SequenceSum<type, Alloc, GrowthPolicy, count>::at(size_t index) const {
+	const type* found = locate(index);
+	if (found == nullptr) {
+		throw std::out_of_range("Index out of range");
+	}
+	return *found;
 }
 
-template <class type>
-[[nodiscard]] Sequence<type> operator+(const Sequence<type>& a, const Sequence<type>& b) {
-	Sequence<type> result(a);
-	result.concat(b);
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+const type& SequenceSum<type, Alloc, GrowthPolicy, count>::front() const {
+	if (isEmpty()) {
+		throw std::out_of_range("Cannot call front() on an empty Sequence");
+	}
+	return *locate(0);
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+const type& SequenceSum<type, Alloc, GrowthPolicy, count>::back() const {
+	size_t total = getSize();
+	if (total == 0) {
+		throw std::out_of_range("Cannot call back() on an empty Sequence");
+	}
+	return *locate(total - 1);
+}
+
+// getSize() when the value is absent, like Sequence::find
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+size_t SequenceSum<type, Alloc, GrowthPolicy, count>::find(const type& value) const {
+	size_t offset = head.find(value);
+	if (offset < head.getSize()) {
+		return offset;
+	}
+	for (const Operand& part : parts) {
+		const Base& operand = part.get();
+		size_t found = operand.find(value);
+		if (found < operand.getSize()) {
+			return offset + found;
+		}
+		offset += operand.getSize();
+	}
+	return offset;
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+bool SequenceSum<type, Alloc, GrowthPolicy, count>::contains(const type& value) const {
+	if (head.contains(value)) {
+		return true;
+	}
+	for (const Operand& part : parts) {
+		if (part.get().contains(value)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+size_t SequenceSum<type, Alloc, GrowthPolicy, count>::containsLotsOf(const type& value) const {
+	size_t total = head.containsLotsOf(value);
+	for (const Operand& part : parts) {
+		total += part.get().containsLotsOf(value);
+	}
+	return total;
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+typename SequenceSum<type, Alloc, GrowthPolicy, count>::Base SequenceSum<type, Alloc, GrowthPolicy, count>::materialize() const& {
+	Base result(0, head.getCapacityGrowthStep(), std::allocator_traits<Alloc>::select_on_container_copy_construction(head.getAllocator()));
+	result.reserve(getSize());
+	result.push_back(head);
+	for (const Operand& part : parts) {
+		result.push_back(part.get());
+	}
 	return result;
 }
 
-template <class type>
-Sequence<type>& Sequence<type>::operator+=(const Sequence<type>& other) {
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+typename SequenceSum<type, Alloc, GrowthPolicy, count>::Base SequenceSum<type, Alloc, GrowthPolicy, count>::materialize() && {
+	head.reserve(getSize());
+	for (const Operand& part : parts) {
+		head.push_back(part.get());
+	}
+	return std::move(head);
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+inline SequenceSum<type, Alloc, GrowthPolicy, count>::operator Base() const& {
+	return materialize();
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+inline SequenceSum<type, Alloc, GrowthPolicy, count>::operator Base() && {
+	return std::move(*this).materialize();
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+inline void SequenceSum<type, Alloc, GrowthPolicy, count>::print() const {
+	materialize().print();
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+std::ostream& operator<<(std::ostream& os, const SequenceSum<type, Alloc, GrowthPolicy, count>& sum) {
+	return os << sum.materialize();
+}
+
+// the head of the tail expression becomes an owned operand
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+template <size_t more>
+SequenceSum<type, Alloc, GrowthPolicy, count + 1 + more> SequenceSum<type, Alloc, GrowthPolicy, count>::append(
+	SequenceSum<type, Alloc, GrowthPolicy, more>&& tail) && {
+	std::array<Operand, count + 1 + more> joined;
+	std::move(parts.begin(), parts.end(), joined.begin());
+	joined[count] = Operand(std::move(tail.head));
+	std::move(tail.parts.begin(), tail.parts.end(), joined.begin() + count + 1);
+	return SequenceSum<type, Alloc, GrowthPolicy, count + 1 + more>(std::move(head), std::move(joined));
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+SequenceSum<type, Alloc, GrowthPolicy, count + 1> SequenceSum<type, Alloc, GrowthPolicy, count>::append(Operand&& tail) && {
+	std::array<Operand, count + 1> joined;
+	std::move(parts.begin(), parts.end(), joined.begin());
+	joined[count] = std::move(tail);
+	return SequenceSum<type, Alloc, GrowthPolicy, count + 1>(std::move(head), std::move(joined));
+}
+
+// an empty head with the allocator and growth step of a, as a copy of a would have
+template <class type, class Alloc, class GrowthPolicy>
+[[nodiscard]] Sequence<type, Alloc, GrowthPolicy> sumHeadFor(const Sequence<type, Alloc, GrowthPolicy>& a) {
+	return Sequence<type, Alloc, GrowthPolicy>(0, a.getCapacityGrowthStep(),
+		std::allocator_traits<Alloc>::select_on_container_copy_construction(a.getAllocator()));
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, 2> operator+(const Sequence<type, Alloc, GrowthPolicy>& a, const Sequence<type, Alloc, GrowthPolicy>& b) {
+	return SequenceSum<type, Alloc, GrowthPolicy, 2>(sumHeadFor(a), { a, b });
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, 2> operator+(const Sequence<type, Alloc, GrowthPolicy>& a, Sequence<type, Alloc, GrowthPolicy>&& b) {
+	return SequenceSum<type, Alloc, GrowthPolicy, 2>(sumHeadFor(a), { a, std::move(b) });
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, 1> operator+(Sequence<type, Alloc, GrowthPolicy>&& a, const Sequence<type, Alloc, GrowthPolicy>& b) {
+	if (&a == &b) {
+		// moving a would empty b as well
+		return SequenceSum<type, Alloc, GrowthPolicy, 1>(Sequence<type, Alloc, GrowthPolicy>(a), { b });
+	}
+	return SequenceSum<type, Alloc, GrowthPolicy, 1>(std::move(a), { b });
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, 1> operator+(Sequence<type, Alloc, GrowthPolicy>&& a, Sequence<type, Alloc, GrowthPolicy>&& b) {
+	if (&a == &b) {
+		return SequenceSum<type, Alloc, GrowthPolicy, 1>(Sequence<type, Alloc, GrowthPolicy>(a), { std::move(b) });
+	}
+	return SequenceSum<type, Alloc, GrowthPolicy, 1>(std::move(a), { std::move(b) });
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, count + 1> operator+(SequenceSum<type, Alloc, GrowthPolicy, count>&& a,
+	const Sequence<type, Alloc, GrowthPolicy>& b) {
+	return std::move(a).append(SequenceOperand<type, Alloc, GrowthPolicy>(b));
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, count + 1> operator+(SequenceSum<type, Alloc, GrowthPolicy, count>&& a,
+	Sequence<type, Alloc, GrowthPolicy>&& b) {
+	return std::move(a).append(SequenceOperand<type, Alloc, GrowthPolicy>(std::move(b)));
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count, size_t more>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, count + 1 + more> operator+(SequenceSum<type, Alloc, GrowthPolicy, count>&& a,
+	SequenceSum<type, Alloc, GrowthPolicy, more>&& b) {
+	return std::move(a).append(std::move(b));
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, count + 2> operator+(const Sequence<type, Alloc, GrowthPolicy>& a,
+	SequenceSum<type, Alloc, GrowthPolicy, count>&& b) {
+	return SequenceSum<type, Alloc, GrowthPolicy, 1>(sumHeadFor(a), { a }).append(std::move(b));
+}
+
+template <class type, class Alloc, class GrowthPolicy, size_t count>
+[[nodiscard]] SequenceSum<type, Alloc, GrowthPolicy, count + 1> operator+(Sequence<type, Alloc, GrowthPolicy>&& a,
+	SequenceSum<type, Alloc, GrowthPolicy, count>&& b) {
+	return SequenceSum<type, Alloc, GrowthPolicy, 0>(std::move(a), {}).append(std::move(b));
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+Sequence<type, Alloc, GrowthPolicy>& Sequence<type, Alloc, GrowthPolicy>::operator+=(const Sequence<type, Alloc, GrowthPolicy>& other) {
 	return this->concat(other);
 }
 
-template <class type>
-inline void Sequence<type>::setCapacityGrowthStep(size_t step) noexcept {
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::setCapacityGrowthStep(size_t step) noexcept {
 	if (step == 0)
 	{
 		capacityGrowthStep = 1;
@@ -551,13 +2046,22 @@ inline void Sequence<type>::setCapacityGrowthStep(size_t step) noexcept {
 	capacityGrowthStep = step;
 }
 
-template <class type>
-inline size_t Sequence<type>::getCapacityGrowthStep() const noexcept {
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::getCapacityGrowthStep() const noexcept {
 	return capacityGrowthStep;
 }
 
-template <class type>
-size_t Sequence<type>::find(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())){
+template <class type, class Alloc, class GrowthPolicy>
+size_t Sequence<type, Alloc, GrowthPolicy>::find(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())){
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (const SequenceIndex<type>* fresh = freshIndex()) {
+			size_t found = fresh->first(value);
+			return (found == SequenceIndex<type>::npos) ? size : found;
+		}
+	}
+	if constexpr (SimdSearch<type>::isSupported) {
+		return SimdSearch<type>::find(elements, size, value);
+	}
 	for (size_t i = 0; i < size; i++)
 	{
 		if (value == elements[i]) { return i; }
@@ -565,13 +2069,22 @@ size_t Sequence<type>::find(const type& value) const noexcept(noexcept(std::decl
 	return size;
 }
 
-template <class type>
-size_t Sequence<type>::findFirst(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+template <class type, class Alloc, class GrowthPolicy>
+size_t Sequence<type, Alloc, GrowthPolicy>::findFirst(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
 	return find(value);
 }
 
-template <class type>
-size_t Sequence<type>::findLast(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+template <class type, class Alloc, class GrowthPolicy>
+size_t Sequence<type, Alloc, GrowthPolicy>::findLast(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (const SequenceIndex<type>* fresh = freshIndex()) {
+			size_t found = fresh->last(value);
+			return (found == SequenceIndex<type>::npos) ? size : found;
+		}
+	}
+	if constexpr (SimdSearch<type>::isSupported) {
+		return SimdSearch<type>::findLast(elements, size, value);
+	}
 	for (size_t i = size; i-- > 0;)
 	{
 		if (value == elements[i]) { return i; }
@@ -579,14 +2092,114 @@ size_t Sequence<type>::findLast(const type& value) const noexcept(noexcept(std::
 	return size;
 }
 
-template <class type>
-[[nodiscard]] size_t Sequence<type>::totalSizeInBytes() const {
-	return sizeof(type) * capacity + sizeof(capacity) + sizeof(size) + sizeof(capacityGrowthStep) + sizeof(elements);
+template <class type, class Alloc, class GrowthPolicy>
+[[nodiscard]] size_t Sequence<type, Alloc, GrowthPolicy>::totalSizeInBytes() const {
+	return sizeof(*this) + dataSizeInBytes() + indexSizeInBytes();
 }
 
-template <class type>
-[[nodiscard]] size_t Sequence<type>::dataSizeInBytes() const {
+template <class type, class Alloc, class GrowthPolicy>
+[[nodiscard]] size_t Sequence<type, Alloc, GrowthPolicy>::dataSizeInBytes() const {
 	return sizeof(type) * capacity;
 }
 
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::enableIndex() {
+	static_assert(SequenceIndex<type>::isSupported, "Sequence::enableIndex: the element type needs std::hash, a default constructor and copy assignment");
+	if (!valueIndex) {
+		valueIndex = std::make_unique<SequenceIndex<type>>();
+	}
+	valueIndex->invalidate();
+	if (!valueIndex->refresh(elements, size)) {
+		valueIndex.reset();
+		throw std::bad_alloc();
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::disableIndex() noexcept {
+	valueIndex.reset();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline bool Sequence<type, Alloc, GrowthPolicy>::hasIndex() const noexcept {
+	return valueIndex != nullptr;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::indexInserted(size_t position, size_t count) noexcept {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (valueIndex) {
+			valueIndex->inserted(elements, size, position, count);
+		}
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::indexErasing(size_t position) noexcept {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (valueIndex) {
+			valueIndex->erasing(elements, size, position);
+		}
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::indexForget(size_t position) noexcept {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (valueIndex) {
+			valueIndex->forget(elements, size, position);
+		}
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::indexRemember(size_t position) noexcept {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (valueIndex) {
+			valueIndex->remember(elements[position], position);
+		}
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline void Sequence<type, Alloc, GrowthPolicy>::invalidateIndex() noexcept {
+	if (valueIndex) {
+		valueIndex->invalidate();
+	}
+}
+
+// copies have an index when the source has one, it is built by their first lookup
+template <class type, class Alloc, class GrowthPolicy>
+void Sequence<type, Alloc, GrowthPolicy>::copyIndexSetting(const Sequence& other) {
+	if constexpr (SequenceIndex<type>::isSupported) {
+		if (!other.valueIndex) {
+			valueIndex.reset();
+			return;
+		}
+		if (!valueIndex) {
+			valueIndex = std::make_unique<SequenceIndex<type>>();
+		}
+		valueIndex->invalidate();
+	}
+}
+
+// a stale index is rebuilt here, when that fails the caller scans
+template <class type, class Alloc, class GrowthPolicy>
+inline const SequenceIndex<type>* Sequence<type, Alloc, GrowthPolicy>::freshIndex() const noexcept {
+	if (valueIndex && valueIndex->refresh(elements, size)) {
+		return valueIndex.get();
+	}
+	return nullptr;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+inline size_t Sequence<type, Alloc, GrowthPolicy>::indexSizeInBytes() const noexcept {
+	return valueIndex ? valueIndex->sizeInBytes() : 0;
+}
+
+namespace pmr {
+	template <class type, class GrowthPolicy = GeometricGrowth<>>
+	using Sequence = ::Sequence<type, std::pmr::polymorphic_allocator<type>, GrowthPolicy>;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,540 @@
+#ifndef SEQUENCE_BINARY_H
+#define SEQUENCE_BINARY_H
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include "Sequence.h"
+#include "SequenceFormatError.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// Versioned binary format:
+//   32-byte header: "SEQB", version (u16), endianness of the payload (u8, 1 little / 2 big), flags (u8),
+//                   element size (u32, 0 for codec payloads), reserved (u32), count (u64), payload bytes (u64);
+//                   header fields are little endian
+//   payload:        trivially copyable elements as one raw block, anything else through a codec (flags bit 0)
+// Raw blocks go out with one call: write on streams, writev on file descriptors. They come back in with read calls of
+// doubling size, so the buffer follows the bytes that actually arrive and a header claiming more than the input holds
+// allocates at most twice the input; codec payloads are read the same way and decoding reserves no more elements than bytes.
+// Arithmetic payloads written on a machine of the other endianness are byte swapped on reading.
+// Raw blocks of bool are checked to hold only 0 and 1; enums without a fixed underlying type need a codec to be read,
+// since their valid values cannot be checked.
+
+// Codec for element types that are not trivially copyable. A specialization provides
+//   static void encode(std::string& out, const type& value);                        appends the bytes of value
+//   static bool decode(const char*& cursor, const char* end, type& value);          false when the bytes run out
+// and a codec object with the same members can be passed to writeBinary/readBinary instead.
+template <class type>
+struct BinaryCodec;
+
+// length (u64, little endian) followed by the characters
+template <>
+struct BinaryCodec<std::string> {
+	static void encode(std::string& out, const std::string& value);
+	[[nodiscard]] static bool decode(const char*& cursor, const char* end, std::string& value);
+};
+
+class SequenceBinary {
+public:
+	static constexpr uint16_t version = 1;
+	static constexpr size_t headerSize = 32;
+	static constexpr uint8_t codecFlag = 1;
+
+	template <class type, class Alloc, class GrowthPolicy, class Codec>
+	static void write(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec);
+	template <class type, class Alloc, class GrowthPolicy, class Codec>
+	static void read(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec);
+	template <class type, class Alloc, class GrowthPolicy, class Codec>
+	static void write(int fd, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec);
+	template <class type, class Alloc, class GrowthPolicy, class Codec>
+	static void read(int fd, Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec);
+
+	// no codec is used for trivially copyable types unless one is given explicitly
+	struct Raw {};
+	// first read call of a payload, later calls double up to the rest of it
+	static constexpr size_t chunkBytes = 1 << 20;
+
+private:
+	template <class> friend class MappedSequence;
+
+	struct Header {
+		uint8_t endianness = 0;
+		uint8_t flags = 0;
+		uint32_t elementSize = 0;
+		uint64_t count = 0;
+		uint64_t payloadBytes = 0;
+	};
+
+	// every bit pattern of these is a value, except for bool, which findInvalid checks
+	template <class type>
+	static constexpr bool isRawReadable = !std::is_enum_v<type> || requires { type{ std::underlying_type_t<type>{} }; };
+	template <class type>
+	static constexpr bool isSwappable = (std::is_arithmetic_v<type> || std::is_enum_v<type>)
+		&& (sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4 || sizeof(type) == 8);
+	static constexpr uint8_t nativeEndianness = (std::endian::native == std::endian::little) ? 1 : 2;
+
+	static void encodeHeader(const Header& header, unsigned char* bytes) noexcept;
+	[[nodiscard]] static Header decodeHeader(const unsigned char* bytes);
+	template <class type, class Codec>
+	[[nodiscard]] static Header headerFor(size_t count, size_t payloadBytes);
+	template <class type, class Codec>
+	static void checkHeader(const Header& header);
+	template <class type, class Alloc, class GrowthPolicy, class Codec>
+	[[nodiscard]] static std::string encodePayload(const Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec);
+	// index of the first element whose bytes are not a value of type, count when there is none
+	template <class type>
+	[[nodiscard]] static size_t findInvalid(const type* elements, size_t count) noexcept;
+	// readChunk(buffer, bytes) returns the number of bytes read, less than bytes only at the end of the input
+	template <class type, class Alloc, class GrowthPolicy, class ReadChunk>
+	static void readBlock(Sequence<type, Alloc, GrowthPolicy>& seq, const Header& header, ReadChunk readChunk);
+	template <class ReadChunk>
+	[[nodiscard]] static std::string readPayload(const Header& header, ReadChunk readChunk);
+	template <class type, class Alloc, class GrowthPolicy, class Codec>
+	static void decodePayload(Sequence<type, Alloc, GrowthPolicy>& seq, const Header& header, const std::string& payload, Codec& codec);
+
+	static void writeAll(int fd, const void* first, size_t firstBytes, const void* second, size_t secondBytes);
+	// number of bytes read, less than bytes only at the end of the file
+	[[nodiscard]] static size_t readAll(int fd, void* buffer, size_t bytes);
+};
+
+template <class type, class Alloc, class GrowthPolicy>
+void writeBinary(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq);
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void writeBinary(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec);
+// replaces the contents of seq; throws SequenceFormatError on a header that does not match type or a truncated payload
+template <class type, class Alloc, class GrowthPolicy>
+void readBinary(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq);
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void readBinary(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec);
+// the same through a file descriptor, bypassing iostreams; I/O failures throw std::system_error
+template <class type, class Alloc, class GrowthPolicy>
+void writeBinary(int fd, const Sequence<type, Alloc, GrowthPolicy>& seq);
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void writeBinary(int fd, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec);
+template <class type, class Alloc, class GrowthPolicy>
+void readBinary(int fd, Sequence<type, Alloc, GrowthPolicy>& seq);
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void readBinary(int fd, Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec);
+
+
+inline void BinaryCodec<std::string>::encode(std::string& out, const std::string& value) {
+	unsigned char length[8];
+	uint64_t size = value.size();
+	for (size_t i = 0; i < 8; i++) {
+		length[i] = static_cast<unsigned char>(size >> (i * 8));
+	}
+	out.append(reinterpret_cast<const char*>(length), 8);
+	out.append(value);
+}
+
+inline bool BinaryCodec<std::string>::decode(const char*& cursor, const char* end, std::string& value) {
+	if (end - cursor < 8) {
+		return false;
+	}
+	uint64_t size = 0;
+	for (size_t i = 0; i < 8; i++) {
+		size |= static_cast<uint64_t>(static_cast<unsigned char>(cursor[i])) << (i * 8);
+	}
+	if (static_cast<uint64_t>(end - cursor - 8) < size) {
+		return false;
+	}
+	value.assign(cursor + 8, static_cast<size_t>(size));
+	cursor += 8 + size;
+	return true;
+}
+
+inline void SequenceBinary::encodeHeader(const Header& header, unsigned char* bytes) noexcept {
+	auto put = [&bytes](size_t offset, uint64_t value, size_t width) {
+		for (size_t i = 0; i < width; i++) {
+			bytes[offset + i] = static_cast<unsigned char>(value >> (i * 8));
+		}
+	};
+	std::memcpy(bytes, "SEQB", 4);
+	put(4, version, 2);
+	put(6, header.endianness, 1);
+	put(7, header.flags, 1);
+	put(8, header.elementSize, 4);
+	put(12, 0, 4);
+	put(16, header.count, 8);
+	put(24, header.payloadBytes, 8);
+}
+
+inline SequenceBinary::Header SequenceBinary::decodeHeader(const unsigned char* bytes) {
+	auto get = [bytes](size_t offset, size_t width) {
+		uint64_t value = 0;
+		for (size_t i = 0; i < width; i++) {
+			value |= static_cast<uint64_t>(bytes[offset + i]) << (i * 8);
+		}
+		return value;
+	};
+	if (std::memcmp(bytes, "SEQB", 4) != 0) {
+		throw SequenceFormatError("Not a binary sequence", 0);
+	}
+	if (get(4, 2) != version) {
+		throw SequenceFormatError("Unsupported binary sequence version " + std::to_string(get(4, 2)), 4);
+	}
+	Header header;
+	header.endianness = static_cast<uint8_t>(get(6, 1));
+	header.flags = static_cast<uint8_t>(get(7, 1));
+	header.elementSize = static_cast<uint32_t>(get(8, 4));
+	header.count = get(16, 8);
+	header.payloadBytes = get(24, 8);
+	if (header.endianness != 1 && header.endianness != 2) {
+		throw SequenceFormatError("Unknown endianness", 6);
+	}
+	return header;
+}
+
+template <class type, class Codec>
+SequenceBinary::Header SequenceBinary::headerFor(size_t count, size_t payloadBytes) {
+	Header header;
+	header.endianness = nativeEndianness;
+	header.flags = std::is_same_v<Codec, Raw> ? 0 : codecFlag;
+	// codec output does not depend on the in-memory size, which differs between standard libraries for std::string
+	header.elementSize = std::is_same_v<Codec, Raw> ? static_cast<uint32_t>(sizeof(type)) : 0;
+	header.count = count;
+	header.payloadBytes = payloadBytes;
+	return header;
+}
+
+template <class type, class Codec>
+void SequenceBinary::checkHeader(const Header& header) {
+	constexpr bool raw = std::is_same_v<Codec, Raw>;
+	if (((header.flags & codecFlag) != 0) == raw) {
+		throw SequenceFormatError(raw ? "Payload needs a codec" : "Payload is a raw block, not codec output", 7);
+	}
+	if constexpr (raw) {
+		if (header.elementSize != sizeof(type)) {
+			throw SequenceFormatError("Element size " + std::to_string(header.elementSize) + " does not match "
+				+ std::to_string(sizeof(type)), 8);
+		}
+		if (header.endianness != nativeEndianness && !isSwappable<type>) {
+			throw SequenceFormatError("Payload endianness differs and the elements cannot be byte swapped", 6);
+		}
+		if (header.payloadBytes / sizeof(type) != header.count || header.payloadBytes % sizeof(type) != 0) {
+			throw SequenceFormatError("Payload size does not match the element count", 24);
+		}
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+std::string SequenceBinary::encodePayload(const Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec) {
+	std::string payload;
+	for (const type& value : seq) {
+		codec.encode(payload, value);
+	}
+	return payload;
+}
+
+template <class type>
+size_t SequenceBinary::findInvalid(const type* elements, size_t count) noexcept {
+	if constexpr (std::is_same_v<type, bool>) {
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(elements);
+		for (size_t i = 0; i < count; i++) {
+			if (bytes[i] > 1) {
+				return i;
+			}
+		}
+	}
+	return count;
+}
+
+// the elements are counted in seq.size as their chunks arrive and entered into the index once all are there
+template <class type, class Alloc, class GrowthPolicy, class ReadChunk>
+void SequenceBinary::readBlock(Sequence<type, Alloc, GrowthPolicy>& seq, const Header& header, ReadChunk readChunk) {
+	seq.clear();
+	const size_t count = static_cast<size_t>(header.count);
+	const size_t firstChunk = (chunkBytes / sizeof(type) > 0) ? chunkBytes / sizeof(type) : 1;
+	try {
+		while (seq.size < count) {
+			size_t step = (seq.size < firstChunk) ? firstChunk : seq.size;
+			size_t wanted = (count - seq.size < step) ? count - seq.size : step;
+			seq.reserve(seq.size + wanted);
+			size_t bytes = wanted * sizeof(type);
+			size_t got = readChunk(reinterpret_cast<char*>(seq.elements + seq.size), bytes);
+			if (got != bytes) {
+				throw SequenceFormatError("Truncated payload", headerSize + seq.size * sizeof(type) + got);
+			}
+			seq.size += wanted;
+		}
+		size_t invalid = findInvalid(seq.elements, count);
+		if (invalid != count) {
+			throw SequenceFormatError("Element " + std::to_string(invalid) + " is not a value of the element type",
+				headerSize + invalid * sizeof(type));
+		}
+	}
+	catch (...) {
+		seq.clear();
+		throw;
+	}
+	if (header.endianness != nativeEndianness) {
+		unsigned char* bytes = reinterpret_cast<unsigned char*>(seq.elements);
+		for (size_t i = 0; i < count; i++) {
+			std::reverse(bytes + i * sizeof(type), bytes + (i + 1) * sizeof(type));
+		}
+	}
+	seq.indexInserted(0, count);
+}
+
+template <class ReadChunk>
+std::string SequenceBinary::readPayload(const Header& header, ReadChunk readChunk) {
+	const size_t total = static_cast<size_t>(header.payloadBytes);
+	std::string payload;
+	while (payload.size() < total) {
+		size_t done = payload.size();
+		size_t step = (done < chunkBytes) ? chunkBytes : done;
+		size_t wanted = (total - done < step) ? total - done : step;
+		payload.resize(done + wanted);
+		size_t got = readChunk(payload.data() + done, wanted);
+		if (got != wanted) {
+			throw SequenceFormatError("Truncated payload", headerSize + done + got);
+		}
+	}
+	return payload;
+}
+
+// codecs spend at least a byte per element in practice, so the payload size bounds the reserve; push_back takes the rest
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void SequenceBinary::decodePayload(Sequence<type, Alloc, GrowthPolicy>& seq, const Header& header, const std::string& payload, Codec& codec) {
+	seq.clear();
+	seq.reserve((header.count < payload.size()) ? static_cast<size_t>(header.count) : payload.size());
+	const char* cursor = payload.data();
+	const char* end = payload.data() + payload.size();
+	for (uint64_t i = 0; i < header.count; i++) {
+		type value;
+		if (!codec.decode(cursor, end, value)) {
+			seq.clear();
+			throw SequenceFormatError("Truncated element " + std::to_string(i), headerSize + static_cast<size_t>(cursor - payload.data()));
+		}
+		seq.push_back(std::move(value));
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void SequenceBinary::write(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec) {
+	static_assert(!std::is_same_v<Codec, Raw> || std::is_trivially_copyable_v<type>, "SequenceBinary: raw blocks need trivially copyable elements");
+	unsigned char header[headerSize];
+	if constexpr (std::is_same_v<Codec, Raw>) {
+		size_t bytes = seq.getSize() * sizeof(type);
+		encodeHeader(headerFor<type, Codec>(seq.getSize(), bytes), header);
+		os.write(reinterpret_cast<const char*>(header), headerSize);
+		os.write(reinterpret_cast<const char*>(seq.data()), static_cast<std::streamsize>(bytes));
+	}
+	else {
+		std::string payload = encodePayload(seq, codec);
+		encodeHeader(headerFor<type, Codec>(seq.getSize(), payload.size()), header);
+		os.write(reinterpret_cast<const char*>(header), headerSize);
+		os.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void SequenceBinary::read(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec) {
+	static_assert(!std::is_same_v<Codec, Raw> || std::is_trivially_copyable_v<type>, "SequenceBinary: raw blocks need trivially copyable elements");
+	static_assert(!std::is_same_v<Codec, Raw> || isRawReadable<type>, "SequenceBinary: enums without a fixed underlying type need a codec");
+	unsigned char bytes[headerSize];
+	if (!is.read(reinterpret_cast<char*>(bytes), headerSize)) {
+		throw SequenceFormatError("Truncated header", static_cast<size_t>(is.gcount()));
+	}
+	Header header = decodeHeader(bytes);
+	checkHeader<type, Codec>(header);
+
+	auto readChunk = [&is](char* buffer, size_t bytes) {
+		is.read(buffer, static_cast<std::streamsize>(bytes));
+		return static_cast<size_t>(is.gcount());
+	};
+	if constexpr (std::is_same_v<Codec, Raw>) {
+		readBlock(seq, header, readChunk);
+	}
+	else {
+		decodePayload(seq, header, readPayload(header, readChunk), codec);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void SequenceBinary::write(int fd, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec) {
+	static_assert(!std::is_same_v<Codec, Raw> || std::is_trivially_copyable_v<type>, "SequenceBinary: raw blocks need trivially copyable elements");
+	unsigned char header[headerSize];
+	if constexpr (std::is_same_v<Codec, Raw>) {
+		size_t bytes = seq.getSize() * sizeof(type);
+		encodeHeader(headerFor<type, Codec>(seq.getSize(), bytes), header);
+		writeAll(fd, header, headerSize, seq.data(), bytes);
+	}
+	else {
+		std::string payload = encodePayload(seq, codec);
+		encodeHeader(headerFor<type, Codec>(seq.getSize(), payload.size()), header);
+		writeAll(fd, header, headerSize, payload.data(), payload.size());
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void SequenceBinary::read(int fd, Sequence<type, Alloc, GrowthPolicy>& seq, Codec& codec) {
+	static_assert(!std::is_same_v<Codec, Raw> || std::is_trivially_copyable_v<type>, "SequenceBinary: raw blocks need trivially copyable elements");
+	static_assert(!std::is_same_v<Codec, Raw> || isRawReadable<type>, "SequenceBinary: enums without a fixed underlying type need a codec");
+	unsigned char bytes[headerSize];
+	size_t got = readAll(fd, bytes, headerSize);
+	if (got != headerSize) {
+		throw SequenceFormatError("Truncated header", got);
+	}
+	Header header = decodeHeader(bytes);
+	checkHeader<type, Codec>(header);
+
+	auto readChunk = [fd](char* buffer, size_t bytes) { return readAll(fd, buffer, bytes); };
+	if constexpr (std::is_same_v<Codec, Raw>) {
+		readBlock(seq, header, readChunk);
+	}
+	else {
+		decodePayload(seq, header, readPayload(header, readChunk), codec);
+	}
+}
+
+// writev sends header and payload in one call; a short write, e.g. past 2 GB on Linux, continues with the rest
+inline void SequenceBinary::writeAll(int fd, const void* first, size_t firstBytes, const void* second, size_t secondBytes) {
+	const char* parts[2] = { static_cast<const char*>(first), static_cast<const char*>(second) };
+	size_t left[2] = { firstBytes, secondBytes };
+	size_t part = 0;
+	for (;;) {
+		while (part < 2 && left[part] == 0) {
+			part++;
+		}
+		if (part == 2) {
+			return;
+		}
+#if defined(_WIN32)
+		size_t chunk = (left[part] < (size_t(1) << 30)) ? left[part] : (size_t(1) << 30);
+		long long written = _write(fd, parts[part], static_cast<unsigned>(chunk));
+#else
+		iovec vectors[2];
+		int vectorCount = 0;
+		for (size_t i = part; i < 2; i++) {
+			if (left[i] != 0) {
+				vectors[vectorCount].iov_base = const_cast<char*>(parts[i]);
+				vectors[vectorCount].iov_len = left[i];
+				vectorCount++;
+			}
+		}
+		long long written = ::writev(fd, vectors, vectorCount);
+#endif
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::system_error(errno, std::generic_category(), "writeBinary");
+		}
+		size_t done = static_cast<size_t>(written);
+		for (size_t i = part; i < 2 && done > 0; i++) {
+			size_t step = (done < left[i]) ? done : left[i];
+			parts[i] += step;
+			left[i] -= step;
+			done -= step;
+		}
+	}
+}
+
+inline size_t SequenceBinary::readAll(int fd, void* buffer, size_t bytes) {
+	char* cursor = static_cast<char*>(buffer);
+	size_t done = 0;
+	while (done < bytes) {
+		size_t chunk = ((bytes - done) < (size_t(1) << 30)) ? bytes - done : (size_t(1) << 30);
+#if defined(_WIN32)
+		long long got = _read(fd, cursor + done, static_cast<unsigned>(chunk));
+#else
+		long long got = ::read(fd, cursor + done, chunk);
+#endif
+		if (got < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::system_error(errno, std::generic_category(), "readBinary");
+		}
+		if (got == 0) {
+			break;
+		}
+		done += static_cast<size_t>(got);
+	}
+	return done;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void writeBinary(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq) {
+	if constexpr (std::is_trivially_copyable_v<type>) {
+		SequenceBinary::Raw raw;
+		SequenceBinary::write(os, seq, raw);
+	}
+	else {
+		BinaryCodec<type> codec;
+		SequenceBinary::write(os, seq, codec);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void writeBinary(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec) {
+	SequenceBinary::write(os, seq, codec);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void readBinary(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	if constexpr (std::is_trivially_copyable_v<type>) {
+		SequenceBinary::Raw raw;
+		SequenceBinary::read(is, seq, raw);
+	}
+	else {
+		BinaryCodec<type> codec;
+		SequenceBinary::read(is, seq, codec);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void readBinary(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec) {
+	SequenceBinary::read(is, seq, codec);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void writeBinary(int fd, const Sequence<type, Alloc, GrowthPolicy>& seq) {
+	if constexpr (std::is_trivially_copyable_v<type>) {
+		SequenceBinary::Raw raw;
+		SequenceBinary::write(fd, seq, raw);
+	}
+	else {
+		BinaryCodec<type> codec;
+		SequenceBinary::write(fd, seq, codec);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void writeBinary(int fd, const Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec) {
+	SequenceBinary::write(fd, seq, codec);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void readBinary(int fd, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	if constexpr (std::is_trivially_copyable_v<type>) {
+		SequenceBinary::Raw raw;
+		SequenceBinary::read(fd, seq, raw);
+	}
+	else {
+		BinaryCodec<type> codec;
+		SequenceBinary::read(fd, seq, codec);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Codec>
+void readBinary(int fd, Sequence<type, Alloc, GrowthPolicy>& seq, Codec codec) {
+	SequenceBinary::read(fd, seq, codec);
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef SEQUENCE_FORMAT_ERROR_H
+#define SEQUENCE_FORMAT_ERROR_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// Malformed serialized or textual sequence data; the position is the byte offset at which the problem was found.
+class SequenceFormatError : public std::runtime_error {
+public:
+	SequenceFormatError(const std::string& message, size_t position);
+
+	[[nodiscard]] size_t getPosition() const noexcept;
+
+private:
+	size_t position;
+};
+
+
+inline SequenceFormatError::SequenceFormatError(const std::string& message, size_t position)
+	: std::runtime_error(message + " at byte " + std::to_string(position)), position(position) {}
+
+inline size_t SequenceFormatError::getPosition() const noexcept {
+	return position;
+}
+
+#endif
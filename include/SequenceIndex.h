@@ -0,0 +1,323 @@
+#ifndef SEQUENCE_INDEX_H
+#define SEQUENCE_INDEX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Hash index behind Sequence::enableIndex. Every distinct value has one slot holding how many times it occurs and
+// its first and last position, so find, findLast, contains and containsLotsOf are single lookups.
+// The table uses linear probing with backward shift deletion, so it never fills up with tombstones.
+// Positions are stored relative to an origin that moves with the front of the sequence,
+// which keeps push_front and pop_front O(1); inserting or removing in the middle shifts the stored positions.
+// None of the updates throw: when the table cannot grow it turns stale and the next refresh rebuilds it.
+// refresh may run from several const lookups at once: the rebuild happens under a mutex and the others read the table
+// only once the stale flag is cleared. The updates come from mutating calls and are not synchronized.
+template <class type>
+class SequenceIndex {
+public:
+	static constexpr bool isSupported = std::is_default_constructible_v<std::hash<type>>
+		&& std::is_default_constructible_v<type> && std::is_copy_assignable_v<type>;
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	void clear() noexcept;
+	void invalidate() noexcept;
+	// rebuilds a stale index from the elements; false when that failed and the caller has to scan
+	[[nodiscard]] bool refresh(const type* first, size_t size) noexcept;
+
+	// count elements were just inserted at index, size includes them
+	void inserted(const type* first, size_t size, size_t index, size_t count) noexcept;
+	// the element at index is about to be removed, size still includes it
+	void erasing(const type* first, size_t size, size_t index) noexcept;
+	// the element at index is about to be assigned, remember() takes the new value afterwards
+	void forget(const type* first, size_t size, size_t index) noexcept;
+	void remember(const type& value, size_t index) noexcept;
+
+	[[nodiscard]] size_t count(const type& value) const noexcept;
+	// npos when the value is absent
+	[[nodiscard]] size_t first(const type& value) const noexcept;
+	[[nodiscard]] size_t last(const type& value) const noexcept;
+	[[nodiscard]] size_t sizeInBytes() const noexcept;
+
+private:
+	struct Slot {
+		type value = type();
+		size_t hash = 0;
+		size_t count = 0;//0 for a free slot
+		long long first = 0;
+		long long last = 0;
+	};
+
+	std::vector<Slot> slots;
+	size_t used = 0;
+	long long origin = 0;//stored position of index 0
+	std::atomic<bool> stale = false;
+	std::mutex rebuilding;
+
+	[[nodiscard]] static size_t hashOf(const type& value) noexcept;
+	[[nodiscard]] size_t mask() const noexcept;
+	[[nodiscard]] bool isStale() const noexcept;
+	void reset() noexcept;
+	[[nodiscard]] const Slot* lookup(const type& value) const noexcept;
+	void add(const type& value, long long position);
+	void grow();
+	void eraseSlot(size_t position) noexcept;
+	void shiftFrom(long long position, long long delta) noexcept;
+};
+
+
+// std::hash of integers is often the identity, mixing spreads runs of keys over the table
+template <class type>
+inline size_t SequenceIndex<type>::hashOf(const type& value) noexcept {
+	uint64_t hash = static_cast<uint64_t>(std::hash<type>()(value));
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return static_cast<size_t>(hash);
+}
+
+template <class type>
+inline size_t SequenceIndex<type>::mask() const noexcept {
+	return slots.size() - 1;
+}
+
+template <class type>
+inline bool SequenceIndex<type>::isStale() const noexcept {
+	return stale.load(std::memory_order_relaxed);
+}
+
+template <class type>
+void SequenceIndex<type>::reset() noexcept {
+	for (Slot& slot : slots) {
+		if (slot.count != 0) {
+			slot = Slot();
+		}
+	}
+	used = 0;
+	origin = 0;
+}
+
+template <class type>
+void SequenceIndex<type>::clear() noexcept {
+	reset();
+	stale.store(false, std::memory_order_relaxed);
+}
+
+template <class type>
+inline void SequenceIndex<type>::invalidate() noexcept {
+	stale.store(true, std::memory_order_relaxed);
+}
+
+// the acquire load pairs with the release store of the thread that rebuilt the table
+template <class type>
+bool SequenceIndex<type>::refresh(const type* first, size_t size) noexcept {
+	if (!stale.load(std::memory_order_acquire)) {
+		return true;
+	}
+	try {
+		std::lock_guard<std::mutex> lock(rebuilding);
+		if (!stale.load(std::memory_order_relaxed)) {
+			return true;
+		}
+		reset();
+		for (size_t i = 0; i < size; i++) {
+			add(first[i], static_cast<long long>(i));
+		}
+		stale.store(false, std::memory_order_release);
+		return true;
+	}
+	catch (...) {
+		return false;
+	}
+}
+
+template <class type>
+const typename SequenceIndex<type>::Slot* SequenceIndex<type>::lookup(const type& value) const noexcept {
+	if (used == 0) {
+		return nullptr;
+	}
+	size_t hash = hashOf(value);
+	for (size_t position = hash & mask(); slots[position].count != 0; position = (position + 1) & mask()) {
+		if (slots[position].hash == hash && slots[position].value == value) {
+			return &slots[position];
+		}
+	}
+	return nullptr;
+}
+
+// the table stays at most half full
+template <class type>
+void SequenceIndex<type>::add(const type& value, long long position) {
+	if ((used + 1) * 2 > slots.size()) {
+		grow();
+	}
+	size_t hash = hashOf(value);
+	size_t place = hash & mask();
+	for (; slots[place].count != 0; place = (place + 1) & mask()) {
+		Slot& slot = slots[place];
+		if (slot.hash == hash && slot.value == value) {
+			slot.count++;
+			slot.first = (position < slot.first) ? position : slot.first;
+			slot.last = (position > slot.last) ? position : slot.last;
+			return;
+		}
+	}
+	slots[place].value = value;
+	slots[place].hash = hash;
+	slots[place].count = 1;
+	slots[place].first = slots[place].last = position;
+	used++;
+}
+
+template <class type>
+void SequenceIndex<type>::grow() {
+	std::vector<Slot> bigger((slots.size() < 16) ? 32 : slots.size() * 2);
+	size_t biggerMask = bigger.size() - 1;
+	for (Slot& slot : slots) {
+		if (slot.count != 0) {
+			size_t place = slot.hash & biggerMask;
+			while (bigger[place].count != 0) {
+				place = (place + 1) & biggerMask;
+			}
+			bigger[place] = std::move(slot);
+		}
+	}
+	slots.swap(bigger);
+}
+
+// pulls later slots of the probe run back into the hole, so lookups never stop early
+template <class type>
+void SequenceIndex<type>::eraseSlot(size_t hole) noexcept {
+	for (size_t next = (hole + 1) & mask(); slots[next].count != 0; next = (next + 1) & mask()) {
+		size_t home = slots[next].hash & mask();
+		if (((next - home) & mask()) >= ((next - hole) & mask())) {
+			slots[hole] = std::move(slots[next]);
+			hole = next;
+		}
+	}
+	slots[hole] = Slot();
+	used--;
+}
+
+template <class type>
+void SequenceIndex<type>::shiftFrom(long long position, long long delta) noexcept {
+	for (Slot& slot : slots) {
+		if (slot.count != 0) {
+			slot.first += (slot.first >= position) ? delta : 0;
+			slot.last += (slot.last >= position) ? delta : 0;
+		}
+	}
+}
+
+template <class type>
+void SequenceIndex<type>::inserted(const type* first, size_t size, size_t index, size_t count) noexcept {
+	if (isStale() || count == 0) {
+		return;
+	}
+	if (index == 0 && count < size) {
+		origin -= static_cast<long long>(count);
+	}
+	else if (index + count < size) {
+		shiftFrom(origin + static_cast<long long>(index), static_cast<long long>(count));
+	}
+	try {
+		for (size_t i = index; i < index + count; i++) {
+			add(first[i], origin + static_cast<long long>(i));
+		}
+	}
+	catch (...) {
+		invalidate();
+	}
+}
+
+template <class type>
+void SequenceIndex<type>::erasing(const type* first, size_t size, size_t index) noexcept {
+	if (isStale()) {
+		return;
+	}
+	forget(first, size, index);
+	if (index == 0) {
+		origin++;
+	}
+	else if (index + 1 < size) {
+		shiftFrom(origin + static_cast<long long>(index) + 1, -1);
+	}
+}
+
+// when the forgotten element was the first or last occurrence, the next one is found by scanning from it
+template <class type>
+void SequenceIndex<type>::forget(const type* first, size_t size, size_t index) noexcept {
+	if (isStale()) {
+		return;
+	}
+	const Slot* found = lookup(first[index]);
+	if (found == nullptr) {
+		invalidate();
+		return;
+	}
+	Slot& slot = slots[static_cast<size_t>(found - slots.data())];
+	if (--slot.count == 0) {
+		eraseSlot(static_cast<size_t>(found - slots.data()));
+		return;
+	}
+	long long position = origin + static_cast<long long>(index);
+	if (slot.first == position) {
+		size_t next = index + 1;
+		while (next < size && !(first[next] == slot.value)) {
+			next++;
+		}
+		slot.first = origin + static_cast<long long>(next);
+	}
+	if (slot.last == position) {
+		size_t previous = index - 1;
+		while (!(first[previous] == slot.value)) {
+			previous--;
+		}
+		slot.last = origin + static_cast<long long>(previous);
+	}
+}
+
+template <class type>
+void SequenceIndex<type>::remember(const type& value, size_t index) noexcept {
+	if (isStale()) {
+		return;
+	}
+	try {
+		add(value, origin + static_cast<long long>(index));
+	}
+	catch (...) {
+		invalidate();
+	}
+}
+
+template <class type>
+inline size_t SequenceIndex<type>::count(const type& value) const noexcept {
+	const Slot* slot = lookup(value);
+	return (slot == nullptr) ? 0 : slot->count;
+}
+
+template <class type>
+inline size_t SequenceIndex<type>::first(const type& value) const noexcept {
+	const Slot* slot = lookup(value);
+	return (slot == nullptr) ? npos : static_cast<size_t>(slot->first - origin);
+}
+
+template <class type>
+inline size_t SequenceIndex<type>::last(const type& value) const noexcept {
+	const Slot* slot = lookup(value);
+	return (slot == nullptr) ? npos : static_cast<size_t>(slot->last - origin);
+}
+
+template <class type>
+inline size_t SequenceIndex<type>::sizeInBytes() const noexcept {
+	return sizeof(*this) + slots.capacity() * sizeof(Slot);
+}
+
+#endif
@@ -0,0 +1,555 @@
+#ifndef SEQUENCE_QUEUE_H
+#define SEQUENCE_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Relocation.h"
+#include "Sequence.h"
+
+// Bounded lock-free hand-off queues. The slots are one allocation from Alloc, elements are built in them with
+// allocator_traits and moved out with Relocation, as in Sequence; tryPopN can append straight to a Sequence.
+// Positions only grow and the capacity is a power of two, so a position's slot is position & mask.
+// None of the operations block: tryPush fails on a full queue and tryPop on an empty one.
+
+// the producer's and the consumer's counters go on separate lines of this size, so neither invalidates the other's
+inline constexpr size_t queueCacheLine = 64;
+
+template <class type, class Alloc>
+class QueueStorage {
+protected:
+	using AllocTraits = std::allocator_traits<Alloc>;
+
+	SEQUENCE_NO_UNIQUE_ADDRESS Alloc allocator;
+	size_t capacity;
+	size_t mask;
+	type* slots;
+
+	// capacity is rounded up to a power of two of at least 2
+	QueueStorage(size_t requestedCapacity, const Alloc& allocator);
+	QueueStorage(const QueueStorage&) = delete;
+	QueueStorage& operator=(const QueueStorage&) = delete;
+	~QueueStorage() noexcept;
+
+	[[nodiscard]] type* slotAt(size_t position) const noexcept;
+	// copies count values into the raw slots from position on, across the wrap; on an exception none stay constructed
+	void copyIn(const type* values, size_t position, size_t count);
+	// room for count elements at the back of seq, published by appended()
+	template <class SeqAlloc, class GrowthPolicy>
+	[[nodiscard]] static type* openBack(Sequence<type, SeqAlloc, GrowthPolicy>& seq, size_t count);
+	template <class SeqAlloc, class GrowthPolicy>
+	static void appended(Sequence<type, SeqAlloc, GrowthPolicy>& seq, size_t count) noexcept;
+};
+
+// Single producer, single consumer ring. Each side owns one counter and keeps a cached copy of the other's,
+// which it reloads only when the ring looks full (producer) or empty (consumer).
+template <class type, class Alloc = std::allocator<type>>
+class SpscQueue : private QueueStorage<type, Alloc> {
+public:
+	using value_type = type;
+	using allocator_type = Alloc;
+
+	explicit SpscQueue(size_t capacity, const Alloc& allocator = Alloc());
+	~SpscQueue() noexcept;
+
+	[[nodiscard]] size_t getCapacity() const noexcept;
+	// exact only while neither side is running
+	[[nodiscard]] size_t getSize() const noexcept;
+	[[nodiscard]] bool isEmpty() const noexcept;
+
+	// producer thread
+	bool tryPush(const type& value);
+	bool tryPush(type&& value);
+	template <class... Args>
+	bool tryEmplace(Args&&... args);
+	// pushes as many of the values as fit and returns how many
+	size_t tryPushN(const type* values, size_t count);
+
+	// consumer thread
+	bool tryPop(type& out);
+	// move-assigns up to maxCount elements to out and returns how many
+	size_t tryPopN(type* out, size_t maxCount);
+	// appends up to maxCount elements to the back of out
+	template <class SeqAlloc, class GrowthPolicy>
+	size_t tryPopN(Sequence<type, SeqAlloc, GrowthPolicy>& out, size_t maxCount);
+
+private:
+	using Storage = QueueStorage<type, Alloc>;
+
+	alignas(queueCacheLine) std::atomic<size_t> tail{ 0 };
+	size_t cachedHead = 0;
+	alignas(queueCacheLine) std::atomic<size_t> head{ 0 };
+	size_t cachedTail = 0;
+
+	template <class Construct>
+	bool pushWith(Construct construct);
+	[[nodiscard]] size_t readable(size_t position, size_t wanted) noexcept;
+};
+
+// Multi producer, multi consumer queue with a turn number per slot (Vyukov's bounded queue): the slot of position p is
+// free for the producer of p when its turn is p and full for the consumer of p when its turn is p + 1.
+// A batch claims consecutive positions with one compare-exchange on the counter.
+// A claimed slot must be filled or emptied whatever happens, so moves must not throw; copies are made before claiming.
+template <class type, class Alloc = std::allocator<type>>
+class MpmcQueue : private QueueStorage<type, Alloc> {
+	static_assert(std::is_nothrow_move_constructible_v<type> && std::is_nothrow_move_assignable_v<type>,
+		"MpmcQueue: elements must be nothrow movable");
+public:
+	using value_type = type;
+	using allocator_type = Alloc;
+
+	explicit MpmcQueue(size_t capacity, const Alloc& allocator = Alloc());
+	~MpmcQueue() noexcept;
+
+	[[nodiscard]] size_t getCapacity() const noexcept;
+	// exact only while no thread is running
+	[[nodiscard]] size_t getSize() const noexcept;
+	[[nodiscard]] bool isEmpty() const noexcept;
+
+	bool tryPush(const type& value);
+	bool tryPush(type&& value);
+	template <class... Args>
+	bool tryEmplace(Args&&... args);
+	size_t tryPushN(const type* values, size_t count);
+
+	bool tryPop(type& out);
+	size_t tryPopN(type* out, size_t maxCount);
+	template <class SeqAlloc, class GrowthPolicy>
+	size_t tryPopN(Sequence<type, SeqAlloc, GrowthPolicy>& out, size_t maxCount);
+
+private:
+	using Storage = QueueStorage<type, Alloc>;
+	using TurnAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::atomic<size_t>>;
+	using TurnTraits = std::allocator_traits<TurnAlloc>;
+
+	std::atomic<size_t>* turns;
+	alignas(queueCacheLine) std::atomic<size_t> tail{ 0 };
+	alignas(queueCacheLine) std::atomic<size_t> head{ 0 };
+
+	// claims up to count consecutive positions whose turn is position + offset (0 for producers, 1 for consumers),
+	// first is set to the first of them; 0 when the queue is full (producers) or empty (consumers)
+	[[nodiscard]] size_t claim(std::atomic<size_t>& counter, size_t count, size_t offset, size_t& first) noexcept;
+	void filled(size_t position) noexcept;
+	void emptied(size_t position) noexcept;
+};
+
+
+template <class type, class Alloc>
+QueueStorage<type, Alloc>::QueueStorage(size_t requestedCapacity, const Alloc& allocator) : allocator(allocator) {
+	if (requestedCapacity == 0) {
+		throw std::invalid_argument("Queue capacity cannot be 0");
+	}
+	capacity = 2;
+	while (capacity < requestedCapacity) {
+		if (capacity > AllocTraits::max_size(this->allocator) / 2) {
+			throw std::bad_array_new_length();
+		}
+		capacity *= 2;
+	}
+	mask = capacity - 1;
+	slots = AllocTraits::allocate(this->allocator, capacity);
+}
+
+template <class type, class Alloc>
+QueueStorage<type, Alloc>::~QueueStorage() noexcept {
+	AllocTraits::deallocate(allocator, slots, capacity);
+}
+
+template <class type, class Alloc>
+inline type* QueueStorage<type, Alloc>::slotAt(size_t position) const noexcept {
+	return slots + (position & mask);
+}
+
+template <class type, class Alloc>
+void QueueStorage<type, Alloc>::copyIn(const type* values, size_t position, size_t count) {
+	size_t offset = position & mask;
+	size_t firstRun = (count < capacity - offset) ? count : capacity - offset;
+	Relocation<type>::copy(allocator, values, firstRun, slots + offset);
+	try {
+		Relocation<type>::copy(allocator, values + firstRun, count - firstRun, slots);
+	}
+	catch (...) {
+		std::destroy_n(slots + offset, firstRun);
+		throw;
+	}
+}
+
+template <class type, class Alloc>
+template <class SeqAlloc, class GrowthPolicy>
+inline type* QueueStorage<type, Alloc>::openBack(Sequence<type, SeqAlloc, GrowthPolicy>& seq, size_t count) {
+	seq.openGapAt(seq.size, count);
+	return seq.elements + seq.size;
+}
+
+template <class type, class Alloc>
+template <class SeqAlloc, class GrowthPolicy>
+inline void QueueStorage<type, Alloc>::appended(Sequence<type, SeqAlloc, GrowthPolicy>& seq, size_t count) noexcept {
+	seq.size += count;
+	seq.indexInserted(seq.size - count, count);
+}
+
+template <class type, class Alloc>
+SpscQueue<type, Alloc>::SpscQueue(size_t capacity, const Alloc& allocator) : Storage(capacity, allocator) {}
+
+template <class type, class Alloc>
+SpscQueue<type, Alloc>::~SpscQueue() noexcept {
+	size_t end = tail.load(std::memory_order_acquire);
+	for (size_t position = head.load(std::memory_order_acquire); position != end; position++) {
+		Storage::AllocTraits::destroy(this->allocator, this->slotAt(position));
+	}
+}
+
+template <class type, class Alloc>
+inline size_t SpscQueue<type, Alloc>::getCapacity() const noexcept {
+	return this->capacity;
+}
+
+template <class type, class Alloc>
+inline size_t SpscQueue<type, Alloc>::getSize() const noexcept {
+	size_t first = head.load(std::memory_order_acquire);
+	return tail.load(std::memory_order_acquire) - first;
+}
+
+template <class type, class Alloc>
+inline bool SpscQueue<type, Alloc>::isEmpty() const noexcept {
+	return getSize() == 0;
+}
+
+template <class type, class Alloc>
+template <class Construct>
+inline bool SpscQueue<type, Alloc>::pushWith(Construct construct) {
+	size_t position = tail.load(std::memory_order_relaxed);
+	if (position - cachedHead == this->capacity) {
+		cachedHead = head.load(std::memory_order_acquire);
+		if (position - cachedHead == this->capacity) {
+			return false;
+		}
+	}
+	construct(this->slotAt(position));
+	tail.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+template <class type, class Alloc>
+bool SpscQueue<type, Alloc>::tryPush(const type& value) {
+	return pushWith([&](type* slot) { Storage::AllocTraits::construct(this->allocator, slot, value); });
+}
+
+template <class type, class Alloc>
+bool SpscQueue<type, Alloc>::tryPush(type&& value) {
+	return pushWith([&](type* slot) { Storage::AllocTraits::construct(this->allocator, slot, std::move(value)); });
+}
+
+template <class type, class Alloc>
+template <class... Args>
+bool SpscQueue<type, Alloc>::tryEmplace(Args&&... args) {
+	return pushWith([&](type* slot) { Storage::AllocTraits::construct(this->allocator, slot, std::forward<Args>(args)...); });
+}
+
+template <class type, class Alloc>
+size_t SpscQueue<type, Alloc>::tryPushN(const type* values, size_t count) {
+	size_t position = tail.load(std::memory_order_relaxed);
+	if (this->capacity - (position - cachedHead) < count) {
+		cachedHead = head.load(std::memory_order_acquire);
+	}
+	size_t room = this->capacity - (position - cachedHead);
+	if (count > room) {
+		count = room;
+	}
+	if (count == 0) {
+		return 0;
+	}
+	this->copyIn(values, position, count);
+	tail.store(position + count, std::memory_order_release);
+	return count;
+}
+
+// how many of the wanted elements from position on the producer has published
+template <class type, class Alloc>
+inline size_t SpscQueue<type, Alloc>::readable(size_t position, size_t wanted) noexcept {
+	if (cachedTail - position < wanted) {
+		cachedTail = tail.load(std::memory_order_acquire);
+	}
+	size_t available = cachedTail - position;
+	return (wanted < available) ? wanted : available;
+}
+
+template <class type, class Alloc>
+bool SpscQueue<type, Alloc>::tryPop(type& out) {
+	size_t position = head.load(std::memory_order_relaxed);
+	if (readable(position, 1) == 0) {
+		return false;
+	}
+	type* slot = this->slotAt(position);
+	out = std::move(*slot);
+	Storage::AllocTraits::destroy(this->allocator, slot);
+	head.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+template <class type, class Alloc>
+size_t SpscQueue<type, Alloc>::tryPopN(type* out, size_t maxCount) {
+	size_t position = head.load(std::memory_order_relaxed);
+	size_t count = readable(position, maxCount);
+	size_t i = 0;
+	try {
+		for (; i < count; i++) {
+			type* slot = this->slotAt(position + i);
+			out[i] = std::move(*slot);
+			Storage::AllocTraits::destroy(this->allocator, slot);
+		}
+	}
+	catch (...) {
+		head.store(position + i, std::memory_order_release);
+		throw;
+	}
+	head.store(position + count, std::memory_order_release);
+	return count;
+}
+
+template <class type, class Alloc>
+template <class SeqAlloc, class GrowthPolicy>
+size_t SpscQueue<type, Alloc>::tryPopN(Sequence<type, SeqAlloc, GrowthPolicy>& out, size_t maxCount) {
+	size_t position = head.load(std::memory_order_relaxed);
+	size_t count = readable(position, maxCount);
+	if (count == 0) {
+		return 0;
+	}
+	if constexpr (Relocation<type>::isNothrow) {
+		type* destination = Storage::openBack(out, count);
+		size_t offset = position & this->mask;
+		size_t firstRun = (count < this->capacity - offset) ? count : this->capacity - offset;
+		Relocation<type>::relocate(this->slots + offset, firstRun, destination);
+		Relocation<type>::relocate(this->slots, count - firstRun, destination + firstRun);
+		Storage::appended(out, count);
+		head.store(position + count, std::memory_order_release);
+	}
+	else {
+		for (size_t i = 0; i < count; i++) {
+			type* slot = this->slotAt(position + i);
+			out.push_back(std::move(*slot));
+			Storage::AllocTraits::destroy(this->allocator, slot);
+			head.store(position + i + 1, std::memory_order_release);
+		}
+	}
+	return count;
+}
+
+template <class type, class Alloc>
+MpmcQueue<type, Alloc>::MpmcQueue(size_t capacity, const Alloc& allocator) : Storage(capacity, allocator) {
+	TurnAlloc turnAllocator(this->allocator);
+	turns = TurnTraits::allocate(turnAllocator, this->capacity);
+	for (size_t i = 0; i < this->capacity; i++) {
+		new (turns + i) std::atomic<size_t>(i);
+	}
+}
+
+template <class type, class Alloc>
+MpmcQueue<type, Alloc>::~MpmcQueue() noexcept {
+	size_t end = tail.load(std::memory_order_acquire);
+	for (size_t position = head.load(std::memory_order_acquire); position != end; position++) {
+		Storage::AllocTraits::destroy(this->allocator, this->slotAt(position));
+	}
+	TurnAlloc turnAllocator(this->allocator);
+	TurnTraits::deallocate(turnAllocator, turns, this->capacity);
+}
+
+template <class type, class Alloc>
+inline size_t MpmcQueue<type, Alloc>::getCapacity() const noexcept {
+	return this->capacity;
+}
+
+template <class type, class Alloc>
+inline size_t MpmcQueue<type, Alloc>::getSize() const noexcept {
+	size_t first = head.load(std::memory_order_acquire);
+	size_t size = tail.load(std::memory_order_acquire) - first;
+	return (size < this->capacity) ? size : this->capacity;
+}
+
+template <class type, class Alloc>
+inline bool MpmcQueue<type, Alloc>::isEmpty() const noexcept {
+	return getSize() == 0;
+}
+
+template <class type, class Alloc>
+size_t MpmcQueue<type, Alloc>::claim(std::atomic<size_t>& counter, size_t count, size_t offset, size_t& first) noexcept {
+	if (count > this->capacity) {
+		count = this->capacity;
+	}
+	if (count == 0) {
+		return 0;
+	}
+	size_t position = counter.load(std::memory_order_relaxed);
+	for (;;) {
+		size_t ready = 0;
+		while (ready < count && turns[(position + ready) & this->mask].load(std::memory_order_acquire) == position + ready + offset) {
+			ready++;
+		}
+		if (ready == 0) {
+			// a turn behind the position means the slot is still in use from the previous lap
+			std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(turns[position & this->mask].load(std::memory_order_acquire) - (position + offset));
+			if (lag < 0) {
+				return 0;
+			}
+			position = counter.load(std::memory_order_relaxed);
+			continue;
+		}
+		// no one else can change the turns checked above before taking their positions from the counter
+		if (counter.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+			first = position;
+			return ready;
+		}
+	}
+}
+
+template <class type, class Alloc>
+inline void MpmcQueue<type, Alloc>::filled(size_t position) noexcept {
+	turns[position & this->mask].store(position + 1, std::memory_order_release);
+}
+
+template <class type, class Alloc>
+inline void MpmcQueue<type, Alloc>::emptied(size_t position) noexcept {
+	turns[position & this->mask].store(position + this->capacity, std::memory_order_release);
+}
+
+template <class type, class Alloc>
+bool MpmcQueue<type, Alloc>::tryPush(type&& value) {
+	size_t position;
+	if (claim(tail, 1, 0, position) == 0) {
+		return false;
+	}
+	Storage::AllocTraits::construct(this->allocator, this->slotAt(position), std::move(value));
+	filled(position);
+	return true;
+}
+
+template <class type, class Alloc>
+bool MpmcQueue<type, Alloc>::tryPush(const type& value) {
+	if constexpr (std::is_nothrow_copy_constructible_v<type>) {
+		size_t position;
+		if (claim(tail, 1, 0, position) == 0) {
+			return false;
+		}
+		Storage::AllocTraits::construct(this->allocator, this->slotAt(position), value);
+		filled(position);
+		return true;
+	}
+	else {
+		type copy(value);
+		return tryPush(std::move(copy));
+	}
+}
+
+template <class type, class Alloc>
+template <class... Args>
+bool MpmcQueue<type, Alloc>::tryEmplace(Args&&... args) {
+	if constexpr (std::is_nothrow_constructible_v<type, Args&&...>) {
+		size_t position;
+		if (claim(tail, 1, 0, position) == 0) {
+			return false;
+		}
+		Storage::AllocTraits::construct(this->allocator, this->slotAt(position), std::forward<Args>(args)...);
+		filled(position);
+		return true;
+	}
+	else {
+		type value(std::forward<Args>(args)...);
+		return tryPush(std::move(value));
+	}
+}
+
+template <class type, class Alloc>
+size_t MpmcQueue<type, Alloc>::tryPushN(const type* values, size_t count) {
+	if constexpr (std::is_nothrow_copy_constructible_v<type>) {
+		size_t pushed = 0;
+		size_t position;
+		// a batch may come up short when a consumer is still emptying a slot in the middle of it
+		while (pushed < count) {
+			size_t claimed = claim(tail, count - pushed, 0, position);
+			if (claimed == 0) {
+				break;
+			}
+			for (size_t i = 0; i < claimed; i++) {
+				Storage::AllocTraits::construct(this->allocator, this->slotAt(position + i), values[pushed + i]);
+				filled(position + i);
+			}
+			pushed += claimed;
+		}
+		return pushed;
+	}
+	else {
+		size_t pushed = 0;
+		while (pushed < count && tryPush(values[pushed])) {
+			pushed++;
+		}
+		return pushed;
+	}
+}
+
+template <class type, class Alloc>
+bool MpmcQueue<type, Alloc>::tryPop(type& out) {
+	size_t position;
+	if (claim(head, 1, 1, position) == 0) {
+		return false;
+	}
+	type* slot = this->slotAt(position);
+	out = std::move(*slot);
+	Storage::AllocTraits::destroy(this->allocator, slot);
+	emptied(position);
+	return true;
+}
+
+template <class type, class Alloc>
+size_t MpmcQueue<type, Alloc>::tryPopN(type* out, size_t maxCount) {
+	size_t popped = 0;
+	size_t position;
+	while (popped < maxCount) {
+		size_t claimed = claim(head, maxCount - popped, 1, position);
+		if (claimed == 0) {
+			break;
+		}
+		for (size_t i = 0; i < claimed; i++) {
+			type* slot = this->slotAt(position + i);
+			out[popped + i] = std::move(*slot);
+			Storage::AllocTraits::destroy(this->allocator, slot);
+			emptied(position + i);
+		}
+		popped += claimed;
+	}
+	return popped;
+}
+
+// the room is opened before claiming, since nothing may throw once the slots are taken
+template <class type, class Alloc>
+template <class SeqAlloc, class GrowthPolicy>
+size_t MpmcQueue<type, Alloc>::tryPopN(Sequence<type, SeqAlloc, GrowthPolicy>& out, size_t maxCount) {
+	if (maxCount > this->capacity) {
+		maxCount = this->capacity;
+	}
+	if (maxCount == 0 || isEmpty()) {
+		return 0;
+	}
+	type* destination = Storage::openBack(out, maxCount);
+	size_t popped = 0;
+	size_t position;
+	while (popped < maxCount) {
+		size_t claimed = claim(head, maxCount - popped, 1, position);
+		if (claimed == 0) {
+			break;
+		}
+		for (size_t i = 0; i < claimed; i++) {
+			Relocation<type>::relocate(this->slotAt(position + i), 1, destination + popped + i);
+			emptied(position + i);
+		}
+		popped += claimed;
+	}
+	Storage::appended(out, popped);
+	return popped;
+}
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef SEQUENCE_SORT_H
+#define SEQUENCE_SORT_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Sorting kernels behind Sequence::sort. Comparison sorts use introsort: quicksort with a median of three,
+// heapsort once the recursion gets too deep, insertion sort for the short ranges left at the end.
+// Integral and floating point elements ordered by operator< go through an LSD radix sort instead.
+
+template <class type>
+struct SequenceSort {
+	// floating point keys follow their bit patterns, except that -0.0 and 0.0 share a key, as they compare equal;
+	// NaNs end up at either end depending on their sign
+	static constexpr bool hasRadix =
+		(std::is_integral_v<type> && !std::is_same_v<type, bool> && (sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4 || sizeof(type) == 8))
+		|| ((std::is_same_v<type, float> || std::is_same_v<type, double>) && std::numeric_limits<type>::is_iec559);
+	// below this many elements radix sort loses to insertion sort and introsort
+	static constexpr size_t radixThreshold = 256;
+
+	template <class Compare>
+	static void introsort(type* first, size_t count, Compare comp);
+	template <class Compare>
+	static void insertionSort(type* first, size_t count, Compare comp);
+	// stable; scratch has room for count elements
+	static void radixSort(type* first, size_t count, type* scratch) noexcept;
+	// the order radixSort produces
+	[[nodiscard]] static bool radixLess(type a, type b) noexcept;
+
+private:
+	using Key = std::conditional_t<sizeof(type) == 1, uint8_t,
+		std::conditional_t<sizeof(type) == 2, uint16_t,
+		std::conditional_t<sizeof(type) == 4, uint32_t, uint64_t>>>;
+
+	// unsigned key whose order is the order of the values
+	[[nodiscard]] static Key toKey(type value) noexcept;
+	template <class Compare>
+	static void introsortLoop(type* first, type* last, size_t depth, Compare& comp);
+	template <class Compare>
+	static void moveMedianToFirst(type* result, type* a, type* b, type* c, Compare& comp);
+};
+
+
+template <class type>
+template <class Compare>
+void SequenceSort<type>::introsort(type* first, size_t count, Compare comp) {
+	if (count < 2) {
+		return;
+	}
+	size_t depth = 2 * static_cast<size_t>(std::bit_width(count) - 1);
+	introsortLoop(first, first + count, depth, comp);
+	insertionSort(first, count, comp);
+}
+
+template <class type>
+template <class Compare>
+void SequenceSort<type>::insertionSort(type* first, size_t count, Compare comp) {
+	type* last = first + count;
+	for (type* i = first + 1; i < last; i++) {
+		type value(std::move(*i));
+		if (comp(value, *first)) {
+			std::move_backward(first, i, i + 1);
+			*first = std::move(value);
+			continue;
+		}
+		// *first is not greater, so the scan stops before running off the front
+		type* j = i;
+		while (comp(value, *(j - 1))) {
+			*j = std::move(*(j - 1));
+			j--;
+		}
+		*j = std::move(value);
+	}
+}
+
+// leaves ranges of up to 16 elements unsorted for the final insertion sort
+template <class type>
+template <class Compare>
+void SequenceSort<type>::introsortLoop(type* first, type* last, size_t depth, Compare& comp) {
+	while (last - first > 16) {
+		if (depth == 0) {
+			std::make_heap(first, last, comp);
+			std::sort_heap(first, last, comp);
+			return;
+		}
+		depth--;
+
+		// the median becomes the pivot, the other two act as sentinels for the unguarded scans
+		moveMedianToFirst(first, first + 1, first + (last - first) / 2, last - 1, comp);
+		type* low = first + 1;
+		type* high = last;
+		for (;;) {
+			while (comp(*low, *first)) {
+				low++;
+			}
+			high--;
+			while (comp(*first, *high)) {
+				high--;
+			}
+			if (!(low < high)) {
+				break;
+			}
+			std::iter_swap(low, high);
+			low++;
+		}
+
+		// recursing into the smaller side keeps the stack logarithmic
+		if (low - first < last - low) {
+			introsortLoop(first, low, depth, comp);
+			first = low;
+		}
+		else {
+			introsortLoop(low, last, depth, comp);
+			last = low;
+		}
+	}
+}
+
+template <class type>
+template <class Compare>
+void SequenceSort<type>::moveMedianToFirst(type* result, type* a, type* b, type* c, Compare& comp) {
+	if (comp(*a, *b)) {
+		if (comp(*b, *c)) {
+			std::iter_swap(result, b);
+		}
+		else if (comp(*a, *c)) {
+			std::iter_swap(result, c);
+		}
+		else {
+			std::iter_swap(result, a);
+		}
+	}
+	else if (comp(*a, *c)) {
+		std::iter_swap(result, a);
+	}
+	else if (comp(*b, *c)) {
+		std::iter_swap(result, c);
+	}
+	else {
+		std::iter_swap(result, b);
+	}
+}
+
+template <class type>
+inline typename SequenceSort<type>::Key SequenceSort<type>::toKey(type value) noexcept {
+	Key key;
+	std::memcpy(&key, &value, sizeof(type));
+	if constexpr (std::is_floating_point_v<type>) {
+		// negative values count down from the top, positive ones sit above them; -0.0 is read as 0.0
+		const Key sign = Key(1) << (sizeof(Key) * 8 - 1);
+		key = (key == sign) ? Key(0) : key;
+		return (key & sign) ? static_cast<Key>(~key) : static_cast<Key>(key | sign);
+	}
+	else if constexpr (std::is_signed_v<type>) {
+		return static_cast<Key>(key ^ (Key(1) << (sizeof(Key) * 8 - 1)));
+	}
+	else {
+		return key;
+	}
+}
+
+template <class type>
+inline bool SequenceSort<type>::radixLess(type a, type b) noexcept {
+	return toKey(a) < toKey(b);
+}
+
+// One byte per pass, so the 256 counters and write cursors stay in L1. All histograms come from a single read,
+// and passes where every key has the same byte are skipped.
+template <class type>
+void SequenceSort<type>::radixSort(type* first, size_t count, type* scratch) noexcept {
+	if (count < 2) {
+		return;
+	}
+	constexpr size_t passes = sizeof(Key);
+	size_t counts[passes][256] = {};
+	for (size_t i = 0; i < count; i++) {
+		Key key = toKey(first[i]);
+		for (size_t pass = 0; pass < passes; pass++) {
+			counts[pass][(key >> (pass * 8)) & 0xFF]++;
+		}
+	}
+
+	type* from = first;
+	type* to = scratch;
+	for (size_t pass = 0; pass < passes; pass++) {
+		size_t* digits = counts[pass];
+		if (digits[(toKey(from[0]) >> (pass * 8)) & 0xFF] == count) {
+			continue;
+		}
+		size_t offset = 0;
+		for (size_t digit = 0; digit < 256; digit++) {
+			size_t digitCount = digits[digit];
+			digits[digit] = offset;
+			offset += digitCount;
+		}
+		for (size_t i = 0; i < count; i++) {
+			to[digits[(toKey(from[i]) >> (pass * 8)) & 0xFF]++] = from[i];
+		}
+		std::swap(from, to);
+	}
+	if (from != first) {
+		std::memcpy(static_cast<void*>(first), from, count * sizeof(type));
+	}
+}
+
+#endif
@@ -0,0 +1,435 @@
+#ifndef SEQUENCE_TEXT_H
+#define SEQUENCE_TEXT_H
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <locale>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include "SequenceFormatError.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Text format of operator>>: the element count, then the elements, separated by whitespace.
+// Numbers are decoded with std::from_chars, which ignores the locale, and up to maxReserve elements of the count are reserved
+// before the first one, so a count larger than the input allocates no more than that before the input runs out.
+// Streams are scanned through their own buffer one token at a time, so nothing past the last element is consumed.
+// File descriptors are read in blocks of blockSize bytes; the bytes read past the last element are given back with lseek,
+// which works on files but not on pipes.
+// Errors throw SequenceFormatError with the byte offset from where reading started.
+// Writing renders into a per-thread block with std::to_chars and hands it to the stream in whole blocks, without flushing.
+// Numbers take that path while the stream formats them plainly (classic locale, no width, no showpos, decimal integers);
+// other elements and other stream settings go through the element's own operator<<.
+
+template <class type, class Alloc, class GrowthPolicy>
+class Sequence;
+
+// character types keep the istream meaning of reading one character
+template <class type>
+inline constexpr bool isTextNumber = (std::is_integral_v<type> && !std::is_same_v<type, bool> && !std::is_same_v<type, char>
+	&& !std::is_same_v<type, signed char> && !std::is_same_v<type, unsigned char> && !std::is_same_v<type, wchar_t>
+	&& !std::is_same_v<type, char8_t> && !std::is_same_v<type, char16_t> && !std::is_same_v<type, char32_t>)
+	|| std::is_floating_point_v<type>;
+
+// print(os, options) and operator<<: "Sequence (capacity = X, size = Y): " unless header is false, then each element
+// followed by the separator; past limit elements the rest is replaced by "..." and the separator. A newline ends the line.
+struct FormatOptions {
+	std::string_view separator = " ";
+	size_t limit = static_cast<size_t>(-1);
+	bool header = true;
+};
+
+class SequenceText {
+public:
+	static constexpr size_t blockSize = 1 << 16;
+	// longest number accepted, the file scanner keeps at least this much of the block ahead of the cursor
+	static constexpr size_t maxToken = 512;
+	// elements reserved ahead of reading them, larger counts grow the sequence as elements arrive
+	static constexpr size_t maxReserve = blockSize;
+
+	template <class type, class Alloc, class GrowthPolicy>
+	static void read(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq);
+	template <class type, class Alloc, class GrowthPolicy>
+	static void read(int fd, Sequence<type, Alloc, GrowthPolicy>& seq);
+	template <class type, class Alloc, class GrowthPolicy>
+	static void write(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq, const FormatOptions& options);
+
+private:
+	class StreamScanner;
+	class FileScanner;
+	class Writer;
+
+	[[nodiscard]] static bool isBlank(int c) noexcept;
+	// decodes the number at first, which must end at last or at a blank, and returns its end
+	template <class type>
+	static const char* parse(const char* first, const char* last, type& value, size_t position);
+	template <class type, class Alloc, class GrowthPolicy, class Scanner>
+	static void readWith(Scanner& scanner, Sequence<type, Alloc, GrowthPolicy>& seq);
+};
+
+// next(value) decodes the next whitespace-delimited number and returns false when the input ends first;
+// position() is the offset of that number, or of the end of the input
+class SequenceText::StreamScanner {
+public:
+	explicit StreamScanner(std::streambuf* buffer) noexcept : buffer(buffer) {}
+
+	template <class type>
+	[[nodiscard]] bool next(type& value);
+	[[nodiscard]] size_t position() const noexcept { return start; }
+	[[nodiscard]] bool reachedEnd() const noexcept { return ended; }
+
+private:
+	std::streambuf* buffer;
+	char token[maxToken];
+	size_t consumed = 0;
+	size_t start = 0;
+	bool ended = false;
+};
+
+class SequenceText::FileScanner {
+public:
+	explicit FileScanner(int fd);
+	FileScanner(const FileScanner&) = delete;
+	FileScanner& operator=(const FileScanner&) = delete;
+
+	template <class type>
+	[[nodiscard]] bool next(type& value);
+	[[nodiscard]] size_t position() const noexcept { return start; }
+	// seeks back over the bytes read but not scanned
+	void giveBack() noexcept;
+
+private:
+	int fd;
+	std::unique_ptr<char[]> block;
+	char* cursor;
+	char* stop;
+	size_t consumed = 0;
+	size_t start = 0;
+	bool ended = false;
+
+	// moves [cursor, stop) to the front of the block and reads after it until the block is full or the file ends
+	void refill();
+};
+
+class SequenceText::Writer {
+public:
+	explicit Writer(std::ostream& os);
+	Writer(const Writer&) = delete;
+	Writer& operator=(const Writer&) = delete;
+	~Writer() noexcept;
+
+	void append(std::string_view text);
+	template <class type>
+	void appendElement(const type& value);
+	void flush();
+
+private:
+	std::ostream& os;
+	char* block;
+	size_t used = 0;
+	bool plainNumbers;
+	std::chars_format floatFormat = std::chars_format::general;
+	int precision;
+
+	// one block per thread, reused by every write; a nested write (an element printing a sequence) starts after flush()
+	[[nodiscard]] static char* threadBlock();
+	template <class type>
+	[[nodiscard]] bool appendNumber(type value);
+};
+
+
+inline bool SequenceText::isBlank(int c) noexcept {
+	return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+template <class type>
+const char* SequenceText::parse(const char* first, const char* last, type& value, size_t position) {
+	const char* number = first;
+	// istream accepts an explicit plus sign, from_chars does not
+	if (last - number > 1 && *number == '+' && number[1] != '-' && number[1] != '+') {
+		number++;
+	}
+	std::from_chars_result result;
+	if constexpr (std::is_floating_point_v<type>) {
+		result = std::from_chars(number, last, value, std::chars_format::general);
+	}
+	else {
+		result = std::from_chars(number, last, value);
+	}
+	if (result.ec == std::errc() && (result.ptr == last || isBlank(static_cast<unsigned char>(*result.ptr)))) {
+		return result.ptr;
+	}
+	const char* end = first;
+	while (end < last && !isBlank(static_cast<unsigned char>(*end))) {
+		end++;
+	}
+	throw SequenceFormatError(std::string(result.ec == std::errc::result_out_of_range ? "Number out of range: " : "Invalid number: ")
+		+ std::string(first, end), position);
+}
+
+template <class type>
+bool SequenceText::StreamScanner::next(type& value) {
+	int c = buffer->sgetc();
+	while (c != std::char_traits<char>::eof() && isBlank(c)) {
+		consumed++;
+		c = buffer->snextc();
+	}
+	start = consumed;
+	size_t length = 0;
+	// sgetc and snextc only leave the streambuf's inline get area when it runs empty
+	while (c != std::char_traits<char>::eof() && !isBlank(c)) {
+		if (length == maxToken) {
+			throw SequenceFormatError("Token longer than " + std::to_string(maxToken) + " bytes", start);
+		}
+		token[length++] = static_cast<char>(c);
+		c = buffer->snextc();
+	}
+	consumed += length;
+	ended = c == std::char_traits<char>::eof();
+	if (length == 0) {
+		return false;
+	}
+	parse(token, token + length, value, start);
+	return true;
+}
+
+inline SequenceText::FileScanner::FileScanner(int fd) : fd(fd), block(new char[blockSize]), cursor(block.get()), stop(block.get()) {}
+
+inline void SequenceText::FileScanner::refill() {
+	size_t kept = static_cast<size_t>(stop - cursor);
+	consumed += static_cast<size_t>(cursor - block.get());
+	std::memmove(block.get(), cursor, kept);
+	cursor = block.get();
+	stop = block.get() + kept;
+	while (!ended && stop < block.get() + blockSize) {
+#if defined(_WIN32)
+		long long got = _read(fd, stop, static_cast<unsigned>(block.get() + blockSize - stop));
+#else
+		long long got = ::read(fd, stop, static_cast<size_t>(block.get() + blockSize - stop));
+#endif
+		if (got < 0 && errno == EINTR) {
+			continue;
+		}
+		if (got < 0) {
+			throw std::system_error(errno, std::generic_category(), "SequenceText: read");
+		}
+		if (got == 0) {
+			ended = true;
+		}
+		stop += got;
+	}
+}
+
+// from_chars runs on the block itself, which always holds a whole token: near its end the block is refilled first
+template <class type>
+bool SequenceText::FileScanner::next(type& value) {
+	for (;;) {
+		if (static_cast<size_t>(stop - cursor) < maxToken && !ended) {
+			refill();
+		}
+		while (cursor < stop && isBlank(static_cast<unsigned char>(*cursor))) {
+			cursor++;
+		}
+		if (cursor < stop || ended) {
+			break;
+		}
+	}
+	start = consumed + static_cast<size_t>(cursor - block.get());
+	if (cursor == stop) {
+		return false;
+	}
+	cursor = const_cast<char*>(parse(cursor, stop, value, start));
+	return true;
+}
+
+inline void SequenceText::FileScanner::giveBack() noexcept {
+	long long unread = static_cast<long long>(stop - cursor);
+	if (unread > 0) {
+#if defined(_WIN32)
+		_lseeki64(fd, -unread, SEEK_CUR);
+#else
+		::lseek(fd, static_cast<off_t>(-unread), SEEK_CUR);
+#endif
+	}
+}
+
+inline char* SequenceText::Writer::threadBlock() {
+	thread_local std::unique_ptr<char[]> block(new char[blockSize]);
+	return block.get();
+}
+
+inline SequenceText::Writer::Writer(std::ostream& os) : os(os), block(threadBlock()), precision(static_cast<int>(os.precision())) {
+	std::ios::fmtflags flags = os.flags();
+	std::ios::fmtflags floatField = flags & std::ios::floatfield;
+	plainNumbers = os.width() == 0 && (flags & (std::ios::showpos | std::ios::showpoint | std::ios::uppercase)) == 0
+		&& ((flags & std::ios::basefield) == std::ios::dec || (flags & std::ios::basefield) == 0)
+		&& floatField != (std::ios::fixed | std::ios::scientific) && os.getloc() == std::locale::classic();
+	if (floatField == std::ios::fixed) {
+		floatFormat = std::chars_format::fixed;
+	}
+	else if (floatField == std::ios::scientific) {
+		floatFormat = std::chars_format::scientific;
+	}
+}
+
+inline SequenceText::Writer::~Writer() noexcept {
+	try {
+		flush();
+	}
+	catch (...) {}
+}
+
+inline void SequenceText::Writer::flush() {
+	if (used > 0) {
+		os.write(block, static_cast<std::streamsize>(used));
+		used = 0;
+	}
+}
+
+inline void SequenceText::Writer::append(std::string_view text) {
+	if (text.size() > blockSize - used) {
+		flush();
+		if (text.size() > blockSize) {
+			os.write(text.data(), static_cast<std::streamsize>(text.size()));
+			return;
+		}
+	}
+	std::memcpy(block + used, text.data(), text.size());
+	used += text.size();
+}
+
+// false when the number does not fit in a whole block, which only a huge fixed precision does
+template <class type>
+bool SequenceText::Writer::appendNumber(type value) {
+	for (bool retried = false;; retried = true) {
+		std::to_chars_result result;
+		if constexpr (std::is_floating_point_v<type>) {
+			result = std::to_chars(block + used, block + blockSize, value, floatFormat, precision);
+		}
+		else {
+			result = std::to_chars(block + used, block + blockSize, value);
+		}
+		if (result.ec == std::errc()) {
+			used = static_cast<size_t>(result.ptr - block);
+			return true;
+		}
+		if (retried) {
+			return false;
+		}
+		flush();
+	}
+}
+
+template <class type>
+void SequenceText::Writer::appendElement(const type& value) {
+	if constexpr (isTextNumber<type>) {
+		if (plainNumbers && appendNumber(value)) {
+			return;
+		}
+	}
+	else if constexpr (std::is_convertible_v<const type&, std::string_view>) {
+		if (os.width() == 0) {
+			append(std::string_view(value));
+			return;
+		}
+	}
+	flush();
+	os << value;
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void SequenceText::write(std::ostream& os, const Sequence<type, Alloc, GrowthPolicy>& seq, const FormatOptions& options) {
+	Writer out(os);
+	if (options.header) {
+		out.append("Sequence (capacity = ");
+		out.appendElement(seq.getCapacity());
+		out.append(", size = ");
+		out.appendElement(seq.getSize());
+		out.append("): ");
+	}
+	size_t shown = (options.limit < seq.getSize()) ? options.limit : seq.getSize();
+	for (size_t i = 0; i < shown; i++) {
+		out.appendElement(seq[i]);
+		out.append(options.separator);
+	}
+	if (shown < seq.getSize()) {
+		out.append("...");
+		out.append(options.separator);
+	}
+	out.append("\n");
+	out.flush();
+}
+
+template <class type, class Alloc, class GrowthPolicy, class Scanner>
+void SequenceText::readWith(Scanner& scanner, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	static_assert(isTextNumber<type>, "SequenceText: elements must be integers or floating point numbers");
+	size_t count = 0;
+	if (!scanner.next(count)) {
+		throw SequenceFormatError("Missing element count", scanner.position());
+	}
+	seq.clear();
+	seq.reserve((count < maxReserve) ? count : maxReserve);
+	for (size_t i = 0; i < count; i++) {
+		type value{};
+		if (!scanner.next(value)) {
+			throw SequenceFormatError("Missing element " + std::to_string(i) + " of " + std::to_string(count), scanner.position());
+		}
+		seq.push_back(value);
+	}
+}
+
+// on an error the stream gets failbit, and eofbit when the input ran out, before the exception is thrown
+template <class type, class Alloc, class GrowthPolicy>
+void SequenceText::read(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	std::istream::sentry sentry(is);
+	if (!sentry) {
+		throw SequenceFormatError("Missing element count", 0);
+	}
+	StreamScanner scanner(is.rdbuf());
+	try {
+		readWith(scanner, seq);
+	}
+	catch (const SequenceFormatError&) {
+		is.setstate(scanner.reachedEnd() ? (std::ios::failbit | std::ios::eofbit) : std::ios::failbit);
+		throw;
+	}
+	if (scanner.reachedEnd()) {
+		is.setstate(std::ios::eofbit);
+	}
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void SequenceText::read(int fd, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	FileScanner scanner(fd);
+	try {
+		readWith(scanner, seq);
+	}
+	catch (const SequenceFormatError&) {
+		scanner.giveBack();
+		throw;
+	}
+	scanner.giveBack();
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void readText(std::istream& is, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	SequenceText::read(is, seq);
+}
+
+template <class type, class Alloc, class GrowthPolicy>
+void readText(int fd, Sequence<type, Alloc, GrowthPolicy>& seq) {
+	SequenceText::read(fd, seq);
+}
+
+#endif
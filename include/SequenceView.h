@@ -0,0 +1,338 @@
+#ifndef SEQUENCE_VIEW_H
+#define SEQUENCE_VIEW_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include "LazyView.h"
+#include "SimdSearch.h"
+
+template <class type>
+class ChunkedView;
+
+// Read-only window into a Sequence (or any contiguous elements): a pointer and a length, cheap to copy and pass by value.
+// It does not own the elements, so it is valid only while the sequence is alive and is not reallocated or shifted.
+// It is also the source of the lazy adaptors, filtered and mapped come from LazyView.
+template <class type>
+class SequenceView : public LazyView<SequenceView<type>> {
+private:
+	const type* elements = nullptr;
+	size_t size = 0;
+public:
+	using value_type = type;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using const_reference = const type&;
+	using const_pointer = const type*;
+	using const_iterator = const type*;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using iterator = const_iterator;
+	using reverse_iterator = const_reverse_iterator;
+	static constexpr bool isSized = true;
+
+	struct Cursor {
+		using value_type = type;
+
+		const type* at = nullptr;
+		const type* stop = nullptr;
+
+		[[nodiscard]] bool done() const noexcept { return at == stop; }
+		[[nodiscard]] const type& get() const noexcept { return *at; }
+		void next() noexcept { at++; }
+	};
+
+	constexpr SequenceView() noexcept = default;
+	constexpr SequenceView(const type* elems, size_t size) noexcept;
+	constexpr SequenceView(std::span<const type> span) noexcept;
+
+	[[nodiscard]] size_t getSize() const noexcept;
+	[[nodiscard]] bool isEmpty() const noexcept;
+	[[nodiscard]] size_t find(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] size_t findFirst(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] size_t findLast(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] bool contains(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] size_t containsLotsOf(const type&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+
+	// narrower windows of the same elements, [from, to) like Sequence::slice
+	[[nodiscard]] SequenceView slice(size_t from, size_t to) const;
+	[[nodiscard]] SequenceView first(size_t count) const;
+	[[nodiscard]] SequenceView last(size_t count) const;
+	// like first and drop the first count elements, but clamped instead of throwing
+	[[nodiscard]] SequenceView take(size_t count) const noexcept;
+	[[nodiscard]] SequenceView drop(size_t count) const noexcept;
+	// consecutive windows of chunkSize elements, the last one may be shorter
+	[[nodiscard]] ChunkedView<type> chunked(size_t chunkSize) const;
+	[[nodiscard]] Cursor cursor() const noexcept;
+	[[nodiscard]] size_t knownSize() const noexcept;
+
+	[[nodiscard]] const type& front() const;
+	[[nodiscard]] const type& back() const;
+	[[nodiscard]] const type& at(size_t) const;
+	[[nodiscard]] const type& operator[] (size_t) const noexcept;
+	[[nodiscard]] const type* data() const noexcept;
+	[[nodiscard]] const_iterator begin() const noexcept;
+	[[nodiscard]] const_iterator end() const noexcept;
+	[[nodiscard]] const_iterator cbegin() const noexcept;
+	[[nodiscard]] const_iterator cend() const noexcept;
+	[[nodiscard]] const_reverse_iterator rbegin() const noexcept;
+	[[nodiscard]] const_reverse_iterator rend() const noexcept;
+
+	[[nodiscard]] operator std::span<const type>() const noexcept;
+	[[nodiscard]] bool operator==(const SequenceView&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+	[[nodiscard]] bool operator!=(const SequenceView&) const noexcept(noexcept(std::declval<type>() == std::declval<type>()));
+};
+
+template <class type>
+class ChunkedView : public LazyView<ChunkedView<type>> {
+private:
+	SequenceView<type> source;
+	size_t chunkSize;
+public:
+	using value_type = SequenceView<type>;
+	static constexpr bool isSized = true;
+
+	struct Cursor {
+		using value_type = SequenceView<type>;
+
+		SequenceView<type> rest;
+		size_t chunkSize = 1;
+
+		[[nodiscard]] bool done() const noexcept { return rest.isEmpty(); }
+		[[nodiscard]] SequenceView<type> get() const noexcept { return rest.take(chunkSize); }
+		void next() noexcept { rest = rest.drop(chunkSize); }
+	};
+
+	// throws std::invalid_argument when chunkSize is 0
+	ChunkedView(SequenceView<type> source, size_t chunkSize);
+	[[nodiscard]] Cursor cursor() const noexcept;
+	[[nodiscard]] size_t knownSize() const noexcept;
+};
+
+// the view does not own what it points to, so views of temporaries may outlive the full expression
+template <class type>
+inline constexpr bool std::ranges::enable_borrowed_range<SequenceView<type>> = true;
+
+
+template <class type>
+constexpr SequenceView<type>::SequenceView(const type* elems, size_t size) noexcept : elements(elems), size(size) {}
+
+template <class type>
+constexpr SequenceView<type>::SequenceView(std::span<const type> span) noexcept : elements(span.data()), size(span.size()) {}
+
+template <class type>
+inline size_t SequenceView<type>::getSize() const noexcept {
+	return size;
+}
+
+template <class type>
+inline bool SequenceView<type>::isEmpty() const noexcept {
+	return size == 0;
+}
+
+template <class type>
+size_t SequenceView<type>::find(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	if constexpr (SimdSearch<type>::isSupported) {
+		return SimdSearch<type>::find(elements, size, value);
+	}
+	for (size_t i = 0; i < size; i++) {
+		if (elements[i] == value) {
+			return i;
+		}
+	}
+	return size;
+}
+
+template <class type>
+inline size_t SequenceView<type>::findFirst(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return find(value);
+}
+
+template <class type>
+size_t SequenceView<type>::findLast(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	if constexpr (SimdSearch<type>::isSupported) {
+		return SimdSearch<type>::findLast(elements, size, value);
+	}
+	for (size_t i = size; i-- > 0;) {
+		if (elements[i] == value) {
+			return i;
+		}
+	}
+	return size;
+}
+
+template <class type>
+inline bool SequenceView<type>::contains(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return find(value) != size;
+}
+
+template <class type>
+size_t SequenceView<type>::containsLotsOf(const type& value) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	if constexpr (SimdSearch<type>::isSupported) {
+		return SimdSearch<type>::count(elements, size, value);
+	}
+	size_t counter = 0;
+	for (size_t i = 0; i < size; i++) {
+		if (elements[i] == value) {
+			counter++;
+		}
+	}
+	return counter;
+}
+
+template <class type>
+SequenceView<type> SequenceView<type>::slice(size_t from, size_t to) const {
+	if (from > to || to > size) {
+		throw std::out_of_range("Index out of range");
+	}
+	return SequenceView(elements + from, to - from);
+}
+
+template <class type>
+inline SequenceView<type> SequenceView<type>::first(size_t count) const {
+	return slice(0, count);
+}
+
+template <class type>
+SequenceView<type> SequenceView<type>::last(size_t count) const {
+	if (count > size) {
+		throw std::out_of_range("Index out of range");
+	}
+	return SequenceView(elements + size - count, count);
+}
+
+template <class type>
+inline SequenceView<type> SequenceView<type>::take(size_t count) const noexcept {
+	return SequenceView(elements, (count < size) ? count : size);
+}
+
+template <class type>
+inline SequenceView<type> SequenceView<type>::drop(size_t count) const noexcept {
+	return (count < size) ? SequenceView(elements + count, size - count) : SequenceView(elements + size, 0);
+}
+
+template <class type>
+inline ChunkedView<type> SequenceView<type>::chunked(size_t chunkSize) const {
+	return ChunkedView<type>(*this, chunkSize);
+}
+
+template <class type>
+inline typename SequenceView<type>::Cursor SequenceView<type>::cursor() const noexcept {
+	return Cursor{ elements, elements + size };
+}
+
+template <class type>
+inline size_t SequenceView<type>::knownSize() const noexcept {
+	return size;
+}
+
+template <class type>
+inline const type& SequenceView<type>::front() const {
+	if (isEmpty()) {
+		throw std::out_of_range("Cannot call front() on an empty SequenceView");
+	}
+	return elements[0];
+}
+
+template <class type>
+inline const type& SequenceView<type>::back() const {
+	if (isEmpty()) {
+		throw std::out_of_range("Cannot call back() on an empty SequenceView");
+	}
+	return elements[size - 1];
+}
+
+template <class type>
+inline const type& SequenceView<type>::at(size_t index) const {
+	if (index >= size) {
+		throw std::out_of_range("Index out of range");
+	}
+	return elements[index];
+}
+
+template <class type>
+inline const type& SequenceView<type>::operator[](size_t index) const noexcept {
+	return elements[index];
+}
+
+template <class type>
+inline const type* SequenceView<type>::data() const noexcept {
+	return elements;
+}
+
+template <class type>
+inline typename SequenceView<type>::const_iterator SequenceView<type>::begin() const noexcept {
+	return elements;
+}
+
+template <class type>
+inline typename SequenceView<type>::const_iterator SequenceView<type>::end() const noexcept {
+	return elements + size;
+}
+
+template <class type>
+inline typename SequenceView<type>::const_iterator SequenceView<type>::cbegin() const noexcept {
+	return elements;
+}
+
+template <class type>
+inline typename SequenceView<type>::const_iterator SequenceView<type>::cend() const noexcept {
+	return elements + size;
+}
+
+template <class type>
+inline typename SequenceView<type>::const_reverse_iterator SequenceView<type>::rbegin() const noexcept {
+	return const_reverse_iterator(end());
+}
+
+template <class type>
+inline typename SequenceView<type>::const_reverse_iterator SequenceView<type>::rend() const noexcept {
+	return const_reverse_iterator(begin());
+}
+
+template <class type>
+inline SequenceView<type>::operator std::span<const type>() const noexcept {
+	return std::span<const type>(elements, size);
+}
+
+template <class type>
+bool SequenceView<type>::operator==(const SequenceView& view) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	if (size != view.size) {
+		return false;
+	}
+	if constexpr (isTriviallyComparable<type>) {
+		return size == 0 || elements == view.elements || std::memcmp(elements, view.elements, size * sizeof(type)) == 0;
+	}
+	for (size_t i = 0; i < size; i++) {
+		if (elements[i] != view.elements[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class type>
+inline bool SequenceView<type>::operator!=(const SequenceView& view) const noexcept(noexcept(std::declval<type>() == std::declval<type>())) {
+	return !(*this == view);
+}
+
+template <class type>
+ChunkedView<type>::ChunkedView(SequenceView<type> source, size_t chunkSize) : source(source), chunkSize(chunkSize) {
+	if (chunkSize == 0) {
+		throw std::invalid_argument("ChunkedView: chunk size cannot be 0");
+	}
+}
+
+template <class type>
+inline typename ChunkedView<type>::Cursor ChunkedView<type>::cursor() const noexcept {
+	return Cursor{ source, chunkSize };
+}
+
+template <class type>
+inline size_t ChunkedView<type>::knownSize() const noexcept {
+	return source.getSize() / chunkSize + (source.getSize() % chunkSize != 0);
+}
+
+#endif
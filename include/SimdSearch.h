@@ -0,0 +1,602 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Vectorized equality scans over arithmetic elements. The instruction set is picked at run time,
+// so the same binary uses AVX-512 or AVX2 where the CPU has them and SSE2 everywhere else.
+// Define SEQUENCE_NO_SIMD to build only the scalar loops.
+
+#if !defined(SEQUENCE_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SEQUENCE_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SEQUENCE_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SEQUENCE_SIMD_TARGET(isa)
+#endif
+
+enum class SimdLevel { scalar, sse2, avx2, avx512 };
+
+[[nodiscard]] inline SimdLevel detectSimdLevel() noexcept;
+// the level detected once for this process
+[[nodiscard]] inline SimdLevel simdLevel() noexcept;
+
+// Types whose operator== holds exactly when the object bytes are equal, so ranges of them can be compared
+// with memcmp. Floating point types are not (NaN, -0.0), nor are types with padding. Specialize it for your own types, e.g.
+//   template <> struct IsTriviallyComparable<MyKey> : std::true_type {};
+template <class type>
+struct IsTriviallyComparable : std::bool_constant<std::is_integral_v<type> || std::is_enum_v<type> || std::is_pointer_v<type>> {};
+
+template <class type>
+inline constexpr bool isTriviallyComparable = IsTriviallyComparable<type>::value;
+
+template <class type>
+struct SimdSearch {
+	// floating point lanes compare like operator== does: NaN matches nothing and -0.0 matches 0.0
+	static constexpr bool isSupported =
+#if defined(SEQUENCE_SIMD_X86)
+		(std::is_integral_v<type> && !std::is_same_v<type, bool> && (sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4 || sizeof(type) == 8))
+		|| std::is_same_v<type, float> || std::is_same_v<type, double>;
+#else
+		false;
+#endif
+
+	// all three return count when nothing matches, like Sequence::find
+	[[nodiscard]] static size_t find(const type* first, size_t count, type value, SimdLevel level = simdLevel()) noexcept;
+	[[nodiscard]] static size_t findLast(const type* first, size_t count, type value, SimdLevel level = simdLevel()) noexcept;
+	[[nodiscard]] static size_t count(const type* first, size_t count, type value, SimdLevel level = simdLevel()) noexcept;
+
+	[[nodiscard]] static size_t findScalar(const type* first, size_t count, type value) noexcept;
+	[[nodiscard]] static size_t findLastScalar(const type* first, size_t count, type value) noexcept;
+	[[nodiscard]] static size_t countScalar(const type* first, size_t count, type value) noexcept;
+};
+
+struct SimdCompare {
+	// index of the first byte where the two ranges differ, bytes when they are equal
+	[[nodiscard]] static size_t firstMismatch(const void* first, const void* second, size_t bytes, SimdLevel level = simdLevel()) noexcept;
+	[[nodiscard]] static size_t firstMismatchScalar(const void* first, const void* second, size_t bytes) noexcept;
+};
+
+#if defined(SEQUENCE_SIMD_X86)
+
+// Each kernel compares one register of elements with the broadcast value and returns a bit mask of the matches.
+// SSE2 and AVX2 masks have sizeof(type) bits per element (from movemask), AVX-512 masks one bit per element.
+
+struct Sse2Kernel {
+	static constexpr size_t width = 16;
+	template <class type>
+	static constexpr size_t bitsPerElement = sizeof(type);
+
+	template <class type>
+	SEQUENCE_SIMD_TARGET("sse2") static __m128i broadcast(type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("sse2") static __m128i equalLanes(const type* block, __m128i needle) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("sse2") static uint64_t matches(const type* block, __m128i needle) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("sse2") static size_t find(const type* first, size_t count, type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("sse2") static size_t findLast(const type* first, size_t count, type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("sse2") static size_t count(const type* first, size_t count, type value) noexcept;
+	SEQUENCE_SIMD_TARGET("sse2") static size_t mismatch(const unsigned char* first, const unsigned char* second, size_t bytes) noexcept;
+};
+
+struct Avx2Kernel {
+	static constexpr size_t width = 32;
+	template <class type>
+	static constexpr size_t bitsPerElement = sizeof(type);
+
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx2") static __m256i broadcast(type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx2") static uint64_t matches(const type* block, __m256i needle) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx2") static size_t find(const type* first, size_t count, type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx2") static size_t findLast(const type* first, size_t count, type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx2") static size_t count(const type* first, size_t count, type value) noexcept;
+	SEQUENCE_SIMD_TARGET("avx2") static size_t mismatch(const unsigned char* first, const unsigned char* second, size_t bytes) noexcept;
+};
+
+struct Avx512Kernel {
+	static constexpr size_t width = 64;
+	template <class type>
+	static constexpr size_t bitsPerElement = 1;
+
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx512f,avx512bw") static __m512i broadcast(type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx512f,avx512bw") static uint64_t matches(const type* block, __m512i needle) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx512f,avx512bw") static size_t find(const type* first, size_t count, type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx512f,avx512bw") static size_t findLast(const type* first, size_t count, type value) noexcept;
+	template <class type>
+	SEQUENCE_SIMD_TARGET("avx512f,avx512bw") static size_t count(const type* first, size_t count, type value) noexcept;
+	SEQUENCE_SIMD_TARGET("avx512f,avx512bw") static size_t mismatch(const unsigned char* first, const unsigned char* second, size_t bytes) noexcept;
+};
+
+// integer view of an element with the same bits, used to broadcast floating point values too
+template <class type>
+using SimdBits = std::conditional_t<sizeof(type) == 1, int8_t, std::conditional_t<sizeof(type) == 2, int16_t,
+	std::conditional_t<sizeof(type) == 4, int32_t, int64_t>>>;
+
+
+template <class type>
+inline __m128i Sse2Kernel::broadcast(type value) noexcept {
+	SimdBits<type> bits = std::bit_cast<SimdBits<type>>(value);
+	if constexpr (sizeof(type) == 1) {
+		return _mm_set1_epi8(bits);
+	}
+	else if constexpr (sizeof(type) == 2) {
+		return _mm_set1_epi16(bits);
+	}
+	else if constexpr (sizeof(type) == 4) {
+		return _mm_set1_epi32(bits);
+	}
+	else {
+		return _mm_set1_epi64x(bits);
+	}
+}
+
+template <class type>
+inline __m128i Sse2Kernel::equalLanes(const type* block, __m128i needle) noexcept {
+	__m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+	__m128i equal;
+	if constexpr (std::is_same_v<type, float>) {
+		equal = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(lanes), _mm_castsi128_ps(needle)));
+	}
+	else if constexpr (std::is_same_v<type, double>) {
+		equal = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(lanes), _mm_castsi128_pd(needle)));
+	}
+	else if constexpr (sizeof(type) == 1) {
+		equal = _mm_cmpeq_epi8(lanes, needle);
+	}
+	else if constexpr (sizeof(type) == 2) {
+		equal = _mm_cmpeq_epi16(lanes, needle);
+	}
+	else if constexpr (sizeof(type) == 4) {
+		equal = _mm_cmpeq_epi32(lanes, needle);
+	}
+	else {
+		// no 64-bit compare before SSE4.1: both 32-bit halves have to match
+		equal = _mm_cmpeq_epi32(lanes, needle);
+		equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+	}
+	return equal;
+}
+
+template <class type>
+inline uint64_t Sse2Kernel::matches(const type* block, __m128i needle) noexcept {
+	return static_cast<uint32_t>(_mm_movemask_epi8(equalLanes(block, needle)));
+}
+
+template <class type>
+inline __m256i Avx2Kernel::broadcast(type value) noexcept {
+	SimdBits<type> bits = std::bit_cast<SimdBits<type>>(value);
+	if constexpr (sizeof(type) == 1) {
+		return _mm256_set1_epi8(bits);
+	}
+	else if constexpr (sizeof(type) == 2) {
+		return _mm256_set1_epi16(bits);
+	}
+	else if constexpr (sizeof(type) == 4) {
+		return _mm256_set1_epi32(bits);
+	}
+	else {
+		return _mm256_set1_epi64x(bits);
+	}
+}
+
+template <class type>
+inline uint64_t Avx2Kernel::matches(const type* block, __m256i needle) noexcept {
+	__m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+	__m256i equal;
+	if constexpr (std::is_same_v<type, float>) {
+		equal = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(lanes), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+	}
+	else if constexpr (std::is_same_v<type, double>) {
+		equal = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(lanes), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+	}
+	else if constexpr (sizeof(type) == 1) {
+		equal = _mm256_cmpeq_epi8(lanes, needle);
+	}
+	else if constexpr (sizeof(type) == 2) {
+		equal = _mm256_cmpeq_epi16(lanes, needle);
+	}
+	else if constexpr (sizeof(type) == 4) {
+		equal = _mm256_cmpeq_epi32(lanes, needle);
+	}
+	else {
+		equal = _mm256_cmpeq_epi64(lanes, needle);
+	}
+	return static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+}
+
+template <class type>
+inline __m512i Avx512Kernel::broadcast(type value) noexcept {
+	SimdBits<type> bits = std::bit_cast<SimdBits<type>>(value);
+	if constexpr (sizeof(type) == 1) {
+		return _mm512_set1_epi8(bits);
+	}
+	else if constexpr (sizeof(type) == 2) {
+		return _mm512_set1_epi16(bits);
+	}
+	else if constexpr (sizeof(type) == 4) {
+		return _mm512_set1_epi32(bits);
+	}
+	else {
+		return _mm512_set1_epi64(bits);
+	}
+}
+
+template <class type>
+inline uint64_t Avx512Kernel::matches(const type* block, __m512i needle) noexcept {
+	__m512i lanes = _mm512_loadu_si512(static_cast<const void*>(block));
+	if constexpr (std::is_same_v<type, float>) {
+		return _mm512_cmp_ps_mask(_mm512_castsi512_ps(lanes), _mm512_castsi512_ps(needle), _CMP_EQ_OQ);
+	}
+	else if constexpr (std::is_same_v<type, double>) {
+		return _mm512_cmp_pd_mask(_mm512_castsi512_pd(lanes), _mm512_castsi512_pd(needle), _CMP_EQ_OQ);
+	}
+	else if constexpr (sizeof(type) == 1) {
+		return _mm512_cmpeq_epi8_mask(lanes, needle);
+	}
+	else if constexpr (sizeof(type) == 2) {
+		return _mm512_cmpeq_epi16_mask(lanes, needle);
+	}
+	else if constexpr (sizeof(type) == 4) {
+		return _mm512_cmpeq_epi32_mask(lanes, needle);
+	}
+	else {
+		return _mm512_cmpeq_epi64_mask(lanes, needle);
+	}
+}
+
+// The three scans are the same for every kernel; they are spelled out per kernel because
+// the target attribute has to be on the function that the intrinsics get inlined into.
+
+template <class type>
+size_t Sse2Kernel::find(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m128i needle = broadcast(value);
+	size_t i = 0;
+	for (; i + lanes <= count; i += lanes) {
+		if (uint64_t mask = matches(first + i, needle)) {
+			return i + std::countr_zero(mask) / bitsPerElement<type>;
+		}
+	}
+	size_t rest = SimdSearch<type>::findScalar(first + i, count - i, value);
+	return i + rest;
+}
+
+template <class type>
+size_t Sse2Kernel::findLast(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m128i needle = broadcast(value);
+	size_t i = count;
+	for (; i >= lanes; i -= lanes) {
+		if (uint64_t mask = matches(first + i - lanes, needle)) {
+			return i - lanes + (63 - std::countl_zero(mask)) / bitsPerElement<type>;
+		}
+	}
+	size_t rest = SimdSearch<type>::findLastScalar(first, i, value);
+	return (rest == i) ? count : rest;
+}
+
+// SSE2 has no popcnt, so the matching bytes are counted in byte lanes that are summed up before they overflow
+template <class type>
+size_t Sse2Kernel::count(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m128i needle = broadcast(value);
+	__m128i total = _mm_setzero_si128();
+	size_t i = 0;
+	while (i + lanes <= count) {
+		__m128i bytes = _mm_setzero_si128();
+		for (size_t block = 0; block < 255 && i + lanes <= count; block++, i += lanes) {
+			bytes = _mm_sub_epi8(bytes, equalLanes(first + i, needle));
+		}
+		total = _mm_add_epi64(total, _mm_sad_epu8(bytes, _mm_setzero_si128()));
+	}
+	alignas(16) uint64_t halves[2];
+	_mm_store_si128(reinterpret_cast<__m128i*>(halves), total);
+	size_t found = static_cast<size_t>(halves[0] + halves[1]);
+	return found / bitsPerElement<type> + SimdSearch<type>::countScalar(first + i, count - i, value);
+}
+
+template <class type>
+size_t Avx2Kernel::find(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m256i needle = broadcast(value);
+	size_t i = 0;
+	for (; i + lanes <= count; i += lanes) {
+		if (uint64_t mask = matches(first + i, needle)) {
+			return i + std::countr_zero(mask) / bitsPerElement<type>;
+		}
+	}
+	size_t rest = SimdSearch<type>::findScalar(first + i, count - i, value);
+	return i + rest;
+}
+
+template <class type>
+size_t Avx2Kernel::findLast(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m256i needle = broadcast(value);
+	size_t i = count;
+	for (; i >= lanes; i -= lanes) {
+		if (uint64_t mask = matches(first + i - lanes, needle)) {
+			return i - lanes + (63 - std::countl_zero(mask)) / bitsPerElement<type>;
+		}
+	}
+	size_t rest = SimdSearch<type>::findLastScalar(first, i, value);
+	return (rest == i) ? count : rest;
+}
+
+template <class type>
+size_t Avx2Kernel::count(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m256i needle = broadcast(value);
+	size_t found = 0;
+	size_t i = 0;
+	for (; i + lanes <= count; i += lanes) {
+		found += std::popcount(matches(first + i, needle));
+	}
+	return found / bitsPerElement<type> + SimdSearch<type>::countScalar(first + i, count - i, value);
+}
+
+template <class type>
+size_t Avx512Kernel::find(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m512i needle = broadcast(value);
+	size_t i = 0;
+	for (; i + lanes <= count; i += lanes) {
+		if (uint64_t mask = matches(first + i, needle)) {
+			return i + std::countr_zero(mask);
+		}
+	}
+	size_t rest = SimdSearch<type>::findScalar(first + i, count - i, value);
+	return i + rest;
+}
+
+template <class type>
+size_t Avx512Kernel::findLast(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m512i needle = broadcast(value);
+	size_t i = count;
+	for (; i >= lanes; i -= lanes) {
+		if (uint64_t mask = matches(first + i - lanes, needle)) {
+			return i - lanes + (63 - std::countl_zero(mask));
+		}
+	}
+	size_t rest = SimdSearch<type>::findLastScalar(first, i, value);
+	return (rest == i) ? count : rest;
+}
+
+template <class type>
+size_t Avx512Kernel::count(const type* first, size_t count, type value) noexcept {
+	constexpr size_t lanes = width / sizeof(type);
+	__m512i needle = broadcast(value);
+	size_t found = 0;
+	size_t i = 0;
+	for (; i + lanes <= count; i += lanes) {
+		found += std::popcount(matches(first + i, needle));
+	}
+	return found + SimdSearch<type>::countScalar(first + i, count - i, value);
+}
+
+inline size_t Sse2Kernel::mismatch(const unsigned char* first, const unsigned char* second, size_t bytes) noexcept {
+	size_t i = 0;
+	for (; i + width <= bytes; i += width) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+		uint32_t equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+		if (equal != 0xffff) {
+			return i + std::countr_zero(~equal);
+		}
+	}
+	return i + SimdCompare::firstMismatchScalar(first + i, second + i, bytes - i);
+}
+
+inline size_t Avx2Kernel::mismatch(const unsigned char* first, const unsigned char* second, size_t bytes) noexcept {
+	size_t i = 0;
+	for (; i + width <= bytes; i += width) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+		uint32_t equal = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+		if (equal != 0xffffffffu) {
+			return i + std::countr_zero(~equal);
+		}
+	}
+	return i + SimdCompare::firstMismatchScalar(first + i, second + i, bytes - i);
+}
+
+inline size_t Avx512Kernel::mismatch(const unsigned char* first, const unsigned char* second, size_t bytes) noexcept {
+	size_t i = 0;
+	for (; i + width <= bytes; i += width) {
+		__m512i a = _mm512_loadu_si512(static_cast<const void*>(first + i));
+		__m512i b = _mm512_loadu_si512(static_cast<const void*>(second + i));
+		uint64_t different = _mm512_cmpneq_epi8_mask(a, b);
+		if (different != 0) {
+			return i + std::countr_zero(different);
+		}
+	}
+	return i + SimdCompare::firstMismatchScalar(first + i, second + i, bytes - i);
+}
+
+#endif
+
+inline SimdLevel detectSimdLevel() noexcept {
+#if defined(SEQUENCE_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	bool sse2 = (info[3] & (1 << 26)) != 0;
+	bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+	unsigned long long enabledState = osSavesAvx ? _xgetbv(0) : 0;
+	bool avx2 = false;
+	bool avx512 = false;
+	if (maxLeaf >= 7) {
+		__cpuidex(info, 7, 0);
+		// the OS has to save the YMM (and for AVX-512 also the opmask and ZMM) registers
+		avx2 = (info[1] & (1 << 5)) != 0 && (enabledState & 0x6) == 0x6;
+		avx512 = (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0 && (enabledState & 0xe6) == 0xe6;
+	}
+	if (avx512) {
+		return SimdLevel::avx512;
+	}
+	if (avx2) {
+		return SimdLevel::avx2;
+	}
+	return sse2 ? SimdLevel::sse2 : SimdLevel::scalar;
+#elif defined(SEQUENCE_SIMD_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+		return SimdLevel::avx512;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return SimdLevel::avx2;
+	}
+	return __builtin_cpu_supports("sse2") ? SimdLevel::sse2 : SimdLevel::scalar;
+#else
+	return SimdLevel::scalar;
+#endif
+}
+
+inline SimdLevel simdLevel() noexcept {
+	static const SimdLevel level = detectSimdLevel();
+	return level;
+}
+
+
+template <class type>
+size_t SimdSearch<type>::find(const type* first, size_t count, type value, SimdLevel level) noexcept {
+#if defined(SEQUENCE_SIMD_X86)
+	if constexpr (isSupported) {
+		switch (level) {
+		case SimdLevel::avx512:
+			return Avx512Kernel::find(first, count, value);
+		case SimdLevel::avx2:
+			return Avx2Kernel::find(first, count, value);
+		case SimdLevel::sse2:
+			return Sse2Kernel::find(first, count, value);
+		default:
+			break;
+		}
+	}
+#endif
+	(void)level;
+	return findScalar(first, count, value);
+}
+
+template <class type>
+size_t SimdSearch<type>::findLast(const type* first, size_t count, type value, SimdLevel level) noexcept {
+#if defined(SEQUENCE_SIMD_X86)
+	if constexpr (isSupported) {
+		switch (level) {
+		case SimdLevel::avx512:
+			return Avx512Kernel::findLast(first, count, value);
+		case SimdLevel::avx2:
+			return Avx2Kernel::findLast(first, count, value);
+		case SimdLevel::sse2:
+			return Sse2Kernel::findLast(first, count, value);
+		default:
+			break;
+		}
+	}
+#endif
+	(void)level;
+	return findLastScalar(first, count, value);
+}
+
+template <class type>
+size_t SimdSearch<type>::count(const type* first, size_t count, type value, SimdLevel level) noexcept {
+#if defined(SEQUENCE_SIMD_X86)
+	if constexpr (isSupported) {
+		switch (level) {
+		case SimdLevel::avx512:
+			return Avx512Kernel::count(first, count, value);
+		case SimdLevel::avx2:
+			return Avx2Kernel::count(first, count, value);
+		case SimdLevel::sse2:
+			return Sse2Kernel::count(first, count, value);
+		default:
+			break;
+		}
+	}
+#endif
+	(void)level;
+	return countScalar(first, count, value);
+}
+
+template <class type>
+size_t SimdSearch<type>::findScalar(const type* first, size_t count, type value) noexcept {
+	for (size_t i = 0; i < count; i++)
+	{
+		if (first[i] == value) { return i; }
+	}
+	return count;
+}
+
+template <class type>
+size_t SimdSearch<type>::findLastScalar(const type* first, size_t count, type value) noexcept {
+	for (size_t i = count; i-- > 0;)
+	{
+		if (first[i] == value) { return i; }
+	}
+	return count;
+}
+
+template <class type>
+size_t SimdSearch<type>::countScalar(const type* first, size_t count, type value) noexcept {
+	size_t counter = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (first[i] == value) {
+			counter++;
+		}
+	}
+	return counter;
+}
+
+inline size_t SimdCompare::firstMismatch(const void* first, const void* second, size_t bytes, SimdLevel level) noexcept {
+#if defined(SEQUENCE_SIMD_X86)
+	const unsigned char* a = static_cast<const unsigned char*>(first);
+	const unsigned char* b = static_cast<const unsigned char*>(second);
+	switch (level) {
+	case SimdLevel::avx512:
+		return Avx512Kernel::mismatch(a, b, bytes);
+	case SimdLevel::avx2:
+		return Avx2Kernel::mismatch(a, b, bytes);
+	case SimdLevel::sse2:
+		return Sse2Kernel::mismatch(a, b, bytes);
+	default:
+		break;
+	}
+#endif
+	(void)level;
+	return firstMismatchScalar(first, second, bytes);
+}
+
+inline size_t SimdCompare::firstMismatchScalar(const void* first, const void* second, size_t bytes) noexcept {
+	const unsigned char* a = static_cast<const unsigned char*>(first);
+	const unsigned char* b = static_cast<const unsigned char*>(second);
+	for (size_t i = 0; i < bytes; i++)
+	{
+		if (a[i] != b[i]) { return i; }
+	}
+	return bytes;
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef SMALL_SEQUENCE_H
+#define SMALL_SEQUENCE_H
+
+#include "Sequence.h"
+
+template <class type, size_t inlineCapacity>
+struct InlineBuffer {
+	alignas(type) unsigned char bytes[inlineCapacity * sizeof(type)];
+	bool inUse = false;
+
+	[[nodiscard]] type* inlineElements() noexcept;
+};
+
+// hands out the inline buffer for requests that fit into it while it is free, everything else goes upstream
+template <class type, size_t inlineCapacity, class Upstream = std::allocator<type>>
+class SmallBufferAllocator {
+private:
+	InlineBuffer<type, inlineCapacity>* buffer;
+	SEQUENCE_NO_UNIQUE_ADDRESS Upstream upstream;
+
+	template <class, size_t, class, class>
+	friend class SmallSequence;
+public:
+	using value_type = type;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::false_type;
+	using propagate_on_container_swap = std::false_type;
+	using is_always_equal = std::false_type;
+
+	SmallBufferAllocator(InlineBuffer<type, inlineCapacity>* buffer, const Upstream& upstream = Upstream()) noexcept;
+
+	[[nodiscard]] type* allocate(size_t count);
+	void deallocate(type* pointer, size_t count) noexcept;
+	[[nodiscard]] size_t max_size() const noexcept;
+	[[nodiscard]] bool isInline(const type* pointer) const noexcept;
+	[[nodiscard]] SmallBufferAllocator select_on_container_copy_construction() const;
+
+	[[nodiscard]] bool operator==(const SmallBufferAllocator&) const noexcept;
+	[[nodiscard]] bool operator!=(const SmallBufferAllocator&) const noexcept;
+};
+
+// Sequence whose first inlineCapacity elements live inside the object; it spills to the heap only past that
+template <class type, size_t inlineCapacity, class Alloc = std::allocator<type>, class GrowthPolicy = GeometricGrowth<>>
+class SmallSequence : private InlineBuffer<type, inlineCapacity>,
+                      public Sequence<type, SmallBufferAllocator<type, inlineCapacity, Alloc>, GrowthPolicy> {
+	static_assert(inlineCapacity > 0, "SmallSequence: inline capacity cannot be 0");
+
+	using Buffer = InlineBuffer<type, inlineCapacity>;
+	using Base = Sequence<type, SmallBufferAllocator<type, inlineCapacity, Alloc>, GrowthPolicy>;
+private:
+	[[nodiscard]] bool canStealFrom(const SmallSequence&) const noexcept;
+	void stealFrom(SmallSequence&) noexcept;
+	template <class Source>
+	void assignFrom(Source&& other);
+public:
+	SmallSequence(size_t capacity = inlineCapacity, size_t capacityGrowthStep = 100, const Alloc& allocator = Alloc());
+	SmallSequence(const type* elems, const size_t size, size_t capacity = inlineCapacity, size_t capacityGrowthStep = 100,
+		const Alloc& allocator = Alloc());
+	SmallSequence(const SmallSequence&);
+	SmallSequence(SmallSequence&&) noexcept(std::is_nothrow_move_constructible_v<type>);
+
+	[[nodiscard]] bool isInline() const noexcept;
+	[[nodiscard]] static constexpr size_t getInlineCapacity() noexcept;
+	void resize(size_t newCapacity);
+	void shrink_to_fit();
+	void swap(SmallSequence&) noexcept(std::is_nothrow_move_constructible_v<type> && std::is_nothrow_move_assignable_v<type>);
+	[[nodiscard]] size_t totalSizeInBytes() const;
+
+	SmallSequence& operator=(const SmallSequence&);
+	SmallSequence& operator=(SmallSequence&&) noexcept(std::is_nothrow_move_constructible_v<type>
+		&& std::allocator_traits<Alloc>::is_always_equal::value);
+};
+
+
+template <class type, size_t inlineCapacity>
+inline type* InlineBuffer<type, inlineCapacity>::inlineElements() noexcept {
+	return reinterpret_cast<type*>(bytes);
+}
+
+template <class type, size_t inlineCapacity, class Upstream>
+inline SmallBufferAllocator<type, inlineCapacity, Upstream>::SmallBufferAllocator(InlineBuffer<type, inlineCapacity>* buffer,
+	const Upstream& upstream) noexcept : buffer(buffer), upstream(upstream) {}
+
+template <class type, size_t inlineCapacity, class Upstream>
+type* SmallBufferAllocator<type, inlineCapacity, Upstream>::allocate(size_t count) {
+	if (buffer != nullptr && !buffer->inUse && count <= inlineCapacity) {
+		buffer->inUse = true;
+		return buffer->inlineElements();
+	}
+	return std::allocator_traits<Upstream>::allocate(upstream, count);
+}
+
+template <class type, size_t inlineCapacity, class Upstream>
+void SmallBufferAllocator<type, inlineCapacity, Upstream>::deallocate(type* pointer, size_t count) noexcept {
+	if (isInline(pointer)) {
+		buffer->inUse = false;
+		return;
+	}
+	std::allocator_traits<Upstream>::deallocate(upstream, pointer, count);
+}
+
+template <class type, size_t inlineCapacity, class Upstream>
+inline size_t SmallBufferAllocator<type, inlineCapacity, Upstream>::max_size() const noexcept {
+	return std::allocator_traits<Upstream>::max_size(upstream);
+}
+
+template <class type, size_t inlineCapacity, class Upstream>
+inline bool SmallBufferAllocator<type, inlineCapacity, Upstream>::isInline(const type* pointer) const noexcept {
+	return buffer != nullptr && pointer == buffer->inlineElements();
+}
+
+// a copy made without a buffer of its own only ever allocates upstream
+template <class type, size_t inlineCapacity, class Upstream>
+inline SmallBufferAllocator<type, inlineCapacity, Upstream> SmallBufferAllocator<type, inlineCapacity, Upstream>::select_on_container_copy_construction() const {
+	return SmallBufferAllocator(nullptr, std::allocator_traits<Upstream>::select_on_container_copy_construction(upstream));
+}
+
+template <class type, size_t inlineCapacity, class Upstream>
+inline bool SmallBufferAllocator<type, inlineCapacity, Upstream>::operator==(const SmallBufferAllocator& other) const noexcept {
+	return buffer == other.buffer && upstream == other.upstream;
+}
+
+template <class type, size_t inlineCapacity, class Upstream>
+inline bool SmallBufferAllocator<type, inlineCapacity, Upstream>::operator!=(const SmallBufferAllocator& other) const noexcept {
+	return !(*this == other);
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::SmallSequence(size_t capacity, size_t capacityGrowthStep, const Alloc& allocator)
+	: Buffer(), Base((capacity < inlineCapacity) ? inlineCapacity : capacity, capacityGrowthStep,
+		SmallBufferAllocator<type, inlineCapacity, Alloc>(this, allocator)) {}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::SmallSequence(const type* elems, const size_t size, size_t capacity,
+	size_t capacityGrowthStep, const Alloc& allocator)
+	: Buffer(), Base(elems, size, (size <= capacity && capacity < inlineCapacity) ? inlineCapacity : capacity, capacityGrowthStep,
+		SmallBufferAllocator<type, inlineCapacity, Alloc>(this, allocator)) {}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::SmallSequence(const SmallSequence& other)
+	: Buffer(), Base(inlineCapacity, other.capacityGrowthStep, SmallBufferAllocator<type, inlineCapacity, Alloc>(this,
+		std::allocator_traits<Alloc>::select_on_container_copy_construction(other.allocator.upstream))) {
+	this->copyIndexSetting(other);
+	assignFrom(other);
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::SmallSequence(SmallSequence&& other) noexcept(std::is_nothrow_move_constructible_v<type>)
+	: Buffer(), Base(inlineCapacity, other.capacityGrowthStep, SmallBufferAllocator<type, inlineCapacity, Alloc>(this, other.allocator.upstream)) {
+	if (canStealFrom(other)) {
+		stealFrom(other);
+		return;
+	}
+	assignFrom(std::move(other));
+	this->valueIndex = std::move(other.valueIndex);
+	this->invalidateIndex();
+	other.clear();
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+inline bool SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::canStealFrom(const SmallSequence& other) const noexcept {
+	return !other.isInline() && other.storage != nullptr && this->allocator.upstream == other.allocator.upstream;
+}
+
+// takes over the heap buffer of other, which falls back to its empty inline buffer
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+void SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::stealFrom(SmallSequence& other) noexcept {
+	this->releaseStorage();
+	this->storage = other.storage;
+	this->elements = other.elements;
+	this->size = other.size;
+	this->capacity = other.capacity;
+	this->capacityGrowthStep = other.capacityGrowthStep;
+	this->valueIndex = std::move(other.valueIndex);
+
+	other.inUse = true;
+	other.storage = other.inlineElements();
+	other.elements = other.storage;
+	other.size = 0;
+	other.capacity = inlineCapacity;
+}
+
+// keeps the current buffer when the elements fit, so inline storage is reused instead of reallocated
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+template <class Source>
+void SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::assignFrom(Source&& other) {
+	this->clear();
+	this->reserve(other.getSize());
+	for (size_t i = 0; i < other.getSize(); i++) {
+		if constexpr (std::is_lvalue_reference_v<Source>) {
+			this->emplace_back(other[i]);
+		}
+		else {
+			this->emplace_back(std::move_if_noexcept(other[i]));
+		}
+	}
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+inline bool SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::isInline() const noexcept {
+	return this->allocator.isInline(this->storage);
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+inline constexpr size_t SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::getInlineCapacity() noexcept {
+	return inlineCapacity;
+}
+
+// the capacity never drops below the inline buffer, so shrinking a spilled sequence brings it back inline
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+void SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::resize(size_t newCapacity) {
+	if (newCapacity < this->size) {
+		this->invalidateIndex();
+	}
+	this->destroyTail(newCapacity);
+	Base::resize((newCapacity < inlineCapacity) ? inlineCapacity : newCapacity);
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+inline void SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::shrink_to_fit() {
+	resize(this->getSize());
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+void SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::swap(SmallSequence& other)
+	noexcept(std::is_nothrow_move_constructible_v<type> && std::is_nothrow_move_assignable_v<type>) {
+	if (this == &other) {
+		return;
+	}
+	if (canStealFrom(other) && other.canStealFrom(*this)) {
+		Base::swap(other);
+		return;
+	}
+	SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy> saved(std::move(other));
+	other = std::move(*this);
+	*this = std::move(saved);
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+void swap(SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>& a, SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>& b)
+	noexcept(noexcept(a.swap(b))) {
+	a.swap(b);
+}
+
+// the inline buffer is part of the object, so only spilled elements add to sizeof(*this)
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+inline size_t SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::totalSizeInBytes() const {
+	return (isInline() ? sizeof(*this) : sizeof(*this) + this->dataSizeInBytes()) + this->indexSizeInBytes();
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>& SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::operator=(const SmallSequence& other) {
+	if (this != &other) {
+		this->copyIndexSetting(other);
+		assignFrom(other);
+		this->capacityGrowthStep = other.capacityGrowthStep;
+	}
+	return *this;
+}
+
+template <class type, size_t inlineCapacity, class Alloc, class GrowthPolicy>
+SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>& SmallSequence<type, inlineCapacity, Alloc, GrowthPolicy>::operator=(SmallSequence&& other)
+	noexcept(std::is_nothrow_move_constructible_v<type> && std::allocator_traits<Alloc>::is_always_equal::value) {
+	if (this == &other) {
+		return *this;
+	}
+	if (canStealFrom(other)) {
+		stealFrom(other);
+		return *this;
+	}
+	assignFrom(std::move(other));
+	this->capacityGrowthStep = other.capacityGrowthStep;
+	this->valueIndex = std::move(other.valueIndex);
+	this->invalidateIndex();
+	other.clear();
+	return *this;
+}
+
+#endif
@@ -0,0 +1,398 @@
+#ifndef SORTED_SEQUENCE_H
+#define SORTED_SEQUENCE_H
+
+#include "Sequence.h"
+#include <utility>
+
+// Sequence kept in ascending order by Compare. Lookups are binary searches, elements equal to a value are the ones
+// equivalent to it (neither compares less). Only operations that keep the order are exposed;
+// asSequence() gives read access to everything else.
+template <class type, class Compare = std::less<type>, class Alloc = std::allocator<type>, class GrowthPolicy = GeometricGrowth<>>
+class SortedSequence : private Sequence<type, Alloc, GrowthPolicy> {
+	using Base = Sequence<type, Alloc, GrowthPolicy>;
+private:
+	SEQUENCE_NO_UNIQUE_ADDRESS Compare comp;
+public:
+	SortedSequence(size_t capacity = 100, size_t capacityGrowthStep = 100, const Compare& comp = Compare(), const Alloc& allocator = Alloc());
+	// sorts a copy of the elements
+	explicit SortedSequence(const Base& seq, const Compare& comp = Compare());
+	SortedSequence(const type* elems, size_t size, const Compare& comp = Compare(), const Alloc& allocator = Alloc());
+
+	using Base::getAllocator;
+	using Base::setCapacityGrowthStep;
+	using Base::getCapacityGrowthStep;
+	using Base::getSize;
+	using Base::getCapacity;
+	using Base::isEmpty;
+	using Base::isFull;
+	using Base::clear;
+	using Base::reserve;
+	using Base::shrink_to_fit;
+	using Base::print;
+	using Base::totalSizeInBytes;
+	using Base::dataSizeInBytes;
+	using Base::slice;
+	using Base::first;
+	using Base::last;
+	using Base::operator SequenceView<type>;
+	using Base::filtered;
+	using Base::mapped;
+	using Base::take;
+	using Base::drop;
+	using Base::chunked;
+
+	using value_type = type;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using const_reference = const type&;
+	using const_pointer = const type*;
+	using const_iterator = const type*;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	// elements are read only, so every iterator is a const_iterator
+	using iterator = const_iterator;
+	using reverse_iterator = const_reverse_iterator;
+
+	[[nodiscard]] const Base& asSequence() const noexcept;
+	[[nodiscard]] Compare getCompare() const;
+
+	// index of the first element not less than value, getSize() when there is none; branchless
+	[[nodiscard]] size_t lowerBound(const type& value) const;
+	// index of the first element greater than value
+	[[nodiscard]] size_t upperBound(const type& value) const;
+	[[nodiscard]] std::pair<size_t, size_t> equalRange(const type& value) const;
+	[[nodiscard]] size_t find(const type&) const;
+	[[nodiscard]] size_t findFirst(const type&) const;
+	[[nodiscard]] size_t findLast(const type&) const;
+	[[nodiscard]] bool contains(const type&) const;
+	[[nodiscard]] size_t containsLotsOf(const type&) const;
+
+	// after the elements equal to value; returns the index it went to
+	size_t insert(const type& value);
+	size_t insert(type&& value);
+	SortedSequence& push_back(const type& value);
+	SortedSequence& push_back(type&& value);
+	// throws std::invalid_argument when value does not belong at index
+	SortedSequence& insertAt(size_t index, const type& value);
+	// merges the batch in a single pass; it is sorted first unless it already is
+	SortedSequence& insertSorted(const type* values, size_t count);
+	SortedSequence& insertSorted(const Base& values);
+	SortedSequence& insertSorted(const SortedSequence& values);
+
+	SortedSequence& pop_back() noexcept;
+	SortedSequence& pop_front() noexcept;
+	SortedSequence& removeAt(size_t index);
+	SortedSequence& removeAll(const type& value);
+	template <class Predicate>
+	size_t removeIf(Predicate predicate);
+
+	[[nodiscard]] const type& front() const;
+	[[nodiscard]] const type& back() const;
+	[[nodiscard]] const type& at(size_t index) const;
+	[[nodiscard]] const type& operator[] (size_t index) const;
+	[[nodiscard]] const type* data() const noexcept;
+	[[nodiscard]] const_iterator begin() const noexcept;
+	[[nodiscard]] const_iterator end() const noexcept;
+	[[nodiscard]] const_iterator cbegin() const noexcept;
+	[[nodiscard]] const_iterator cend() const noexcept;
+	[[nodiscard]] const_reverse_iterator rbegin() const noexcept;
+	[[nodiscard]] const_reverse_iterator rend() const noexcept;
+	[[nodiscard]] const_reverse_iterator crbegin() const noexcept;
+	[[nodiscard]] const_reverse_iterator crend() const noexcept;
+
+	[[nodiscard]] bool operator==(const SortedSequence&) const;
+	[[nodiscard]] bool operator!=(const SortedSequence&) const;
+};
+
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>::SortedSequence(size_t capacity, size_t capacityGrowthStep, const Compare& comp,
+	const Alloc& allocator) : Base(capacity, capacityGrowthStep, allocator), comp(comp) {}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>::SortedSequence(const Base& seq, const Compare& comp) : Base(seq), comp(comp) {
+	Base::sort(comp);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>::SortedSequence(const type* elems, size_t size, const Compare& comp, const Alloc& allocator)
+	: Base(elems, size, (size > 100) ? size : 100, 100, allocator), comp(comp) {
+	Base::sort(comp);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline const Sequence<type, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::asSequence() const noexcept {
+	return *this;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline Compare SortedSequence<type, Compare, Alloc, GrowthPolicy>::getCompare() const {
+	return comp;
+}
+
+// halves the range without branching on the comparison, so the compiler can use a conditional move
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::lowerBound(const type& value) const {
+	if (this->size == 0) {
+		return 0;
+	}
+	const type* base = this->elements;
+	size_t length = this->size;
+	while (length > 1) {
+		size_t half = length / 2;
+		base = comp(base[half], value) ? base + half : base;
+		length -= half;
+	}
+	return static_cast<size_t>(base - this->elements) + (comp(*base, value) ? 1 : 0);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::upperBound(const type& value) const {
+	if (this->size == 0) {
+		return 0;
+	}
+	const type* base = this->elements;
+	size_t length = this->size;
+	while (length > 1) {
+		size_t half = length / 2;
+		base = comp(value, base[half]) ? base : base + half;
+		length -= half;
+	}
+	return static_cast<size_t>(base - this->elements) + (comp(value, *base) ? 0 : 1);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline std::pair<size_t, size_t> SortedSequence<type, Compare, Alloc, GrowthPolicy>::equalRange(const type& value) const {
+	return { lowerBound(value), upperBound(value) };
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::find(const type& value) const {
+	size_t index = lowerBound(value);
+	return (index < this->size && !comp(value, this->elements[index])) ? index : this->size;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::findFirst(const type& value) const {
+	return find(value);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::findLast(const type& value) const {
+	size_t index = upperBound(value);
+	return (index > 0 && !comp(this->elements[index - 1], value)) ? index - 1 : this->size;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline bool SortedSequence<type, Compare, Alloc, GrowthPolicy>::contains(const type& value) const {
+	return find(value) != this->size;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::containsLotsOf(const type& value) const {
+	auto [first, last] = equalRange(value);
+	return last - first;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::insert(const type& value) {
+	size_t index = upperBound(value);
+	Base::insertAt(index, value);
+	return index;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::insert(type&& value) {
+	size_t index = upperBound(value);
+	Base::insertAt(index, std::move(value));
+	return index;
+}
+
+// appending stays O(1) while the values arrive in order
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::push_back(const type& value) {
+	if (this->size == 0 || !comp(value, this->elements[this->size - 1])) {
+		Base::push_back(value);
+	}
+	else {
+		insert(value);
+	}
+	return *this;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::push_back(type&& value) {
+	if (this->size == 0 || !comp(value, this->elements[this->size - 1])) {
+		Base::push_back(std::move(value));
+	}
+	else {
+		insert(std::move(value));
+	}
+	return *this;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::insertAt(size_t index, const type& value) {
+	if (index > this->size) {
+		throw std::out_of_range("Index out of range");
+	}
+	if ((index > 0 && comp(value, this->elements[index - 1])) || (index < this->size && comp(this->elements[index], value))) {
+		throw std::invalid_argument("SortedSequence insertAt: value does not belong at this index");
+	}
+	Base::insertAt(index, value);
+	return *this;
+}
+
+// Appends the batch, then merges from the back: every step moves the greater of the last unmerged element
+// and the last unmerged value into the highest free slot. Values go after the elements equal to them.
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::insertSorted(const type* values, size_t count) {
+	if (count == 0) {
+		return *this;
+	}
+	if (this->owns(values) || !std::is_sorted(values, values + count, comp)) {
+		Base batch(values, count, count, 1, this->allocator);
+		batch.sort(comp);
+		return insertSorted(batch.elements, batch.size);
+	}
+
+	size_t existing = this->size;
+	Base::push_back(values, count);
+	if (existing == 0 || !comp(values[0], this->elements[existing - 1])) {
+		return *this;
+	}
+	type* target = this->elements + this->size;
+	type* mine = this->elements + existing;
+	const type* theirs = values + count;
+	while (theirs != values) {
+		if (mine != this->elements && comp(*(theirs - 1), *(mine - 1))) {
+			*--target = std::move(*--mine);
+		}
+		else {
+			*--target = *--theirs;
+		}
+	}
+	return *this;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::insertSorted(const Base& values) {
+	return insertSorted(values.elements, values.size);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::insertSorted(const SortedSequence& values) {
+	return insertSorted(values.elements, values.size);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::pop_back() noexcept {
+	Base::pop_back();
+	return *this;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::pop_front() noexcept {
+	Base::pop_front();
+	return *this;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::removeAt(size_t index) {
+	Base::removeAt(index);
+	return *this;
+}
+
+// the equal elements are adjacent, so they go in one shift
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+SortedSequence<type, Compare, Alloc, GrowthPolicy>& SortedSequence<type, Compare, Alloc, GrowthPolicy>::removeAll(const type& value) {
+	auto [first, last] = equalRange(value);
+	if (last > first) {
+		std::destroy(this->elements + first, this->elements + last);
+		this->size -= last - first;
+		this->closeGapAt(first, last - first);
+	}
+	return *this;
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+template <class Predicate>
+inline size_t SortedSequence<type, Compare, Alloc, GrowthPolicy>::removeIf(Predicate predicate) {
+	return Base::removeIf(predicate);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline const type& SortedSequence<type, Compare, Alloc, GrowthPolicy>::front() const {
+	return Base::front();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline const type& SortedSequence<type, Compare, Alloc, GrowthPolicy>::back() const {
+	return Base::back();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline const type& SortedSequence<type, Compare, Alloc, GrowthPolicy>::at(size_t index) const {
+	return Base::at(index);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline const type& SortedSequence<type, Compare, Alloc, GrowthPolicy>::operator[](size_t index) const {
+	return Base::operator[](index);
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline const type* SortedSequence<type, Compare, Alloc, GrowthPolicy>::data() const noexcept {
+	return Base::data();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::begin() const noexcept {
+	return Base::cbegin();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::end() const noexcept {
+	return Base::cend();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::cbegin() const noexcept {
+	return Base::cbegin();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::cend() const noexcept {
+	return Base::cend();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_reverse_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::rbegin() const noexcept {
+	return Base::crbegin();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_reverse_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::rend() const noexcept {
+	return Base::crend();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_reverse_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::crbegin() const noexcept {
+	return Base::crbegin();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline typename SortedSequence<type, Compare, Alloc, GrowthPolicy>::const_reverse_iterator SortedSequence<type, Compare, Alloc, GrowthPolicy>::crend() const noexcept {
+	return Base::crend();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline bool SortedSequence<type, Compare, Alloc, GrowthPolicy>::operator==(const SortedSequence& other) const {
+	return asSequence() == other.asSequence();
+}
+
+template <class type, class Compare, class Alloc, class GrowthPolicy>
+inline bool SortedSequence<type, Compare, Alloc, GrowthPolicy>::operator!=(const SortedSequence& other) const {
+	return !(*this == other);
+}
+
+#endif
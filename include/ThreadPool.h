@@ -0,0 +1,207 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool behind the execution policy overloads of Sequence.
+// Every worker owns a queue: it takes its own tasks from the back and steals from the front of the others,
+// so tasks spawned by a worker stay on its core while idle workers balance the load.
+class ThreadPool {
+public:
+	explicit ThreadPool(size_t threadCount = defaultThreadCount());
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	~ThreadPool() noexcept;
+
+	// pool shared by all sequences, sized to the hardware
+	[[nodiscard]] static ThreadPool& shared();
+	[[nodiscard]] static size_t defaultThreadCount() noexcept;
+	[[nodiscard]] size_t getThreadCount() const noexcept;
+
+	void submit(std::function<void()> task);
+	// runs body(begin, end) over pieces of [0, count) of at least minChunk indices and returns when all are done;
+	// the calling thread works on them too, the first exception thrown by body is rethrown here
+	template <class Body>
+	void parallelFor(size_t count, size_t minChunk, Body&& body);
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> threads;
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+	std::atomic<size_t> queued{ 0 };
+	std::atomic<size_t> nextQueue{ 0 };
+	bool stopping = false;
+
+	static inline thread_local ThreadPool* currentPool = nullptr;
+	static inline thread_local size_t currentIndex = 0;
+
+	bool tryRunOne(size_t preferred);
+	void workerLoop(size_t index);
+};
+
+
+inline ThreadPool::ThreadPool(size_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = 1;
+	}
+	for (size_t i = 0; i < threadCount; i++) {
+		queues.push_back(std::make_unique<Queue>());
+	}
+	threads.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; i++) {
+		threads.emplace_back([this, i] { workerLoop(i); });
+	}
+}
+
+inline ThreadPool::~ThreadPool() noexcept {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+inline ThreadPool& ThreadPool::shared() {
+	static ThreadPool pool;
+	return pool;
+}
+
+inline size_t ThreadPool::defaultThreadCount() noexcept {
+	unsigned hardware = std::thread::hardware_concurrency();
+	return (hardware == 0) ? 1 : hardware;
+}
+
+inline size_t ThreadPool::getThreadCount() const noexcept {
+	return threads.size();
+}
+
+// a worker keeps what it spawns, other threads spread their tasks round robin
+inline void ThreadPool::submit(std::function<void()> task) {
+	size_t index = (currentPool == this) ? currentIndex : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+	{
+		std::lock_guard<std::mutex> lock(queues[index]->mutex);
+		queues[index]->tasks.push_back(std::move(task));
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		queued.fetch_add(1, std::memory_order_relaxed);
+	}
+	wake.notify_one();
+}
+
+inline bool ThreadPool::tryRunOne(size_t preferred) {
+	std::function<void()> task;
+	for (size_t i = 0; i < queues.size() && !task; i++) {
+		Queue& queue = *queues[(preferred + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			if (i == 0) {
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			}
+			else {
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+		}
+	}
+	if (!task) {
+		return false;
+	}
+	queued.fetch_sub(1, std::memory_order_relaxed);
+	task();
+	return true;
+}
+
+inline void ThreadPool::workerLoop(size_t index) {
+	currentPool = this;
+	currentIndex = index;
+	for (;;) {
+		if (tryRunOne(index)) {
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+		if (stopping && queued.load(std::memory_order_relaxed) == 0) {
+			return;
+		}
+	}
+}
+
+template <class Body>
+void ThreadPool::parallelFor(size_t count, size_t minChunk, Body&& body) {
+	if (count == 0) {
+		return;
+	}
+	if (minChunk == 0) {
+		minChunk = 1;
+	}
+	// a few pieces per thread, so that stealing can even out uneven ones
+	size_t pieces = getThreadCount() * 4;
+	if (pieces > count / minChunk) {
+		pieces = (count / minChunk > 0) ? count / minChunk : 1;
+	}
+
+	struct State {
+		std::atomic<size_t> remaining;
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr error;
+	};
+	auto state = std::make_shared<State>();
+	state->remaining.store(pieces);
+
+	auto runPiece = [state, count, pieces, &body](size_t piece) {
+		try {
+			body(count * piece / pieces, count * (piece + 1) / pieces);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(state->mutex);
+			if (!state->error) {
+				state->error = std::current_exception();
+			}
+		}
+		if (state->remaining.fetch_sub(1) == 1) {
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->done.notify_all();
+		}
+	};
+
+	for (size_t piece = 1; piece < pieces; piece++) {
+		submit([runPiece, piece] { runPiece(piece); });
+	}
+	runPiece(0);
+
+	size_t preferred = (currentPool == this) ? currentIndex : 0;
+	while (state->remaining.load() > 0) {
+		if (tryRunOne(preferred)) {
+			continue;
+		}
+		// whatever is left is already running on other threads
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->done.wait(lock, [&state] { return state->remaining.load() == 0; });
+	}
+	if (state->error) {
+		std::rethrow_exception(state->error);
+	}
+}
+
+#endif
@@ -1,7 +1,14 @@
 #include "../include/Sequence.h"
 #include "../tests/run_tests.h"
+#include "../benchmarks/run_benchmarks.h"
+#include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
 	// run tests:
 	mainTesting();
-}
\ No newline at end of file
+
+	// run benchmarks with --bench:
+	if (argc > 1 && std::string(argv[1]) == "--bench") {
+		mainBenchmarking();
+	}
+}
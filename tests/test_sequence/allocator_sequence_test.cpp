@@ -0,0 +1,102 @@
+#include "../../include/Sequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <memory_resource>
+#include <string>
+
+template <class type>
+struct CountingAllocator {
+	using value_type = type;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+	using is_always_equal = std::false_type;
+
+	int id;
+	long long* balance;
+
+	CountingAllocator(int id, long long* balance) : id(id), balance(balance) {}
+	template <class other>
+	CountingAllocator(const CountingAllocator<other>& allocator) : id(allocator.id), balance(allocator.balance) {}
+
+	type* allocate(size_t count) {
+		*balance += static_cast<long long>(count);
+		return std::allocator<type>().allocate(count);
+	}
+	void deallocate(type* pointer, size_t count) {
+		*balance -= static_cast<long long>(count);
+		std::allocator<type>().deallocate(pointer, count);
+	}
+
+	bool operator==(const CountingAllocator& other) const noexcept { return id == other.id; }
+	bool operator!=(const CountingAllocator& other) const noexcept { return id != other.id; }
+};
+
+void testPolymorphicAllocator() {
+	alignas(std::max_align_t) unsigned char buffer[1 << 14];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	pmr::Sequence<int> seq(&arena);
+	for (int i = 0; i < 300; i++) {
+		seq.push_back(i);
+	}
+	assert(seq.getSize() == 300 && seq[299] == 299);
+	assert(seq.getAllocator().resource() == &arena);
+
+	pmr::Sequence<int> sameArena(seq, &arena);
+	assert(sameArena == seq && sameArena.getAllocator().resource() == &arena);
+	pmr::Sequence<int> defaultResource(seq);
+	assert(defaultResource.getAllocator().resource() == std::pmr::get_default_resource());
+
+	pmr::Sequence<std::pmr::string> strings(4, 4, &arena);
+	strings.emplace_back("a string long enough to need its own allocation");
+	strings.push_back(std::pmr::string("another string long enough to need an allocation"));
+	assert(strings[0].get_allocator().resource() == &arena && strings[1].get_allocator().resource() == &arena);
+
+	std::pmr::unsynchronized_pool_resource pool;
+	pmr::Sequence<int> pooled(10, 10, &pool);
+	pooled.push_back(1);
+	pooled = std::move(seq);
+	assert(pooled.getAllocator().resource() == &pool && pooled.getSize() == 300 && pooled[150] == 150);
+	assert(seq.isEmpty());
+
+	pmr::Sequence<int> moved(std::move(sameArena));
+	assert(moved.getAllocator().resource() == &arena && moved.getSize() == 300 && sameArena.getSize() == 0);
+	pmr::Sequence<int> movedToPool(std::move(moved), &pool);
+	assert(movedToPool.getAllocator().resource() == &pool && movedToPool[299] == 299);
+}
+
+void testAllocatorPropagation() {
+	long long balanceA = 0;
+	long long balanceB = 0;
+	{
+		using CountedSequence = Sequence<std::string, CountingAllocator<std::string>>;
+		CountedSequence a(10, 10, CountingAllocator<std::string>(1, &balanceA));
+		CountedSequence b(20, 10, CountingAllocator<std::string>(2, &balanceB));
+		a.push_back("a");
+		b.push_back("b").push_back("c");
+		assert(balanceA == 10 && balanceB == 20);
+
+		a.swap(b);
+		assert(a.getAllocator().id == 2 && b.getAllocator().id == 1);
+		assert(a.getSize() == 2 && b[0] == "a");
+
+		CountedSequence c(5, 5, CountingAllocator<std::string>(1, &balanceA));
+		c = a;
+		assert(c.getAllocator().id == 2 && c.getSize() == 2 && c[1] == "c");
+		assert(balanceA == 10 && balanceB == 40);
+
+		c = std::move(b);
+		assert(c.getAllocator().id == 1 && c[0] == "a" && b.getSize() == 0);
+		assert(balanceA == 10 && balanceB == 20);
+
+		CountedSequence d(c);
+		assert(d.getAllocator().id == 1 && balanceA == 20);
+	}
+	assert(balanceA == 0 && balanceB == 0);
+}
+
+size_t testAllocators() {
+	runTest(testPolymorphicAllocator);
+	return runTest(testAllocatorPropagation);
+}
@@ -1,5 +1,6 @@
 #include "../../include/Sequence.h"
 #include "runTestMethods.h"
+#include "trackedElement.h"
 #include "cassert"
 #include <sstream>
 #include <functional>
@@ -87,8 +88,8 @@ void testChanging() {
 	seq.changeAll(5, 10);
 	assert(seq[0] == 10 && seq[5] == 10 && seq[7] == 10);
 
-	assert(!tryCall(seq, &Sequence<int>::changeAt, -55, 2));
-	assert(!tryCall(seq, &Sequence<int>::changeAt, -65, 2));
+	assert(!tryCall(seq, static_cast<Sequence<int>& (Sequence<int>::*)(size_t, const int&)>(&Sequence<int>::changeAt), -55, 2));
+	assert(!tryCall(seq, static_cast<Sequence<int>& (Sequence<int>::*)(size_t, const int&)>(&Sequence<int>::changeAt), -65, 2));
 }
 
 void testClearing() {
@@ -211,8 +212,8 @@ void testInserting() {
 	seq.insertAt(6, 1);
 	assert(seq.getCapacity() == 110);
 
-	assert(!tryCall(seq, &Sequence<int>::insertAt, -57, 58));
-	assert(!tryCall(seq, &Sequence<int>::insertAt, 254, 8));
+	assert(!tryCall(seq, static_cast<Sequence<int>& (Sequence<int>::*)(size_t, const int&)>(&Sequence<int>::insertAt), -57, 58));
+	assert(!tryCall(seq, static_cast<Sequence<int>& (Sequence<int>::*)(size_t, const int&)>(&Sequence<int>::insertAt), 254, 8));
 	
 	assert(seq.getCapacity() == 110);
 	assert(seq.getSize() == 11);
@@ -237,14 +238,49 @@ void testRemoving() {
 	seq.removeAll(5).removeAll(654).removeAll(2).removeAll(4);
 	assert(seq[0] == 12 && seq[1] == 23 && seq[2] == 234 && seq.getSize() == 3);
 	
-	assert(!tryCall(seq, &Sequence<int>::removeAt, -6));
-	assert(!tryCall(seq, &Sequence<int>::removeAt, 87));
+	assert(!tryCall(seq, static_cast<Sequence<int>& (Sequence<int>::*)(size_t)>(&Sequence<int>::removeAt), -6));
+	assert(!tryCall(seq, static_cast<Sequence<int>& (Sequence<int>::*)(size_t)>(&Sequence<int>::removeAt), 87));
 	
 	seq.removeAll(23).removeAt(0).removeAt(0);
 	
 	assert(seq.getSize() == 0);
 }
 
+void testRemovingInBulk() {
+	Sequence<int> seq(10);
+	for (int i = 0; i < 20; i++) {
+		seq.push_back(i);
+	}
+	assert(seq.removeIf([](int value) { return value % 3 == 0; }) == 7);
+	assert(seq.getSize() == 13 && seq[0] == 1 && seq[1] == 2 && seq[2] == 4 && seq.back() == 19);
+	assert(seq.replaceIf([](int value) { return value > 10; }, 0) == 6);
+	assert(seq.containsLotsOf(0) == 6 && seq[6] == 10 && seq[7] == 0);
+	assert(seq.removeIf([](int) { return false; }) == 0 && seq.getSize() == 13);
+
+	// unsorted and repeated indices, removed in one sweep
+	size_t indices[] = { 12, 0, 5, 0, 7 };
+	assert(seq.removeAt(Sequence<size_t>(indices, 5)) == 4);
+	assert(seq.getSize() == 9 && seq[0] == 2 && seq[3] == 7 && seq[4] == 10 && seq.back() == 0);
+	assert(seq.removeAt(Sequence<size_t>()) == 0);
+	size_t outOfRange[] = { 1, 9 };
+	assert(!tryCall(seq, static_cast<size_t (Sequence<int>::*)(const Sequence<size_t>&)>(&Sequence<int>::removeAt), Sequence<size_t>(outOfRange, 2)));
+	assert(seq.getSize() == 9);
+
+	// the value may live in the sequence itself
+	seq.removeAll(seq[0]).changeAll(seq.back(), 7);
+	assert(seq.getSize() == 8 && seq[0] == 4 && seq.containsLotsOf(7) == 5);
+
+	Sequence<TrackedElement> tracked(8);
+	for (int i = 0; i < 8; i++) {
+		tracked.push_back(TrackedElement(i % 2));
+	}
+	TrackedElement::reset();
+	assert(tracked.removeIf([](const TrackedElement& element) { return element.value == 1; }) == 4);
+	assert(TrackedElement::alive == 4 && TrackedElement::copies == 0 && tracked.getSize() == 4);
+	size_t all[] = { 3, 2, 1, 0 };
+	assert(tracked.removeAt(Sequence<size_t>(all, 4)) == 4 && tracked.isEmpty());
+}
+
 void testCopying() {
 	Sequence<int> seq(10);
 	seq.push_back(7).push_back(12).push_back(654).push_back(23).push_back(234).push_back(5).push_back(4).push_back(5);
@@ -328,18 +364,18 @@ void testPushingArray() {
 	addedSeq.push_back(true).push_back(false);
 
 	seq.push_back(addedSeq);
-	assert(seq.getCapacity() == 104 && seq.getSize() == 4);
+	assert(seq.getCapacity() == 103 && seq.getSize() == 4);
 	assert(seq.at(0) == false && seq.at(1) == true && seq.at(2) == true && seq.at(3) == false);
 
 	seq.push_back(new bool[] {true, false, false}, 3);
-	assert(seq.getCapacity() == 104 && seq.getSize() == 7);
+	assert(seq.getCapacity() == 103 && seq.getSize() == 7);
 	assert(seq.at(4) == true && seq.at(5) == false && seq.at(6) == false);
 	
 	addedSeq.push_back(seq);
 	seq.push_back(addedSeq);
 	seq.push_back(seq).push_back(seq);
 	seq.push_back(seq);
-	assert(seq.getSize() == 128 && seq.getCapacity() == 228);
+	assert(seq.getSize() == 128 && seq.getCapacity() == 206);
 }
 
 void testFrontBack() {
@@ -371,6 +407,40 @@ void testCapacityGrowthStep() {
 	assert(seq.getCapacityGrowthStep() == 1);
 }
 
+void testGrowthPolicies() {
+	Sequence<int, std::allocator<int>, LinearGrowth> linear(2, 3);
+	linear.push_back(1).push_back(2).push_back(3);
+	assert(linear.getCapacity() == 5);
+	linear.push_back(4).push_back(5).push_back(6);
+	assert(linear.getCapacity() == 8 && linear.getSize() == 6);
+	linear.setCapacityGrowthStep(10);
+	linear.push_back(new int[] {7, 8, 9}, 3);
+	assert(linear.getCapacity() == 18 && linear.getSize() == 9 && linear[8] == 9);
+
+	Sequence<int> geometric(200, 10);
+	for (int i = 0; i < 201; i++) {
+		geometric.push_back(i);
+	}
+	assert(geometric.getCapacity() == 400 && geometric.back() == 200);
+	int block[1000] = {};
+	geometric.push_back(block, 1000);
+	assert(geometric.getCapacity() == 1201 && geometric.getSize() == 1201);
+
+	Sequence<int, std::allocator<int>, GeometricGrowth<3, 2>> factor(200, 10);
+	factor.push_back(block, 200);
+	factor.insertAt(0, 1);
+	assert(factor.getCapacity() == 300 && factor.front() == 1);
+
+	Sequence<int, std::allocator<int>, PageRoundedGrowth<>> paged(1, 1);
+	paged.push_back(1).push_back(2);
+	assert(paged.getCapacity() == 1024);
+	paged.reserve(1500);
+	assert(paged.getCapacity() == 2048 && paged[1] == 2);
+	Sequence<int, std::allocator<int>, PageRoundedGrowth<LinearGrowth, 64>> pagedLinear(16, 1);
+	pagedLinear.push_back(block, 16).push_back(0);
+	assert(pagedLinear.getCapacity() == 32);
+}
+
 void testFull() {
 	Sequence<double> seq(1, 2);
 	seq.push_front(2);
@@ -425,6 +495,53 @@ void testPushingAndPoppingFront() {
 	assert(seq.getSize() == 3);
 	seq.pop_front();
 	assert(seq.at(0) == 45 && seq.getSize() == 2);
+	seq.pop_front().pop_front().pop_front();
+	assert(seq.isEmpty());
+}
+
+void testDoubleEnded() {
+	// used as a queue the buffer does not grow, the freed front slots are reused
+	Sequence<int> queue(64, 64);
+	for (int i = 0; i < 10000; i++) {
+		queue.push_back(i);
+		if (queue.getSize() > 40) {
+			assert(queue.front() == i - 40);
+			queue.pop_front();
+		}
+	}
+	assert(queue.getCapacity() == 64 && queue.getSize() == 40 && queue.back() == 9999);
+
+	// every element is moved a bounded number of times, whichever end it is pushed to
+	Sequence<TrackedElement> seq(4, 1);
+	TrackedElement::reset();
+	for (int i = 0; i < 1000; i++) {
+		seq.push_front(TrackedElement(-i));
+		seq.push_back(TrackedElement(i));
+	}
+	assert(seq.getSize() == 2000 && seq.front().value == -999 && seq.back().value == 999);
+	assert(seq[999].value == 0 && seq[1000].value == 0);
+	assert(TrackedElement::moves < 2000 * 8);
+	for (int i = 0; i < 1000; i++) {
+		assert(seq[i].value == i - 999 && seq[1000 + i].value == i);
+	}
+
+	// removal and insertion in the middle keep the order whichever side moves
+	seq.removeAt(10).removeAt(1980).insertAt(5, TrackedElement(42)).insertAt(1990, TrackedElement(43));
+	assert(seq.getSize() == 2000 && seq[5].value == 42 && seq[1990].value == 43 && seq[10].value == -990 && seq[11].value == -988);
+	assert(seq[1980].value == 980 && seq[1981].value == 982 && seq.back().value == 999);
+
+	for (int i = 0; i < 1999; i++) {
+		seq.pop_front();
+	}
+	assert(seq.getSize() == 1 && seq.front().value == 999 && TrackedElement::alive == 1);
+	seq.push_front(TrackedElement(1)).push_back(TrackedElement(2));
+	assert(seq[0].value == 1 && seq[1].value == 999 && seq[2].value == 2);
+	seq.reserve(seq.getCapacity());
+	size_t capacity = seq.getCapacity();
+	while (seq.getSize() < capacity) {
+		seq.push_back(TrackedElement(0));
+	}
+	assert(seq.getCapacity() == capacity && seq.isFull());
 }
 
 void testPushingFrontSequences() {
@@ -440,9 +557,9 @@ void testPushingFrontSequences() {
 	Sequence<bool> c(new bool[] {false}, 1, 2, 10);
 	bool* d = new bool[] {true, false};
 	c.push_front(d, 2);
-	assert(c[0] == true && c[1] == false && c[2] == false && c.getSize() == 3 && c.getCapacity() == 13);
+	assert(c[0] == true && c[1] == false && c[2] == false && c.getSize() == 3 && c.getCapacity() == 12);
 	c.push_front(Sequence<bool>());
-	assert(c[0] == true && c[1] == false && c[2] == false && c.getSize() == 3 && c.getCapacity() == 13);
+	assert(c[0] == true && c[1] == false && c[2] == false && c.getSize() == 3 && c.getCapacity() == 12);
 	delete[] b;
 	delete[] d;
 }
@@ -460,9 +577,150 @@ void testPushingFrontArrays() {
 
 void testSizeInBytes() {
 	Sequence<int> seq(new int[] { 2, 4, 5, 5, 8 }, 5, 150, 10);
-	assert(seq.dataSizeInBytes() == 600 && seq.totalSizeInBytes() == 632);
+	assert(seq.dataSizeInBytes() == 600 && seq.totalSizeInBytes() == 648);
 	seq.reserve(200);
-	assert(seq.dataSizeInBytes() == 800 && seq.totalSizeInBytes() == 832);
+	assert(seq.dataSizeInBytes() == 800 && seq.totalSizeInBytes() == 848);
+}
+
+void testRawStorage() {
+	{
+		Sequence<TrackedElement> seq(100);
+		assert(TrackedElement::alive == 0);
+		seq.push_back(TrackedElement(1)).push_back(TrackedElement(2)).push_back(TrackedElement(3));
+		assert(TrackedElement::alive == 3);
+		seq.pop_back();
+		assert(TrackedElement::alive == 2 && seq.back().value == 2);
+		seq.insertAt(1, TrackedElement(7)).push_front(TrackedElement(0));
+		assert(TrackedElement::alive == 4 && seq[1].value == 1 && seq[2].value == 7);
+		seq.removeAt(2);
+		assert(TrackedElement::alive == 3 && seq[2].value == 2);
+		seq.resize(2);
+		assert(TrackedElement::alive == 2 && seq.getCapacity() == 2);
+		seq.push_back(TrackedElement(5));
+		assert(TrackedElement::alive == 3 && seq.getCapacity() == 102);
+
+		Sequence<TrackedElement> copy(seq);
+		assert(TrackedElement::alive == 6);
+		copy.push_front(copy).push_front(seq);
+		assert(TrackedElement::alive == 12 && copy.getSize() == 9);
+		assert(copy[0].value == 0 && copy[3].value == 0 && copy[8].value == 5);
+		copy = seq;
+		assert(TrackedElement::alive == 6 && copy == seq);
+		copy.clear();
+		assert(TrackedElement::alive == 3 && copy.getCapacity() == 102);
+	}
+	assert(TrackedElement::alive == 0);
+
+	Sequence<std::string> strings(4);
+	strings.push_back("a").push_back("b");
+	std::string front[] = {"x", "y", "z"};
+	strings.push_front(front, 3);
+	assert(strings.getSize() == 5 && strings[0] == "x" && strings[3] == "a" && strings[4] == "b");
+	strings.push_back(&strings[0], 3);
+	assert(strings.getSize() == 8 && strings[7] == "z");
+}
+
+struct RelocatableHandle {
+	int* counter;
+
+	explicit RelocatableHandle(int* counter) : counter(counter) { ++*counter; }
+	RelocatableHandle(const RelocatableHandle& other) : counter(other.counter) { ++*counter; }
+	RelocatableHandle& operator=(const RelocatableHandle& other) { counter = other.counter; return *this; }
+	~RelocatableHandle() { --*counter; }
+};
+
+template <>
+struct IsTriviallyRelocatable<RelocatableHandle> : std::true_type {};
+
+void testRelocation() {
+	Sequence<TrackedElement> seq(4);
+	for (int i = 0; i < 4; i++) {
+		seq.push_back(TrackedElement(i));
+	}
+	TrackedElement::reset();
+	seq.resize(50);
+	assert(TrackedElement::copies == 0 && TrackedElement::moves == 4);
+	TrackedElement::reset();
+	seq.removeAt(0);
+	assert(TrackedElement::copies == 0 && TrackedElement::moves == 0 && seq[0].value == 1);
+	TrackedElement::reset();
+	seq.insertAt(1, TrackedElement(9));
+	assert(TrackedElement::copies == 0 && seq[1].value == 9 && seq[2].value == 2 && seq[3].value == 3);
+	seq.insertAt(2, seq[0]);
+	assert(seq[2].value == 1 && seq.getSize() == 5);
+	TrackedElement::reset();
+	seq.pop_front();
+	assert(TrackedElement::copies == 0 && seq[0].value == 9);
+
+	int alive = 0;
+	{
+		Sequence<RelocatableHandle> handles(1, 1);
+		handles.push_back(RelocatableHandle(&alive)).push_back(RelocatableHandle(&alive)).push_back(RelocatableHandle(&alive));
+		assert(alive == 3);
+		handles.insertAt(1, RelocatableHandle(&alive)).removeAt(0).resize(20);
+		assert(alive == 3 && handles.getCapacity() == 20);
+	}
+	assert(alive == 0);
+
+	Sequence<std::string> strings(2, 1);
+	strings.push_back(std::string(100, 'a')).push_back(std::string(100, 'b'));
+	const char* buffer = strings[0].data();
+	strings.push_back(std::string(100, 'c'));
+	assert(strings[0].data() == buffer && strings[2][99] == 'c');
+}
+
+struct Point {
+	int x;
+	int y;
+
+	Point(int x, int y) : x(x), y(y) {}
+};
+
+void testEmplacing() {
+	Sequence<Point> points(2);
+	Point& added = points.emplace_back(1, 2);
+	assert(added.x == 1 && added.y == 2);
+	points.emplace_back(3, 4);
+	points.emplace_front(-1, 0);
+	assert(points.getSize() == 3 && points.front().x == -1 && points.back().y == 4);
+	assert(points.emplaceAt(1, 7, 7).x == 7 && points[2].x == 1);
+	assert(points.emplaceAt(4, 9, 9).y == 9 && points.getSize() == 5);
+
+	Sequence<TrackedElement> seq(1);
+	TrackedElement::reset();
+	seq.emplace_back(1);
+	seq.push_back(TrackedElement(2)).push_front(TrackedElement(0)).insertAt(3, TrackedElement(3));
+	seq.changeAt(0, TrackedElement(5));
+	assert(TrackedElement::copies == 0);
+	assert(seq[0].value == 5 && seq[1].value == 1 && seq[2].value == 2 && seq[3].value == 3);
+
+	seq.shrink_to_fit();
+	seq.push_back(seq[0]);
+	seq.emplace_back(seq[1]);
+	assert(seq.getSize() == 6 && seq[4].value == 5 && seq[5].value == 1);
+
+	Sequence<std::unique_ptr<int>> owners(1);
+	owners.push_back(std::make_unique<int>(1)).push_front(std::make_unique<int>(0));
+	owners.emplaceAt(1, new int(5));
+	owners.changeAt(2, std::make_unique<int>(2));
+	assert(*owners[0] == 0 && *owners[1] == 5 && *owners[2] == 2);
+	owners.removeAt(1);
+	assert(*owners[1] == 2 && owners.getSize() == 2);
+
+	Sequence<std::string> strings(1, 1);
+	std::string text(64, 'x');
+	const char* buffer = text.data();
+	strings.push_back(std::move(text));
+	assert(strings[0].data() == buffer);
+
+	bool exceptionThrown = false;
+	try {
+		strings.emplaceAt(5, "y");
+	}
+	catch (std::out_of_range&) {
+		exceptionThrown = true;
+	}
+	assert(exceptionThrown);
 }
 
 size_t testBasics() {
@@ -478,6 +736,7 @@ size_t testBasics() {
 	runTest(testResizing);
 	runTest(testReserving);
 	runTest(testRemoving);
+	runTest(testRemovingInBulk);
 	runTest(testInserting);
 	runTest(testCopying);
 	runTest(testConstObjects);
@@ -487,12 +746,17 @@ size_t testBasics() {
 	runTest(testPushingArray);
 	runTest(testFrontBack);
 	runTest(testCapacityGrowthStep);
+	runTest(testGrowthPolicies);
 	runTest(testPushingAndPoppingFront);
+	runTest(testDoubleEnded);
 	runTest(testFind);
 	runTest(testConcatination);
 	runTest(testPushingFrontSequences);
 	runTest(testPushingFrontArrays);
 	runTest(testSizeInBytes);
+	runTest(testRawStorage);
+	runTest(testRelocation);
+	runTest(testEmplacing);
 
 	return runTest(testCreation);
 }
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "../../include/SequenceBinary.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <io.h>
+#define SEQUENCE_TEST_FILENO _fileno
+#define SEQUENCE_TEST_LSEEK _lseek
+#else
+#include <unistd.h>
+#define SEQUENCE_TEST_FILENO fileno
+#define SEQUENCE_TEST_LSEEK lseek
+#endif
+
+// writes the numbers as decimal text, to check that an explicit codec replaces the raw block
+struct DecimalCodec {
+	size_t encoded = 0;
+
+	void encode(std::string& out, int value) {
+		out += std::to_string(value);
+		out += ';';
+		encoded++;
+	}
+	bool decode(const char*& cursor, const char* end, int& value) {
+		const char* stop = cursor;
+		while (stop < end && *stop != ';') {
+			stop++;
+		}
+		if (stop == end) {
+			return false;
+		}
+		value = std::stoi(std::string(cursor, stop));
+		cursor = stop + 1;
+		return true;
+	}
+};
+
+// overwrites the little-endian u64 header field at offset
+std::string withHeaderField(std::string bytes, size_t offset, uint64_t value) {
+	for (size_t i = 0; i < 8; i++) {
+		bytes[offset + i] = static_cast<char>(value >> (i * 8));
+	}
+	return bytes;
+}
+
+template <class Action>
+size_t formatErrorPosition(Action action) {
+	try {
+		action();
+	}
+	catch (const SequenceFormatError& error) {
+		return error.getPosition();
+	}
+	return static_cast<size_t>(-1);
+}
+
+void testBinaryRoundTrip() {
+	Sequence<int> numbers;
+	for (int i = 0; i < 1000; i++) {
+		numbers.push_back(i * 7 - 500);
+	}
+	numbers.pop_front();
+	std::stringstream stream;
+	writeBinary(stream, numbers);
+	std::string bytes = stream.str();
+	assert(bytes.size() == SequenceBinary::headerSize + 999 * sizeof(int) && bytes.compare(0, 4, "SEQB") == 0);
+
+	Sequence<int> loaded;
+	loaded.push_back(42);
+	loaded.enableIndex();
+	readBinary(stream, loaded);
+	assert(loaded == numbers && loaded.find(-493) == 0 && loaded.contains(6486) && !loaded.contains(42));
+
+	Sequence<std::string> words;
+	words.push_back("").push_back("short").push_back(std::string(300, 'x'));
+	std::stringstream text;
+	writeBinary(text, words);
+	Sequence<std::string> wordsBack;
+	readBinary(text, wordsBack);
+	assert(wordsBack == words && wordsBack[2].size() == 300);
+
+	Sequence<int> few;
+	few.push_back(12).push_back(-3);
+	std::stringstream decimal;
+	DecimalCodec codec;
+	writeBinary(decimal, few, codec);
+	assert(decimal.str().substr(SequenceBinary::headerSize) == "12;-3;");
+	Sequence<int> fewBack;
+	readBinary(decimal, fewBack, DecimalCodec());
+	assert(fewBack == few);
+
+	Sequence<int> empty(size_t(0), size_t(10));
+	std::stringstream nothing;
+	writeBinary(nothing, empty);
+	readBinary(nothing, fewBack);
+	assert(fewBack.isEmpty());
+}
+
+void testBinaryFileDescriptor() {
+	std::FILE* file = std::tmpfile();
+	assert(file != nullptr);
+	int fd = SEQUENCE_TEST_FILENO(file);
+
+	Sequence<double> values;
+	for (int i = 0; i < 5000; i++) {
+		values.push_back(i / 3.0);
+	}
+	Sequence<std::string> words;
+	words.push_back("alpha").push_back("beta");
+	writeBinary(fd, values);
+	writeBinary(fd, words);
+
+	SEQUENCE_TEST_LSEEK(fd, 0, SEEK_SET);
+	Sequence<double> valuesBack;
+	Sequence<std::string> wordsBack;
+	readBinary(fd, valuesBack);
+	readBinary(fd, wordsBack);
+	assert(valuesBack == values && wordsBack == words);
+
+	// nothing left to read
+	assert(formatErrorPosition([&] { readBinary(fd, valuesBack); }) == 0);
+	std::fclose(file);
+}
+
+void testBinaryErrors() {
+	Sequence<uint32_t> numbers;
+	numbers.push_back(0x01020304).push_back(0xA0B0C0D0);
+	std::stringstream stream;
+	writeBinary(stream, numbers);
+	const std::string bytes = stream.str();
+
+	std::string badMagic = bytes;
+	badMagic[0] = 'X';
+	Sequence<uint32_t> target;
+	assert(formatErrorPosition([&] { std::istringstream in(badMagic); readBinary(in, target); }) == 0);
+	assert(formatErrorPosition([&] { std::istringstream in(bytes); Sequence<uint16_t> shorts; readBinary(in, shorts); }) == 8);
+	assert(formatErrorPosition([&] { std::istringstream in(bytes); Sequence<std::string> words; readBinary(in, words); }) == 7);
+	assert(formatErrorPosition([&] { std::istringstream in(bytes.substr(0, 10)); readBinary(in, target); }) == 10);
+	assert(formatErrorPosition([&] { std::istringstream in(bytes.substr(0, 38)); readBinary(in, target); }) == 38);
+	assert(target.isEmpty());
+
+	std::string version = bytes;
+	version[4] = 9;
+	assert(formatErrorPosition([&] { std::istringstream in(version); readBinary(in, target); }) == 4);
+
+	// a payload from a machine of the other byte order is swapped while loading
+	std::string swapped = bytes;
+	swapped[6] = (swapped[6] == 1) ? 2 : 1;
+	std::istringstream in(swapped);
+	readBinary(in, target);
+	assert(target.getSize() == 2 && target[0] == 0x04030201 && target[1] == 0xD0C0B0A0);
+}
+
+void testBinaryCorruptHeader() {
+	// counts and payload sizes far beyond the input fail as truncated instead of allocating them up front
+	Sequence<uint32_t> numbers;
+	numbers.push_back(7).push_back(8);
+	std::stringstream stream;
+	writeBinary(stream, numbers);
+	const std::string bytes = stream.str();
+	const uint64_t huge = uint64_t(1) << 60;
+	Sequence<uint32_t> target;
+	target.enableIndex();
+	assert(formatErrorPosition([&] {
+		std::istringstream in(withHeaderField(withHeaderField(bytes, 16, huge), 24, huge * 4)); readBinary(in, target); }) == 40);
+	assert(target.isEmpty() && !target.contains(7));
+
+	std::FILE* file = std::tmpfile();
+	assert(file != nullptr);
+	int fd = SEQUENCE_TEST_FILENO(file);
+	const std::string corrupt = withHeaderField(withHeaderField(bytes, 16, huge), 24, huge * 4);
+	assert(std::fwrite(corrupt.data(), 1, corrupt.size(), file) == corrupt.size() && std::fflush(file) == 0);
+	SEQUENCE_TEST_LSEEK(fd, 0, SEEK_SET);
+	assert(formatErrorPosition([&] { readBinary(fd, target); }) == 40 && target.isEmpty());
+	std::fclose(file);
+
+	Sequence<std::string> words;
+	words.push_back("alpha").push_back("beta");
+	std::stringstream wordStream;
+	writeBinary(wordStream, words);
+	const std::string wordBytes = wordStream.str();
+	Sequence<std::string> wordsBack;
+	assert(formatErrorPosition([&] {
+		std::istringstream in(withHeaderField(wordBytes, 24, huge)); readBinary(in, wordsBack); }) == wordBytes.size());
+	assert(formatErrorPosition([&] {
+		std::istringstream in(withHeaderField(wordBytes, 16, huge)); readBinary(in, wordsBack); }) == wordBytes.size());
+	assert(wordsBack.isEmpty());
+
+	// codec payloads leave the element size at 0 and do not check it, sizeof(std::string) differs between libraries
+	assert(wordBytes[8] == 0 && wordBytes[9] == 0 && wordBytes[10] == 0 && wordBytes[11] == 0);
+	for (uint32_t foreignSize : { 24u, 40u }) {
+		std::string foreign = wordBytes;
+		for (size_t i = 0; i < 4; i++) {
+			foreign[8 + i] = static_cast<char>(foreignSize >> (i * 8));
+		}
+		std::istringstream in(foreign);
+		readBinary(in, wordsBack);
+		assert(wordsBack == words);
+	}
+
+	// a raw block of bool holds nothing but 0 and 1
+	Sequence<bool> flags;
+	flags.push_back(true).push_back(false).push_back(true);
+	std::stringstream flagStream;
+	writeBinary(flagStream, flags);
+	Sequence<bool> flagsBack;
+	std::istringstream flagIn(flagStream.str());
+	readBinary(flagIn, flagsBack);
+	assert(flagsBack == flags);
+	std::string badFlag = flagStream.str();
+	badFlag[SequenceBinary::headerSize + 1] = 2;
+	assert(formatErrorPosition([&] { std::istringstream in(badFlag); readBinary(in, flagsBack); }) == SequenceBinary::headerSize + 1);
+	assert(flagsBack.isEmpty());
+
+	enum class Color : uint8_t { red, green };
+	Sequence<Color> colors;
+	colors.push_back(Color::green).push_back(Color::red);
+	std::stringstream colorStream;
+	writeBinary(colorStream, colors);
+	Sequence<Color> colorsBack;
+	readBinary(colorStream, colorsBack);
+	assert(colorsBack == colors);
+}
+
+size_t testBinary() {
+	runTest(testBinaryRoundTrip);
+	runTest(testBinaryFileDescriptor);
+	runTest(testBinaryErrors);
+	return runTest(testBinaryCorruptHeader);
+}
@@ -0,0 +1,171 @@
+#include "../../include/ConcurrentSequence.h"
+#include "runTestMethods.h"
+#include "trackedElement.h"
+#include "cassert"
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// throws while constructing from a negative number
+struct PickyElement {
+	int value;
+
+	explicit PickyElement(int value) : value(value) {
+		if (value < 0) {
+			throw std::invalid_argument("negative");
+		}
+	}
+};
+
+void testConcurrentAppend() {
+	ConcurrentSequence<size_t> numbers;
+	const size_t threads = 8;
+	const size_t perThread = 20000;
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			for (size_t i = 0; i < perThread; i++) {
+				if (i % 100 == 0) {
+					size_t first = numbers.grow_by(10, t * perThread + i);
+					for (size_t k = 1; k < 10; k++) {
+						assert(numbers[first + k] == t * perThread + i);
+					}
+				}
+				else {
+					size_t index = numbers.push_back(t * perThread + i);
+					assert(numbers[index] == t * perThread + i);
+				}
+			}
+		});
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	// every value was appended once, the grow_by ones ten times
+	size_t expected = threads * perThread + threads * (perThread / 100) * 9;
+	assert(numbers.getSize() == expected && numbers.getCapacity() >= expected);
+	std::vector<size_t> seen(threads * perThread, 0);
+	for (size_t i = 0; i < numbers.getSize(); i++) {
+		assert(numbers.isPublished(i));
+		seen[numbers.at(i)]++;
+	}
+	for (size_t value = 0; value < seen.size(); value++) {
+		assert(seen[value] == ((value % perThread) % 100 == 0 ? 10u : 1u));
+	}
+	assert(!numbers.isPublished(numbers.getSize()));
+	bool outOfRange = false;
+	try {
+		(void)numbers.at(numbers.getSize());
+	}
+	catch (const std::out_of_range&) {
+		outOfRange = true;
+	}
+	assert(outOfRange);
+
+	// counts past maxSize are refused before any index is reserved
+	size_t before = numbers.getSize();
+	size_t refused = 0;
+	for (size_t count : { ConcurrentSequence<size_t>::maxSize + 1, ConcurrentSequence<size_t>::maxSize - before + 1, size_t(-1) }) {
+		try {
+			(void)numbers.grow_by(count);
+		}
+		catch (const std::bad_array_new_length&) {
+			refused++;
+		}
+	}
+	try {
+		numbers.reserve(ConcurrentSequence<size_t>::maxSize + 1);
+	}
+	catch (const std::bad_array_new_length&) {
+		refused++;
+	}
+	assert(refused == 4 && numbers.getSize() == before && numbers.push_back(7) == before);
+}
+
+void testConcurrentReaders() {
+	ConcurrentSequence<std::string> words;
+	std::string& first = words.emplace_back(40, 'a');
+	std::atomic<bool> done = false;
+	std::atomic<size_t> checked = 0;
+
+	// readers only look at published indices while the writers keep adding segments
+	std::thread reader([&] {
+		while (!done.load()) {
+			size_t size = words.getSize();
+			for (size_t i = size > 50 ? size - 50 : 0; i < size; i++) {
+				if (words.isPublished(i)) {
+					assert(words[i].size() == 40);
+					checked++;
+				}
+			}
+		}
+	});
+	std::vector<std::thread> writers;
+	for (int t = 0; t < 4; t++) {
+		writers.emplace_back([&, t] {
+			for (int i = 0; i < 5000; i++) {
+				words.emplace_back(40, static_cast<char>('b' + t));
+			}
+		});
+	}
+	for (std::thread& writer : writers) {
+		writer.join();
+	}
+	done = true;
+	reader.join();
+
+	// segments never move
+	assert(&first == &words[0] && first == std::string(40, 'a') && words.getSize() == 20001);
+	words.clear();
+	assert(words.isEmpty() && words.getCapacity() == 0);
+	words.reserve(1000);
+	assert(words.getCapacity() >= 1000 && words.isEmpty());
+	words.push_back("again");
+	size_t blank = words.grow_by(2);
+	assert(words.at(0) == "again" && blank == 1 && words[2].empty() && words.getSize() == 3);
+}
+
+void testConcurrentLifetimes() {
+	TrackedElement::alive = 0;
+	{
+		ConcurrentSequence<TrackedElement> tracked;
+		for (int i = 0; i < 1000; i++) {
+			tracked.emplace_back(i);
+		}
+		TrackedElement copy(7);
+		tracked.grow_by(300, copy);
+		assert(TrackedElement::alive == 1301 && tracked[1299].value == 7);
+	}
+	assert(TrackedElement::alive == 0);
+
+	// a throwing constructor leaves its index unpublished and the other appends unaffected
+	ConcurrentSequence<PickyElement> picky;
+	picky.emplace_back(1);
+	bool thrown = false;
+	try {
+		picky.emplace_back(-1);
+	}
+	catch (const std::invalid_argument&) {
+		thrown = true;
+	}
+	picky.emplace_back(3);
+	assert(thrown && picky.getSize() == 3 && !picky.isPublished(1) && picky.at(2).value == 3);
+	bool unpublished = false;
+	try {
+		(void)picky.at(1);
+	}
+	catch (const std::out_of_range&) {
+		unpublished = true;
+	}
+	assert(unpublished);
+}
+
+size_t testConcurrentSequence() {
+	runTest(testConcurrentAppend);
+	runTest(testConcurrentReaders);
+	return runTest(testConcurrentLifetimes);
+}
@@ -0,0 +1,132 @@
+#include "../../include/CowSequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+void testSharingAndDetaching() {
+	CowSequence<int>::resetStatistics();
+	CowSequence<int> original;
+	for (int i = 0; i < 10; i++) {
+		original.push_back(i);
+	}
+	CowSequence<int> copy = original;
+	CowSequence<int> another;
+	another = copy;
+	assert(original.useCount() == 3 && copy.isShared() && std::as_const(original).data() == std::as_const(copy).data()
+		&& std::as_const(another).data() == std::as_const(copy).data());
+
+	// reading through const references keeps sharing
+	const CowSequence<int>& view = copy;
+	assert(view[3] == 3 && view.at(9) == 9 && view.contains(5) && view.slice(2, 4).back() == 3);
+	assert(copy.useCount() == 3 && CowSequence<int>::statistics().detaches == 0);
+
+	copy.push_back(10);
+	assert(copy.getSize() == 11 && original.getSize() == 10 && !copy.isShared() && original.useCount() == 2);
+	assert(std::as_const(copy).data() != std::as_const(original).data() && CowSequence<int>::statistics().detaches == 1);
+	copy.changeAt(0, -1).push_back(11);
+	assert(copy[0] == -1 && std::as_const(original)[0] == 0 && CowSequence<int>::statistics().detaches == 1);
+
+	// changes that find nothing to change do not copy
+	another.removeAll(42);
+	another.changeAll(42, 0);
+	assert(std::as_const(another).data() == std::as_const(original).data());
+	another[0] = 7;
+	assert(another[0] == 7 && std::as_const(original)[0] == 0 && !original.isShared());
+
+	CowSequence<int>::Statistics statistics = CowSequence<int>::statistics();
+	assert(statistics.sharedCopies == 2 && statistics.detaches == 2);
+}
+
+void testCowLifetime() {
+	Sequence<std::string> words;
+	words.push_back("alpha").push_back("beta");
+	CowSequence<std::string> first(words);
+	CowSequence<std::string> second(first);
+	CowSequence<std::string> moved(std::move(second));
+	assert(second.useCount() == 0 && second.isEmpty() && moved.useCount() == 2 && moved == first);
+
+	// a moved-from sequence is usable again
+	second.push_back("gamma");
+	assert(second.getSize() == 1 && second.front() == "gamma" && first.useCount() == 2);
+
+	moved.clear();
+	assert(moved.isEmpty() && first.getSize() == 2 && first.useCount() == 1);
+	CowSequence<std::string>& alias = first;
+	first = alias;
+	assert(first.useCount() == 1 && first.back() == "beta");
+	first.edit().push_back("delta");
+	assert(first.asSequence().getSize() == 3 && first != moved);
+}
+
+void testCowAcrossThreads() {
+	CowSequence<int> source;
+	for (int i = 0; i < 1000; i++) {
+		source.push_back(i);
+	}
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([&source, t] {
+			for (int i = 0; i < 1000; i++) {
+				CowSequence<int> copy = source;
+				assert(static_cast<const CowSequence<int>&>(copy)[i] == i);
+				if (i % 100 == 0) {
+					copy.push_back(t);
+					assert(copy.getSize() == 1001 && copy.back() == t);
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	assert(source.useCount() == 1 && source.getSize() == 1000 && source.back() == 999);
+}
+
+void testCowLeakedReferences() {
+	CowSequence<int> a;
+	a.push_back(1).push_back(2).push_back(3);
+	int& r = a[0];
+	CowSequence<int> b = a;
+	r = 77;
+	assert(std::as_const(b)[0] == 1 && std::as_const(a)[0] == 77 && !a.isShared() && !b.isShared());
+	int* it = a.begin();
+	CowSequence<int> c;
+	c = a;
+	*it = 5;
+	a.back() = 9;
+	assert(std::as_const(c)[0] == 77 && std::as_const(c)[2] == 3 && std::as_const(a)[0] == 5);
+	a.edit().push_back(4);
+	CowSequence<int> d = a;
+	assert(!d.isShared() && d.getSize() == 4);
+
+	// clearing makes the buffer sharable again; b has its own buffer and never handed out a reference
+	a.clear();
+	a.push_back(8);
+	CowSequence<int> e = a;
+	assert(e.isShared() && e.useCount() == 2);
+	CowSequence<int> f = b;
+	assert(f.isShared() && std::as_const(f)[0] == 1);
+}
+
+void testCowMovedFromKeepsSettings() {
+	std::pmr::monotonic_buffer_resource resource;
+	using PmrCow = CowSequence<int, std::pmr::polymorphic_allocator<int>>;
+	PmrCow source(10, 7, std::pmr::polymorphic_allocator<int>(&resource));
+	source.push_back(1);
+	PmrCow target(std::move(source));
+	source.push_back(2);
+	assert(source.asSequence().getAllocator().resource() == &resource && source.asSequence().getCapacityGrowthStep() == 7);
+	assert(target.getSize() == 1 && source.getSize() == 1);
+}
+
+size_t testCowSequence() {
+	runTest(testSharingAndDetaching);
+	runTest(testCowLifetime);
+	runTest(testCowLeakedReferences);
+	runTest(testCowMovedFromKeepsSettings);
+	return runTest(testCowAcrossThreads);
+}
@@ -0,0 +1,196 @@
+#include "../../include/SmallSequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// every lookup through the index agrees with a scan of the same elements
+template <class type>
+void assertIndexMatchesScan(const Sequence<type>& indexed, const type& value) {
+	Sequence<type> plain(indexed);
+	plain.disableIndex();
+	assert(indexed.find(value) == plain.find(value));
+	assert(indexed.findLast(value) == plain.findLast(value));
+	assert(indexed.contains(value) == plain.contains(value));
+	assert(indexed.containsLotsOf(value) == plain.containsLotsOf(value));
+}
+
+void testIndexLookups() {
+	Sequence<int> seq;
+	for (int i = 0; i < 50; i++) {
+		seq.push_back(i % 7);
+	}
+	size_t withoutIndex = seq.totalSizeInBytes();
+	seq.enableIndex();
+	assert(seq.hasIndex() && seq.totalSizeInBytes() > withoutIndex);
+	assert(seq.find(3) == 3 && seq.findFirst(3) == 3 && seq.findLast(3) == 45 && seq.containsLotsOf(3) == 7);
+	assert(!seq.contains(7) && seq.find(7) == 50 && seq.findLast(7) == 50 && seq.containsLotsOf(7) == 0);
+
+	seq.push_back(7).push_front(7);
+	assert(seq.find(7) == 0 && seq.findLast(7) == 51 && seq.containsLotsOf(7) == 2 && seq.find(0) == 1);
+	seq.pop_front();
+	assert(seq.find(7) == 50 && seq.find(0) == 0 && seq.findLast(6) == 48);
+	seq.insertAt(10, 100).insertAt(0, 100);
+	assert(seq.find(100) == 0 && seq.findLast(100) == 11 && seq.find(3) == 4 && seq.findLast(3) == 47);
+	seq.removeAt(11).removeAt(0);
+	assert(!seq.contains(100) && seq.find(3) == 3 && seq.findLast(3) == 45);
+	seq.changeAt(3, 8).changeAt(45, 8);
+	assert(seq.find(3) == 10 && seq.findLast(3) == 38 && seq.containsLotsOf(3) == 5 && seq.find(8) == 3 && seq.findLast(8) == 45);
+	seq.changeAt(0, seq[1]);
+	assert(seq.containsLotsOf(1) == 8 && seq.find(0) == 7);
+	seq.pop_back();
+	assert(!seq.contains(7) && seq.getSize() == 50);
+
+	seq.clear();
+	assert(seq.hasIndex() && !seq.contains(0) && seq.find(0) == 0);
+	seq.push_back(5);
+	assert(seq.find(5) == 0 && seq.containsLotsOf(5) == 1);
+	seq.disableIndex();
+	assert(!seq.hasIndex() && seq.totalSizeInBytes() == withoutIndex);
+}
+
+void testIndexAgainstScan() {
+	std::mt19937 random(21);
+	Sequence<int> seq;
+	seq.enableIndex();
+	for (int step = 0; step < 4000; step++) {
+		int value = static_cast<int>(random() % 40);
+		size_t position = seq.isEmpty() ? 0 : random() % seq.getSize();
+		switch (random() % 8) {
+		case 0:
+		case 1:
+			seq.push_back(value);
+			break;
+		case 2:
+			seq.push_front(value);
+			break;
+		case 3:
+			seq.insertAt(position, value);
+			break;
+		case 4:
+			if (!seq.isEmpty()) {
+				seq.removeAt(position);
+			}
+			break;
+		case 5:
+			if (!seq.isEmpty()) {
+				seq.changeAt(position, value);
+			}
+			break;
+		case 6:
+			(random() % 2 == 0) ? seq.pop_back() : seq.pop_front();
+			break;
+		default:
+			seq.emplaceAt(position, value);
+			break;
+		}
+		assertIndexMatchesScan(seq, value);
+	}
+	for (int value = -1; value <= 40; value++) {
+		assertIndexMatchesScan(seq, value);
+	}
+}
+
+void testIndexRebuilds() {
+	Sequence<std::string> words;
+	words.enableIndex();
+	words.push_back("b").push_back("a").push_back("c").push_back("a");
+	words.sort();
+	assert(words.find("a") == 0 && words.findLast("a") == 1 && words.find("c") == 3);
+	words.removeAll("a");
+	assert(!words.contains("a") && words.find("b") == 0);
+	words.changeAll("c", "b");
+	assert(words.containsLotsOf("b") == 2 && words.findLast("b") == 1);
+	words.transform(std::execution::seq, [](const std::string& word) { return word + word; });
+	assert(words.containsLotsOf("bb") == 2 && !words.contains("b"));
+	Sequence<std::string> more;
+	more.push_back("x").push_back("bb");
+	words.push_back(more).push_front(more);
+	assert(words.find("bb") == 1 && words.findLast("bb") == 5 && words.find("x") == 0 && words.findLast("x") == 4);
+	words.resize(3);
+	assert(words.findLast("bb") == 2 && words.contains("x") && words.containsLotsOf("x") == 1);
+
+	// writes through references and iterators are seen by the next lookup
+	words[0] = "y";
+	assert(words.find("y") == 0 && !words.contains("x"));
+
+	Sequence<std::string> copy(words);
+	assert(copy.hasIndex() && copy.find("y") == 0);
+	Sequence<std::string> moved(std::move(words));
+	assert(moved.hasIndex() && !words.hasIndex() && moved.find("y") == 0);
+	Sequence<std::string> plain;
+	copy = plain;
+	assert(!copy.hasIndex());
+	copy = moved;
+	Sequence<std::string> other;
+	other.push_back("z");
+	other.enableIndex();
+	moved.swap(other);
+	assert(moved.find("z") == 0 && other.find("y") == 0 && other.hasIndex());
+	other = copy;
+	assert(other.hasIndex() && other.find("y") == 0 && other.containsLotsOf("bb") == 2);
+
+	SmallSequence<int, 4> small;
+	small.enableIndex();
+	small.push_back(1).push_back(2).push_back(3).push_back(4).push_back(2);
+	assert(!small.isInline() && small.findLast(2) == 4);
+	SmallSequence<int, 4> stolen(std::move(small));
+	assert(stolen.hasIndex() && stolen.containsLotsOf(2) == 2 && stolen.totalSizeInBytes() > sizeof(stolen) + stolen.dataSizeInBytes());
+	stolen.resize(2);
+	assert(stolen.findLast(2) == 1 && !stolen.contains(3));
+}
+
+void testIndexMutableAccess() {
+	Sequence<int> seq;
+	for (int i = 9; i >= 0; i--) {
+		seq.push_back(i);
+	}
+	seq.enableIndex();
+	std::sort(seq.begin(), seq.end());
+	assert(seq.find(0) == 0 && seq.findLast(9) == 9);
+	seq[3] = 42;
+	assert(seq.contains(42) && !seq.contains(3));
+	seq.at(4) = 42;
+	seq.front() = 7;
+	seq.back() = 7;
+	assert(seq.containsLotsOf(42) == 2 && seq.find(7) == 0 && seq.findLast(7) == 9 && !seq.contains(0));
+	*seq.data() = 5;
+	for (int& value : seq) {
+		value++;
+	}
+	assert(seq.find(6) == 0 && seq.containsLotsOf(43) == 2 && seq.findLast(8) == 9);
+
+	// so are writes through the references the emplace functions return
+	seq.emplace_back(42) = 77;
+	assert(seq.contains(77) && seq.containsLotsOf(43) == 2 && seq.findLast(77) == 10);
+	seq.emplace_front(42) = 78;
+	assert(seq.find(78) == 0 && seq.containsLotsOf(42) == 0);
+	seq.emplaceAt(3, 5) = 99;
+	assert(seq.find(99) == 3 && seq.containsLotsOf(5) == 0 && seq.getSize() == 13);
+	seq.emplaceAt(13, 5) = 98;
+	assert(seq.findLast(98) == 13 && !seq.contains(5));
+	seq.pop_front().removeAt(2).pop_back().pop_back();
+
+	// const lookups on a stale index from several threads: one rebuilds, the others wait for it
+	seq.sort();
+	const Sequence<int>& shared = seq;
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 4; t++) {
+		readers.emplace_back([&shared] {
+			assert(shared.contains(43) && shared.find(6) == 2 && shared.containsLotsOf(43) == 2);
+		});
+	}
+	for (std::thread& reader : readers) {
+		reader.join();
+	}
+}
+
+size_t testIndex() {
+	runTest(testIndexLookups);
+	runTest(testIndexAgainstScan);
+	runTest(testIndexRebuilds);
+	return runTest(testIndexMutableAccess);
+}
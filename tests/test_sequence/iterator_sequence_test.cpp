@@ -0,0 +1,87 @@
+#include "../../include/SortedSequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <string>
+
+static_assert(std::contiguous_iterator<Sequence<int>::iterator>);
+static_assert(std::contiguous_iterator<Sequence<int>::const_iterator>);
+static_assert(std::ranges::contiguous_range<Sequence<int>> && std::ranges::sized_range<Sequence<int>>);
+static_assert(std::ranges::contiguous_range<const Sequence<std::string>> && std::ranges::sized_range<const Sequence<std::string>>);
+static_assert(std::ranges::contiguous_range<SortedSequence<int>> && std::ranges::sized_range<SortedSequence<int>>);
+static_assert(std::is_same_v<std::ranges::range_reference_t<SortedSequence<int>>, const int&>);
+
+void testIterating() {
+	Sequence<int> seq;
+	assert(seq.begin() == seq.end() && seq.cbegin() == seq.cend() && seq.rbegin() == seq.rend());
+	for (int i = 1; i <= 10; i++) {
+		seq.push_back(i);
+	}
+	int sum = 0;
+	for (int value : seq) {
+		sum += value;
+	}
+	assert(sum == 55 && std::ranges::size(seq) == 10 && seq.end() - seq.begin() == 10);
+	assert(seq.data() == &seq[0] && std::ranges::data(seq) == seq.data());
+
+	for (int& value : seq) {
+		value *= 2;
+	}
+	assert(seq[9] == 20 && *seq.rbegin() == 20 && *(seq.rend() - 1) == 2 && *seq.crbegin() == 20);
+
+	// the front gap moves begin() with the first element
+	seq.pop_front();
+	assert(*seq.begin() == 4 && seq.begin() == seq.data() && std::ranges::size(seq) == 9);
+
+	const Sequence<int>& view = seq;
+	Sequence<int> reversed;
+	for (auto it = view.rbegin(); it != view.rend(); ++it) {
+		reversed.push_back(*it);
+	}
+	assert(reversed[0] == 20 && reversed[8] == 4);
+}
+
+void testAlgorithms() {
+	Sequence<int> seq;
+	for (int i = 0; i < 100; i++) {
+		seq.push_back((i * 37) % 100);
+	}
+	std::ranges::sort(seq);
+	assert(std::ranges::is_sorted(seq) && seq[0] == 0 && seq[99] == 99);
+	assert(std::accumulate(seq.cbegin(), seq.cend(), 0) == 4950);
+	assert(*std::ranges::max_element(seq) == 99 && std::ranges::count_if(seq, [](int value) { return value % 2 == 0; }) == 50);
+	std::reverse(seq.begin(), seq.end());
+	assert(seq[0] == 99);
+	std::sort(std::execution::par, seq.begin(), seq.end());
+	assert(seq[0] == 0);
+
+	auto evens = seq | std::views::filter([](int value) { return value % 2 == 0; }) | std::views::take(3);
+	Sequence<int> taken;
+	for (int value : evens) {
+		taken.push_back(value);
+	}
+	assert(taken.getSize() == 3 && taken[2] == 4);
+
+	std::span<int> span(seq);
+	span[0] = -1;
+	assert(span.size() == 100 && seq[0] == -1);
+	std::span<const int> constSpan(static_cast<const Sequence<int>&>(seq));
+	assert(constSpan.back() == 99);
+
+	SortedSequence<std::string> words;
+	words.push_back("pear").push_back("fig").push_back("apple");
+	std::string joined;
+	for (const std::string& word : words) {
+		joined += word;
+	}
+	assert(joined == "applefigpear" && *words.rbegin() == "pear" && std::ranges::binary_search(words, std::string("fig")));
+}
+
+size_t testIterators() {
+	runTest(testIterating);
+	return runTest(testAlgorithms);
+}
@@ -0,0 +1,113 @@
+#include "../../include/SortedSequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+static_assert(std::ranges::input_range<FilteredView<SequenceView<int>, bool(*)(int)>>);
+static_assert(std::is_same_v<MappedView<SequenceView<int>, std::string(*)(int)>::value_type, std::string>);
+
+void testFilterMapTake() {
+	Sequence<int> seq;
+	for (int i = 0; i < 20; i++) {
+		seq.push_back(i);
+	}
+	size_t calls = 0;
+	auto odd = [&calls](int value) { calls++; return value % 2 == 1; };
+	auto squares = seq.filtered(odd).mapped([](int value) { return value * value; }).take(4);
+	// nothing runs until the view is walked
+	assert(calls == 0);
+
+	int expected[] = { 1, 9, 25, 49 };
+	size_t i = 0;
+	for (int value : squares) {
+		assert(value == expected[i++]);
+	}
+	assert(i == 4 && calls == 8);
+
+	Sequence<int> collected = squares.collect();
+	assert(collected.getSize() == 4 && collected.getCapacity() == 4 && collected[3] == 49);
+	assert(seq.filtered(odd).count() == 10 && seq.mapped([](int value) { return value; }).count() == 20);
+
+	Sequence<std::string> names = seq.drop(17).mapped([](int value) { return std::to_string(value); }).collect();
+	assert(names.getSize() == 3 && names.getCapacity() == 3 && names[0] == "17" && names[2] == "19");
+
+	// drop and take on lazy views skip and stop without touching the rest
+	Sequence<int> middle = seq.filtered([](int value) { return value % 5 == 0; }).drop(1).take(2).collect();
+	assert(middle.getSize() == 2 && middle[0] == 5 && middle[1] == 10);
+	assert(seq.filtered([](int value) { return value > 100; }).collect().isEmpty());
+	assert(seq.take(100).getSize() == 20 && seq.drop(100).isEmpty() && seq.take(3).back() == 2);
+}
+
+void testChunked() {
+	Sequence<int> seq;
+	for (int i = 1; i <= 10; i++) {
+		seq.push_back(i);
+	}
+	Sequence<int> sums = seq.chunked(3).mapped([](SequenceView<int> chunk) {
+		int sum = 0;
+		for (int value : chunk) {
+			sum += value;
+		}
+		return sum;
+	}).collect();
+	assert(sums.getSize() == 4 && sums[0] == 6 && sums[1] == 15 && sums[2] == 24 && sums[3] == 10);
+	assert(seq.chunked(5).count() == 2 && seq.chunked(20).count() == 1 && Sequence<int>().chunked(4).count() == 0);
+
+	size_t chunks = 0;
+	for (SequenceView<int> chunk : seq.chunked(4)) {
+		assert(chunk.data() == seq.data() + chunks * 4 && chunk.getSize() == ((chunks < 2) ? 4u : 2u));
+		chunks++;
+	}
+	assert(chunks == 3);
+
+	bool thrown = false;
+	try { (void)seq.chunked(0); }
+	catch (const std::invalid_argument&) { thrown = true; }
+	assert(thrown);
+
+	SortedSequence<int> sorted;
+	sorted.insert(4);
+	sorted.insert(2);
+	sorted.insert(9);
+	Sequence<int> big = sorted.filtered([](int value) { return value > 3; }).collect();
+	assert(big.getSize() == 2 && big[0] == 4 && big[1] == 9);
+}
+
+void testMappedBeforeFiltered() {
+	Sequence<int> seq;
+	for (int i = 0; i < 10; i++) {
+		seq.push_back(i);
+	}
+	size_t calls = 0;
+	auto evenSquares = seq.mapped([&calls](int value) { calls++; return value * value; })
+		.filtered([](int square) { return square % 2 == 0; });
+	// the mapped function runs once per source element, whether the view is counted, walked or collected
+	assert(evenSquares.count() == 5 && calls == 10);
+	calls = 0;
+	int sum = 0;
+	for (int square : evenSquares) {
+		sum += square;
+	}
+	assert(sum == 120 && calls == 10);
+	calls = 0;
+	Sequence<int> collected = evenSquares.collect();
+	assert(calls == 10 && collected.getSize() == 5 && collected.getCapacity() == 5 && collected[4] == 64);
+
+	// the allocator and growth policy of the result are chosen by the caller
+	std::pmr::monotonic_buffer_resource resource;
+	auto words = seq.filtered([](int value) { return value > 6; }).mapped([](int value) { return std::to_string(value); })
+		.collect<LinearGrowth>(std::pmr::polymorphic_allocator<int>(&resource));
+	static_assert(std::is_same_v<decltype(words), Sequence<std::string, std::pmr::polymorphic_allocator<std::string>, LinearGrowth>>);
+	assert(words.getSize() == 3 && words[0] == "7" && words.getAllocator().resource() == &resource);
+	Sequence<int, std::allocator<int>, LinearGrowth> tail = seq.drop(8).collect<LinearGrowth>();
+	assert(tail.getSize() == 2 && tail.getCapacity() == 2 && tail[1] == 9);
+}
+
+size_t testLazyViews() {
+	runTest(testFilterMapTake);
+	runTest(testMappedBeforeFiltered);
+	return runTest(testChunked);
+}
@@ -1,8 +1,40 @@
 size_t testBasics();
 size_t testOperators();
+size_t testAllocators();
+size_t testSmallSequence();
+size_t testSimdSearch();
+size_t testParallel();
+size_t testSorting();
+size_t testSortedSequence();
+size_t testIndex();
+size_t testIterators();
+size_t testViews();
+size_t testLazyViews();
+size_t testCowSequence();
+size_t testBinary();
+size_t testMappedSequence();
+size_t testText();
+size_t testConcurrentSequence();
+size_t testQueues();
 
 
 size_t testSequence() {
 	testBasics();
-	return testOperators();
+	testOperators();
+	testAllocators();
+	testSmallSequence();
+	testSimdSearch();
+	testParallel();
+	testSorting();
+	testSortedSequence();
+	testIndex();
+	testIterators();
+	testViews();
+	testLazyViews();
+	testCowSequence();
+	testBinary();
+	testMappedSequence();
+	testText();
+	testConcurrentSequence();
+	return testQueues();
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "../../include/MappedSequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <type_traits>
+
+std::string mappedTestPath(const char* name) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+	std::filesystem::remove(path);
+	return path.string();
+}
+
+template <class Mapped>
+concept MappedModifiable = requires (Mapped& mapped, typename Mapped::value_type value) {
+	mapped.push_back(value);
+	mapped.clear();
+	mapped.reserve(1);
+};
+
+// a read-only mapping has no modifiers and its accessors hand out const references
+static_assert(MappedModifiable<MappedSequence<int>> && !MappedModifiable<MappedSequence<const int>>);
+static_assert(std::is_same_v<decltype(std::declval<MappedSequence<const int>&>()[0]), const int&>);
+static_assert(std::is_same_v<MappedSequence<const int>::iterator, const int*> && MappedSequence<const int>::isReadOnly());
+
+template <class Action>
+bool throwsLogicError(Action action) {
+	try {
+		action();
+	}
+	catch (const std::logic_error&) {
+		return true;
+	}
+	return false;
+}
+
+void testMappedGrowth() {
+	std::string path = mappedTestPath("sequence_mapped_growth.seqb");
+	size_t written = 0;
+	{
+		MappedSequence<int> numbers(path);
+		assert(numbers.isEmpty() && numbers.isOpen() && !numbers.isReadOnly() && numbers.getCapacity() > 0);
+		size_t firstCapacity = numbers.getCapacity();
+		for (int i = 0; i < 100000; i++) {
+			numbers.push_back(i * 3);
+		}
+		assert(numbers.getSize() == 100000 && numbers.getCapacity() > firstCapacity);
+		assert(numbers.find(300) == 100 && numbers.findLast(299997) == 99999 && !numbers.contains(1));
+		assert(numbers.at(5) == 15 && numbers.front() == 0 && numbers.back() == 299997);
+
+		// pushing an element of the mapping itself while the mapping moves
+		while (numbers.getSize() < numbers.getCapacity()) {
+			numbers.push_back(-1);
+		}
+		numbers.push_back(numbers[7]);
+		assert(numbers.back() == 21);
+		numbers.push_back(numbers.data(), 3);
+		assert(numbers.last(3) == numbers.first(3));
+		numbers.pop_back();
+
+		numbers.reserve(numbers.getSize() + 1000);
+		size_t reserved = numbers.getCapacity();
+		bool tooBig = false;
+		try {
+			numbers.reserve(MappedSequence<int>::maxCapacity + 1);
+		}
+		catch (const std::bad_array_new_length&) {
+			tooBig = true;
+		}
+		assert(tooBig && numbers.getCapacity() == reserved);
+		numbers.advise(AccessHint::Sequential);
+		numbers.sync();
+		written = numbers.getSize();
+	}
+	// closing trims the spare capacity off the file
+	assert(std::filesystem::file_size(path) == SequenceBinary::headerSize + written * sizeof(int));
+
+	MappedSequence<int> reopened(path);
+	assert(reopened.getSize() == written && reopened.getCapacity() == written);
+	assert(reopened[written - 1] == 3 && reopened[written - 3] == 21);
+	reopened.clear();
+	reopened.push_back(1).push_back(2);
+	reopened.close();
+	assert(!reopened.isOpen() && std::filesystem::file_size(path) == SequenceBinary::headerSize + 2 * sizeof(int));
+	assert(throwsLogicError([&] { reopened.push_back(3); }) && throwsLogicError([&] { reopened.clear(); }));
+	std::filesystem::remove(path);
+}
+
+void testMappedReadOnly() {
+	std::string path = mappedTestPath("sequence_mapped_read_only.seqb");
+	Sequence<double> values;
+	for (int i = 0; i < 2000; i++) {
+		values.push_back(i / 4.0);
+	}
+	{
+		std::ofstream out(path, std::ios::binary);
+		writeBinary(out, values);
+	}
+
+	MappedSequence<const double> mapped(path);
+	mapped.advise(AccessHint::Random);
+	mapped.advise(AccessHint::WillNeed);
+	assert(mapped.isReadOnly() && mapped.getSize() == 2000 && SequenceView<double>(mapped) == values.slice(0, 2000));
+	assert(mapped.contains(499.75) && mapped.find(1.5) == 6 && mapped.containsLotsOf(2.0) == 1);
+	assert(mapped[6] == 1.5 && mapped.at(1) == 0.25 && mapped.front() == 0.0 && mapped.back() == 499.75);
+	assert(*(mapped.end() - 2) == 499.5 && std::find(mapped.begin(), mapped.end(), 2.0) == mapped.data() + 8);
+	double sum = 0;
+	for (double value : mapped) {
+		sum += value;
+	}
+	assert(sum == 1999.0 * 2000 / 8);
+
+	// the mapped file is writeBinary output, so readBinary loads a file written through the mapping
+	MappedSequence<const double> moved(std::move(mapped));
+	assert(!mapped.isOpen() && moved.getSize() == 2000);
+	moved.close();
+	{
+		MappedSequence<double> writable(path);
+		writable.push_back(-1.0);
+	}
+	std::ifstream in(path, std::ios::binary);
+	Sequence<double> loaded;
+	readBinary(in, loaded);
+	assert(loaded.getSize() == 2001 && loaded[2000] == -1.0 && loaded[4] == 1.0);
+	in.close();
+
+	bool missing = false;
+	try {
+		MappedSequence<const double> none(mappedTestPath("sequence_mapped_missing.seqb"));
+	}
+	catch (const std::system_error&) {
+		missing = true;
+	}
+	bool wrongType = false;
+	try {
+		MappedSequence<const float> floats(path);
+	}
+	catch (const SequenceFormatError& error) {
+		wrongType = error.getPosition() == 8;
+	}
+	assert(missing && wrongType);
+	std::filesystem::remove(path);
+
+	// a bool file is checked for bytes that are not 0 or 1 when it is opened
+	std::string flagPath = mappedTestPath("sequence_mapped_flags.seqb");
+	{
+		Sequence<bool> flags;
+		flags.push_back(true).push_back(false);
+		std::ofstream out(flagPath, std::ios::binary);
+		writeBinary(out, flags);
+		out.seekp(SequenceBinary::headerSize + 1);
+		out.put(7);
+	}
+	bool badFlag = false;
+	try {
+		MappedSequence<const bool> flags(flagPath);
+	}
+	catch (const SequenceFormatError& error) {
+		badFlag = error.getPosition() == SequenceBinary::headerSize + 1;
+	}
+	assert(badFlag);
+	std::filesystem::remove(flagPath);
+}
+
+size_t testMappedSequence() {
+	runTest(testMappedGrowth);
+	return runTest(testMappedReadOnly);
+}
@@ -2,6 +2,8 @@
 #include "runTestMethods.h"
 #include "cassert"
 #include <sstream>
+#include <limits>
+#include <string>
 
 void testIndexOperator() {
 	Sequence<int> seq(10);
@@ -21,7 +23,7 @@ void testIndexOperator() {
 
 void testAssignmentOperator() {
 	int* elementsA = new int[] {5, 8, 3};
-	int* elementsB = new int[] {2, 9, 5};
+	int* elementsB = new int[] {2, 9, 5, 1};
 
 	Sequence<int> seqA(elementsA, 3, 5);
 	Sequence<int> seqB(elementsB, 4, 8);
@@ -72,7 +74,8 @@ void testInputOperator() {
 	Sequence<int> seq(2);
 	ss >> seq;
 
-	assert(seq.getCapacity() == 102);
+	// the count is reserved before the elements are read
+	assert(seq.getCapacity() == 5);
 	assert(seq.getSize() == 5);
 	assert(seq[0] == 10);
 	assert(seq[1] == 20);
@@ -85,7 +88,7 @@ void testInputOperator() {
 	Sequence<int> seqA(2);
 	s >> seqA;
 
-	assert(seqA.getCapacity() == 102);
+	assert(seqA.getCapacity() == 5);
 	assert(seqA.getSize() == 4);
 	assert(seqA[0] == 10);
 	assert(seqA[1] == 20);
@@ -97,7 +100,7 @@ void testInputOperator() {
 	Sequence<int> seqB(2);
 	is >> seqB;
 
-	assert(seqB.getCapacity() == 102);
+	assert(seqB.getCapacity() == 5);
 	assert(seqB.getSize() == 5);
 	assert(seqB[0] == 10);
 	assert(seqB[1] == 20);
@@ -151,7 +154,145 @@ void testComparisonOperator() {
 	assert(!(seq != sequence));
 }
 
+enum class Colour : unsigned char { red, green, blue };
+
+// padding-free key whose == compares every byte, declared trivially comparable below
+struct PackedKey {
+	int high;
+	int low;
+
+	bool operator==(const PackedKey&) const = default;
+	auto operator<=>(const PackedKey&) const = default;
+};
+
+template <>
+struct IsTriviallyComparable<PackedKey> : std::true_type {};
+
+// only operator<, so <=> is synthesized from it
+struct LegacyKey {
+	int value;
+
+	bool operator<(const LegacyKey& other) const { return value < other.value; }
+	bool operator==(const LegacyKey& other) const { return value == other.value; }
+};
+
+void testOrderingOperator() {
+	Sequence<int> a(200);
+	Sequence<int> b(200);
+	for (int i = 0; i < 150; i++) {
+		a.push_back(i - 75);
+		b.push_back(i - 75);
+	}
+	assert(a == b && (a <=> b) == 0 && a <= b && !(a < b));
+	b[149] = 100;
+	assert(a != b && a < b && b > a);
+	// the first difference decides, even against a longer tail
+	b[3] = -100;
+	b.push_back(5);
+	assert(a > b && (a <=> b) == std::strong_ordering::greater);
+	b[3] = a[3];
+	b[149] = a[149];
+	assert(a < b && a != b);
+	b.pop_back();
+	assert(a == b);
+	assert(Sequence<int>() < a && Sequence<int>() == Sequence<int>(5));
+
+	Sequence<std::string> words(4);
+	words.push_back("apple").push_back("pear");
+	Sequence<std::string> others(4);
+	others.push_back("apple").push_back("peach");
+	assert(words > others && others < words && words != others);
+
+	Sequence<Colour> colours(40);
+	Sequence<Colour> sameColours(40);
+	for (int i = 0; i < 40; i++) {
+		colours.push_back(static_cast<Colour>(i % 3));
+		sameColours.push_back(static_cast<Colour>(i % 3));
+	}
+	assert(colours == sameColours);
+	sameColours[37] = Colour::blue;
+	assert(colours < sameColours);
+
+	Sequence<PackedKey> keys(4);
+	keys.push_back(PackedKey{ 1, 2 }).push_back(PackedKey{ 1, 3 });
+	Sequence<PackedKey> otherKeys(keys);
+	assert(keys == otherKeys);
+	otherKeys[1].low = 1;
+	assert(keys != otherKeys && keys > otherKeys);
+
+	// partial ordering: a NaN makes two sequences unordered
+	Sequence<double> doubles(4);
+	doubles.push_back(1.0).push_back(std::numeric_limits<double>::quiet_NaN());
+	Sequence<double> otherDoubles(doubles);
+	assert(doubles != otherDoubles && (doubles <=> otherDoubles) == std::partial_ordering::unordered);
+
+	Sequence<LegacyKey> legacy(4);
+	legacy.push_back(LegacyKey{ 1 }).push_back(LegacyKey{ 5 });
+	Sequence<LegacyKey> otherLegacy(4);
+	otherLegacy.push_back(LegacyKey{ 1 }).push_back(LegacyKey{ 7 });
+	assert((legacy <=> otherLegacy) == std::weak_ordering::less && legacy < otherLegacy);
+}
+
+void testConcatenationOperator() {
+	Sequence<int> a(new int[] {1, 2, 3}, 3, 3, 7);
+	Sequence<int> b(new int[] {4, 5}, 2, 50, 10);
+	const Sequence<int> empty;
+
+	// the whole chain is sized up front and allocated once
+	auto sum = a + b + empty + a;
+	assert(sum.getSize() == 8);
+	Sequence<int> joined = std::move(sum);
+	assert(joined.getSize() == 8 && joined.getCapacity() == 8 && joined.getCapacityGrowthStep() == 7);
+	assert(joined[0] == 1 && joined[3] == 4 && joined[5] == 1 && joined.back() == 3);
+
+	Sequence<int> grouped = (a + b) + (b + a);
+	assert(grouped.getSize() == 10 && grouped.getCapacity() == 10 && grouped[4] == 5 && grouped[5] == 4 && grouped[9] == 3);
+	Sequence<int> prepended = a + (b + b);
+	assert(prepended.getSize() == 7 && prepended[2] == 3 && prepended[3] == 4 && prepended[6] == 5);
+
+	// a temporary on the left lends its buffer when it has room
+	Sequence<int> roomy(100, 10);
+	roomy.push_back(0);
+	const int* buffer = roomy.data();
+	Sequence<int> reused = std::move(roomy) + a + b;
+	assert(reused.data() == buffer && reused.getSize() == 6 && reused[1] == 1 && reused[5] == 5);
+	Sequence<int> doubled = std::move(reused) + reused;
+	assert(doubled.getSize() == 12 && doubled[6] == 0 && doubled[11] == 5);
+
+	Sequence<std::string> words;
+	words.push_back("a").push_back("b");
+	Sequence<std::string> text = words + Sequence<std::string>(words) + words;
+	assert(text.getSize() == 6 && text[2] == "a" && text[5] == "b");
+
+	// rvalue operands are moved into the expression, so it can be kept past the full expression
+	auto kept = a + Sequence<int>(b) + Sequence<int>(a);
+	Sequence<int> owned = std::move(kept);
+	assert(owned.getSize() == 8 && owned[3] == 4 && owned[7] == 3);
+	auto pair = a + b;
+	Sequence<int> converted = pair;
+	assert(converted == pair.materialize() && pair.getSize() == 5 && converted.getCapacityGrowthStep() == 7);
+
+	// reads and output without converting first
+	assert((a + b)[3] == 4 && (a + b).at(4) == 5 && (a + b).front() == 1 && (b + a).back() == 3);
+	assert((a + b).find(5) == 4 && (b + a).find(9) == 5 && (a + b + a).containsLotsOf(2) == 2 && !(a + empty).contains(4));
+	bool outOfRange = false;
+	try {
+		(void)(a + empty).at(3);
+	}
+	catch (const std::out_of_range&) {
+		outOfRange = true;
+	}
+	assert(outOfRange);
+	std::ostringstream printed;
+	std::ostringstream expected;
+	printed << a + b;
+	expected << Sequence<int>(a + b);
+	assert(printed.str() == expected.str() && printed.str().find("1 2 3 4 5") != std::string::npos);
+}
+
 size_t testOperators() {
+	runTest(testOrderingOperator);
+	runTest(testConcatenationOperator);
 	runTest(testAssignmentOperator);
 	runTest(testOutputOperator);
 	runTest(testInputOperator);
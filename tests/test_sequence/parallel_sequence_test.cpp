@@ -0,0 +1,139 @@
+#include "../../include/Sequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+void testThreadPool() {
+	ThreadPool pool(4);
+	assert(pool.getThreadCount() == 4);
+
+	// every index visited exactly once, whatever the split
+	for (size_t count : { size_t(0), size_t(1), size_t(7), size_t(1000), size_t(100003) }) {
+		Sequence<int> visits(count);
+		for (size_t i = 0; i < count; i++) {
+			visits.push_back(0);
+		}
+		pool.parallelFor(count, 16, [&visits](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				visits[i]++;
+			}
+		});
+		assert(visits.containsLotsOf(1) == count);
+	}
+
+	// pieces spawned from inside the pool finish without deadlocking it
+	std::atomic<size_t> inner{ 0 };
+	pool.parallelFor(64, 1, [&pool, &inner](size_t begin, size_t end) {
+		pool.parallelFor((end - begin) * 100, 10, [&inner](size_t from, size_t to) {
+			inner.fetch_add(to - from);
+		});
+	});
+	assert(inner.load() == 6400);
+
+	std::atomic<size_t> submitted{ 0 };
+	for (int i = 0; i < 100; i++) {
+		pool.submit([&submitted] { submitted.fetch_add(1); });
+	}
+	pool.parallelFor(1000, 1, [](size_t, size_t) {});
+	while (submitted.load() < 100) {
+		std::this_thread::yield();
+	}
+
+	bool thrown = false;
+	try {
+		pool.parallelFor(1000, 1, [](size_t begin, size_t) {
+			if (begin >= 500) {
+				throw std::runtime_error("piece failed");
+			}
+		});
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+void testParallelMatchesSequential() {
+	const size_t count = Sequence<int>::parallelThreshold * 4 + 123;
+	Sequence<int> seq(count);
+	for (size_t i = 0; i < count; i++) {
+		seq.push_back(static_cast<int>(i % 1000));
+	}
+
+	assert(seq.count(std::execution::par, 7) == seq.containsLotsOf(7));
+	assert(seq.containsLotsOf(std::execution::par_unseq, 999) == seq.containsLotsOf(999));
+	assert(seq.count(std::execution::par, -1) == 0);
+	assert(seq.find(std::execution::par, 500) == 500 && seq.findFirst(std::execution::par_unseq, 500) == 500);
+	assert(!seq.contains(std::execution::par, 1000) && seq.find(std::execution::par, 1000) == count);
+
+	// only the last element matches, every earlier piece has to give up
+	seq.push_back(-5);
+	assert(seq.findFirst(std::execution::par, -5) == count && seq.contains(std::execution::par, -5));
+	seq.pop_back();
+
+	long long sum = 0;
+	for (size_t i = 0; i < count; i++) {
+		sum += seq[i];
+	}
+	assert(seq.reduce(std::execution::par, 0LL, [](long long a, long long b) { return a + b; }) == sum);
+	assert(seq.reduce(std::execution::seq, 0LL, [](long long a, long long b) { return a + b; }) == sum);
+	assert(seq.reduce(std::execution::par, 10000, [](int a, int b) { return (a > b) ? a : b; }) == 10000);
+
+	std::atomic<long long> visited{ 0 };
+	const Sequence<int>& view = seq;
+	view.forEach(std::execution::par, [&visited](const int& value) { visited.fetch_add(value); });
+	assert(visited.load() == sum);
+
+	seq.transform(std::execution::par, [](int value) { return value * 2; });
+	assert(seq[0] == 0 && seq[999] == 1998 && seq[count - 1] == static_cast<int>(((count - 1) % 1000) * 2));
+
+	seq.changeAll(std::execution::par, 0, -1);
+	assert(seq.containsLotsOf(0) == 0 && seq.containsLotsOf(std::execution::par, -1) == (count + 999) / 1000);
+	// the replacement lives inside the sequence
+	size_t twos = seq.containsLotsOf(-1) + seq.containsLotsOf(2);
+	seq.changeAll(std::execution::par, seq[0], seq[1]);
+	assert(seq.containsLotsOf(-1) == 0 && seq.containsLotsOf(2) == twos);
+
+	bool thrown = false;
+	try {
+		seq.forEach(std::execution::par, [](int& value) {
+			if (value == 1998) {
+				throw std::logic_error("bad element");
+			}
+		});
+	}
+	catch (const std::logic_error&) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+void testParallelBelowThreshold() {
+	// small sequences and sequential policies stay on the calling thread
+	Sequence<std::string> words(10);
+	words.push_back("alpha").push_back("beta").push_back("alpha");
+	assert(words.count(std::execution::par, "alpha") == 2 && words.find(std::execution::par, "beta") == 1);
+	assert(words.findFirst(std::execution::seq, "gamma") == 3);
+	words.transform(std::execution::unseq, [](const std::string& word) { return word + "!"; });
+	assert(words.contains(std::execution::par_unseq, "beta!"));
+	assert(words.reduce(std::execution::par, std::string(), [](std::string a, const std::string& b) { return a + b; }) == "alpha!beta!alpha!");
+
+	const size_t count = Sequence<std::string>::parallelThreshold + 1;
+	Sequence<std::string> many(count);
+	for (size_t i = 0; i < count; i++) {
+		many.push_back(std::to_string(i % 10));
+	}
+	size_t threes = many.containsLotsOf("3");
+	assert(many.count(std::execution::par, "3") == threes);
+	assert(many.findFirst(std::execution::par, "9") == 9);
+	many.changeAll(std::execution::par, "3", "x");
+	assert(many.count(std::execution::par, "x") == threes && !many.contains(std::execution::par, "3"));
+}
+
+size_t testParallel() {
+	runTest(testThreadPool);
+	runTest(testParallelBelowThreshold);
+	return runTest(testParallelMatchesSequential);
+}
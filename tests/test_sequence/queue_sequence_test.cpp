@@ -0,0 +1,187 @@
+#include "../../include/SequenceQueue.h"
+#include "runTestMethods.h"
+#include "trackedElement.h"
+#include "cassert"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void testSpscQueue() {
+	SpscQueue<int> queue(5);
+	assert(queue.getCapacity() == 8 && queue.isEmpty());
+	int values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	assert(queue.tryPushN(values, 10) == 8 && !queue.tryPush(8) && queue.getSize() == 8);
+
+	int out[4] = {};
+	assert(queue.tryPopN(out, 3) == 3 && out[0] == 0 && out[2] == 2);
+	// the batch wraps around the end of the ring
+	assert(queue.tryPushN(values + 8, 2) == 2 && queue.tryEmplace(10) && !queue.tryEmplace(11));
+	Sequence<int> drained(size_t(0), size_t(2));
+	drained.push_back(-1);
+	assert(queue.tryPopN(drained, 100) == 8 && queue.isEmpty());
+	assert(drained.getSize() == 9 && drained[0] == -1 && drained[1] == 3 && drained[8] == 10 && drained.find(9) == 7);
+	int single = 0;
+	assert(!queue.tryPop(single) && queue.tryPopN(out, 4) == 0);
+
+	bool zero = false;
+	try {
+		SpscQueue<int> none(0);
+	}
+	catch (const std::invalid_argument&) {
+		zero = true;
+	}
+	assert(zero);
+
+	// one producer and one consumer keep the order
+	SpscQueue<size_t> pipe(64);
+	const size_t total = 50000;
+	std::thread producer([&] {
+		size_t next = 0;
+		size_t batch[16];
+		while (next < total) {
+			if (next % 3 == 0) {
+				size_t count = (total - next < 16) ? total - next : 16;
+				for (size_t i = 0; i < count; i++) {
+					batch[i] = next + i;
+				}
+				size_t pushed = pipe.tryPushN(batch, count);
+				next += pushed;
+				if (pushed == 0) {
+					std::this_thread::yield();
+				}
+			}
+			else if (pipe.tryPush(next)) {
+				next++;
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+	});
+	size_t expected = 0;
+	Sequence<size_t> received;
+	while (expected < total) {
+		size_t value;
+		if (expected % 2 == 0 && pipe.tryPop(value)) {
+			assert(value == expected);
+			expected++;
+		}
+		else {
+			received.clear();
+			if (pipe.tryPopN(received, 32) == 0) {
+				std::this_thread::yield();
+			}
+			for (size_t v : received) {
+				assert(v == expected);
+				expected++;
+			}
+		}
+	}
+	producer.join();
+	assert(pipe.isEmpty());
+}
+
+void testMpmcQueue() {
+	MpmcQueue<std::string> words(4);
+	assert(words.tryPush("a") && words.tryEmplace(3, 'b') && words.getSize() == 2);
+	std::string batch[3] = { "c", "d", "e" };
+	assert(words.tryPushN(batch, 3) == 2 && words.getSize() == 4);
+	std::string out[2];
+	assert(words.tryPopN(out, 2) == 2 && out[0] == "a" && out[1] == "bbb");
+	Sequence<std::string> rest;
+	assert(words.tryPopN(rest, 10) == 2 && rest.getSize() == 2 && rest[1] == "d" && words.isEmpty());
+	std::string nothing;
+	assert(!words.tryPop(nothing) && words.tryPopN(rest, 10) == 0 && rest.getSize() == 2);
+
+	// every value pushed by four producers is popped once by four consumers
+	MpmcQueue<size_t> queue(128);
+	const size_t producers = 4;
+	const size_t perProducer = 10000;
+	std::atomic<size_t> consumed = 0;
+	std::vector<std::atomic<unsigned char>> seen(producers * perProducer);
+	std::vector<std::thread> threads;
+	for (size_t p = 0; p < producers; p++) {
+		threads.emplace_back([&, p] {
+			size_t next = p * perProducer;
+			size_t end = next + perProducer;
+			size_t values[8];
+			while (next < end) {
+				if (next % 5 == 0) {
+					size_t count = (end - next < 8) ? end - next : 8;
+					for (size_t i = 0; i < count; i++) {
+						values[i] = next + i;
+					}
+					size_t pushed = queue.tryPushN(values, count);
+					next += pushed;
+					if (pushed == 0) {
+						std::this_thread::yield();
+					}
+				}
+				else if (queue.tryPush(next)) {
+					next++;
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+	for (size_t c = 0; c < 4; c++) {
+		threads.emplace_back([&, c] {
+			size_t values[8];
+			Sequence<size_t> taken;
+			while (consumed.load() < producers * perProducer) {
+				size_t count = 0;
+				if (c == 0) {
+					taken.clear();
+					count = queue.tryPopN(taken, 8);
+					for (size_t v : taken) {
+						seen[v]++;
+					}
+				}
+				else {
+					count = queue.tryPopN(values, (c == 1) ? 1 : 8);
+					for (size_t i = 0; i < count; i++) {
+						seen[values[i]]++;
+					}
+				}
+				consumed += count;
+				if (count == 0) {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	assert(consumed.load() == producers * perProducer && queue.isEmpty());
+	for (std::atomic<unsigned char>& count : seen) {
+		assert(count.load() == 1);
+	}
+}
+
+void testQueueLifetimes() {
+	TrackedElement::alive = 0;
+	{
+		SpscQueue<TrackedElement> spsc(4);
+		MpmcQueue<TrackedElement> mpmc(4);
+		for (int i = 0; i < 3; i++) {
+			spsc.tryEmplace(i);
+			mpmc.tryEmplace(i);
+		}
+		TrackedElement out(-1);
+		assert(spsc.tryPop(out) && out.value == 0 && mpmc.tryPop(out) && out.value == 0);
+		assert(TrackedElement::alive == 5);
+	}
+	// the elements left in the queues are destroyed with them
+	assert(TrackedElement::alive == 0);
+}
+
+size_t testQueues() {
+	runTest(testSpscQueue);
+	runTest(testMpmcQueue);
+	return runTest(testQueueLifetimes);
+}
@@ -0,0 +1,118 @@
+#include "../../include/Sequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// every level the CPU can run, down to the scalar loops
+template <class Check>
+void forEachSimdLevel(Check check) {
+	const SimdLevel levels[] = { SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512 };
+	for (SimdLevel level : levels) {
+		if (level <= simdLevel()) {
+			check(level);
+		}
+	}
+}
+
+// sizes around the register widths, matches at every position, and values that are absent
+template <class type>
+void compareWithScalar() {
+	std::mt19937 random(7);
+	std::uniform_int_distribution<int> small(0, 5);
+	for (size_t count = 0; count < 300; count += (count < 140) ? 1 : 37) {
+		Sequence<type> seq(count + 1);
+		for (size_t i = 0; i < count; i++) {
+			seq.push_back(static_cast<type>(small(random)));
+		}
+		const type* data = (count > 0) ? &seq[0] : nullptr;
+		for (int value = 0; value < 8; value++) {
+			type needle = static_cast<type>(value);
+			size_t first = SimdSearch<type>::findScalar(data, count, needle);
+			size_t last = SimdSearch<type>::findLastScalar(data, count, needle);
+			size_t matches = SimdSearch<type>::countScalar(data, count, needle);
+			forEachSimdLevel([&](SimdLevel level) {
+				assert(SimdSearch<type>::find(data, count, needle, level) == first);
+				assert(SimdSearch<type>::findLast(data, count, needle, level) == last);
+				assert(SimdSearch<type>::count(data, count, needle, level) == matches);
+			});
+			assert(seq.find(needle) == first && seq.findFirst(needle) == first && seq.findLast(needle) == last);
+			assert(seq.containsLotsOf(needle) == matches && seq.contains(needle) == (matches > 0));
+		}
+	}
+}
+
+void testSimdMatchesScalar() {
+	compareWithScalar<char>();
+	compareWithScalar<uint8_t>();
+	compareWithScalar<int16_t>();
+	compareWithScalar<int>();
+	compareWithScalar<unsigned>();
+	compareWithScalar<long long>();
+	compareWithScalar<uint64_t>();
+	compareWithScalar<float>();
+	compareWithScalar<double>();
+}
+
+void testSimdEdgeValues() {
+	// values whose halves or bytes match the needle only partly
+	Sequence<long long> wide(70);
+	for (long long i = 1; i <= 64; i++) {
+		wide.push_back((i << 32) | 5);
+	}
+	wide.push_back(5);
+	forEachSimdLevel([&](SimdLevel level) {
+		assert(SimdSearch<long long>::find(&wide[0], wide.getSize(), 5, level) == 64);
+		assert(SimdSearch<long long>::count(&wide[0], wide.getSize(), 5, level) == 1);
+	});
+
+	// floating point lanes follow operator==
+	Sequence<double> doubles(40);
+	for (int i = 0; i < 37; i++) {
+		doubles.push_back(i * 0.5);
+	}
+	doubles.changeAt(3, -0.0).changeAt(20, std::numeric_limits<double>::quiet_NaN());
+	assert(doubles.find(0.0) == 0 && doubles.findLast(0.0) == 3 && doubles.containsLotsOf(-0.0) == 2);
+	assert(!doubles.contains(std::numeric_limits<double>::quiet_NaN()));
+	forEachSimdLevel([&](SimdLevel level) {
+		assert(SimdSearch<double>::count(&doubles[0], doubles.getSize(), 0.0, level) == 2);
+		assert(SimdSearch<double>::find(&doubles[0], doubles.getSize(), std::numeric_limits<double>::quiet_NaN(), level) == doubles.getSize());
+	});
+
+	Sequence<float> floats(100);
+	for (int i = 0; i < 100; i++) {
+		floats.push_back(std::sqrt(static_cast<float>(i)));
+	}
+	assert(floats.find(3.0f) == 9 && floats.findLast(9.0f) == 81 && floats.containsLotsOf(1.5f) == 0);
+
+	assert(!SimdSearch<bool>::isSupported && !SimdSearch<long double>::isSupported && !SimdSearch<std::string>::isSupported);
+}
+
+void testSimdMismatch() {
+	unsigned char first[300];
+	unsigned char second[300];
+	for (size_t i = 0; i < 300; i++) {
+		first[i] = second[i] = static_cast<unsigned char>(i * 7);
+	}
+	for (size_t bytes = 0; bytes <= 300; bytes += 13) {
+		forEachSimdLevel([&](SimdLevel level) {
+			assert(SimdCompare::firstMismatch(first, second, bytes, level) == bytes);
+		});
+	}
+	for (size_t position = 0; position < 300; position++) {
+		second[position] ^= 0x80;
+		forEachSimdLevel([&](SimdLevel level) {
+			assert(SimdCompare::firstMismatch(first, second, 300, level) == position);
+			assert(SimdCompare::firstMismatch(first, second, position, level) == position);
+		});
+		second[position] ^= 0x80;
+	}
+}
+
+size_t testSimdSearch() {
+	runTest(testSimdMismatch);
+	runTest(testSimdEdgeValues);
+	return runTest(testSimdMatchesScalar);
+}
@@ -0,0 +1,129 @@
+#include "../../include/SmallSequence.h"
+#include "runTestMethods.h"
+#include "trackedElement.h"
+#include "cassert"
+#include <string>
+
+template <class type, size_t inlineCapacity>
+bool storedInside(const SmallSequence<type, inlineCapacity>& seq) {
+	const char* object = reinterpret_cast<const char*>(&seq);
+	const char* first = reinterpret_cast<const char*>(&seq[0]);
+	return first >= object && first < object + sizeof(seq);
+}
+
+void testSmallCreation() {
+	SmallSequence<int, 8> seq;
+	assert(seq.getCapacity() == 8 && seq.isEmpty() && seq.isInline());
+	assert((SmallSequence<int, 8>::getInlineCapacity() == 8));
+	SmallSequence<int, 8> tiny(2);
+	assert(tiny.getCapacity() == 8 && tiny.isInline());
+	SmallSequence<int, 4> big(50);
+	assert(big.getCapacity() == 50 && !big.isInline());
+
+	int elements[] = {1, 2, 3};
+	SmallSequence<int, 4> fromArray(elements, 3);
+	assert(fromArray.getSize() == 3 && fromArray[2] == 3 && fromArray.isInline() && storedInside(fromArray));
+
+	bool exceptionThrown = false;
+	try {
+		SmallSequence<int, 4> invalid(elements, 3, 2);
+	}
+	catch (std::invalid_argument&) {
+		exceptionThrown = true;
+	}
+	assert(exceptionThrown);
+}
+
+void testSmallSpilling() {
+	SmallSequence<int, 4> seq(4, 4);
+	seq.push_back(1).push_back(2).push_back(3).push_back(4);
+	assert(seq.isInline() && seq.isFull() && storedInside(seq));
+	assert(seq.totalSizeInBytes() == sizeof(seq));
+	seq.push_back(5);
+	assert(!seq.isInline() && seq.getCapacity() == 8 && seq[4] == 5 && seq.front() == 1);
+	assert(seq.totalSizeInBytes() == sizeof(seq) + 8 * sizeof(int));
+	seq.pop_back().pop_back();
+	seq.shrink_to_fit();
+	assert(seq.isInline() && seq.getCapacity() == 4 && seq.getSize() == 3 && seq[2] == 3);
+	seq.resize(1);
+	assert(seq.isInline() && seq.getCapacity() == 4 && seq.getSize() == 1);
+
+	seq.push_front(0).insertAt(1, 9).removeAll(9);
+	assert(seq.getSize() == 2 && seq[0] == 0 && seq[1] == 1 && seq.isInline());
+}
+
+void testSmallCopyAndMove() {
+	SmallSequence<std::string, 2> inlineSeq;
+	inlineSeq.push_back("a").push_back("b");
+	SmallSequence<std::string, 2> spilled;
+	spilled.push_back("x").push_back("y").push_back("z");
+	const std::string* spilledBuffer = &spilled[0];
+
+	SmallSequence<std::string, 2> copy(inlineSeq);
+	assert(copy.isInline() && copy == inlineSeq && storedInside(copy));
+	SmallSequence<std::string, 2> spilledCopy(spilled);
+	assert(!spilledCopy.isInline() && spilledCopy == spilled && &spilledCopy[0] != spilledBuffer);
+
+	SmallSequence<std::string, 2> movedInline(std::move(copy));
+	assert(movedInline.isInline() && movedInline[1] == "b" && copy.isEmpty() && storedInside(movedInline));
+	SmallSequence<std::string, 2> movedSpilled(std::move(spilledCopy));
+	assert(!movedSpilled.isInline() && movedSpilled[2] == "z");
+	assert(spilledCopy.isEmpty() && spilledCopy.isInline());
+	spilledCopy.push_back("reused");
+	assert(spilledCopy.isInline() && spilledCopy[0] == "reused");
+
+	SmallSequence<std::string, 2> assigned;
+	assigned = inlineSeq;
+	assert(assigned.isInline() && assigned == inlineSeq);
+	assigned = spilled;
+	assert(!assigned.isInline() && assigned == spilled);
+	assigned = std::move(movedInline);
+	assert(assigned[0] == "a" && assigned.getSize() == 2);
+	assigned = std::move(spilled);
+	assert(!assigned.isInline() && &assigned[0] == spilledBuffer && spilled.isEmpty() && spilled.isInline());
+}
+
+void testSmallSwap() {
+	SmallSequence<int, 3> a;
+	a.push_back(1).push_back(2);
+	SmallSequence<int, 3> b;
+	b.push_back(7).push_back(8).push_back(9).push_back(10);
+	SmallSequence<int, 3> c;
+	c.push_back(5).push_back(6).push_back(4).push_back(3).push_back(2);
+
+	a.swap(b);
+	assert(!a.isInline() && a.getSize() == 4 && a[0] == 7 && a[3] == 10);
+	assert(b.isInline() && b.getSize() == 2 && b[1] == 2 && storedInside(b));
+
+	const int* bufferA = &a[0];
+	const int* bufferC = &c[0];
+	swap(a, c);
+	assert(&a[0] == bufferC && &c[0] == bufferA && a.getSize() == 5 && c[3] == 10);
+
+	SmallSequence<int, 3> d;
+	d.push_back(42);
+	swap(b, d);
+	assert(b.getSize() == 1 && b[0] == 42 && d.getSize() == 2 && d[0] == 1 && b.isInline() && d.isInline());
+	b.swap(b);
+	assert(b.getSize() == 1 && b[0] == 42);
+
+	{
+		SmallSequence<TrackedElement, 2> tracked;
+		tracked.emplace_back(1);
+		SmallSequence<TrackedElement, 2> other;
+		other.emplace_back(2);
+		other.emplace_back(3);
+		other.emplace_back(4);
+		tracked.swap(other);
+		assert(tracked.getSize() == 3 && other.getSize() == 1 && other[0].value == 1);
+		assert(TrackedElement::alive == 4);
+	}
+	assert(TrackedElement::alive == 0);
+}
+
+size_t testSmallSequence() {
+	runTest(testSmallCreation);
+	runTest(testSmallSpilling);
+	runTest(testSmallCopyAndMove);
+	return runTest(testSmallSwap);
+}
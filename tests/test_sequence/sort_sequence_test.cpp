@@ -0,0 +1,198 @@
+#include "../../include/Sequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+template <class type>
+bool isSortedSequence(const Sequence<type>& seq) {
+	for (size_t i = 1; i < seq.getSize(); i++) {
+		if (seq[i] < seq[i - 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// same multiset of values as std::sort gives, for sizes on both sides of the radix threshold
+template <class type>
+void compareWithStdSort(type low, type high) {
+	std::mt19937_64 random(11);
+	for (size_t count : { size_t(0), size_t(1), size_t(2), size_t(17), size_t(255), size_t(256), size_t(1000), size_t(40000) }) {
+		Sequence<type> seq(count + 1);
+		std::vector<type> expected;
+		for (size_t i = 0; i < count; i++) {
+			type value;
+			if constexpr (std::is_floating_point_v<type>) {
+				value = std::uniform_real_distribution<type>(low, high)(random);
+			}
+			else {
+				value = static_cast<type>(std::uniform_int_distribution<long long>(low, high)(random));
+			}
+			seq.push_back(value);
+			expected.push_back(value);
+		}
+		std::sort(expected.begin(), expected.end());
+		seq.sort();
+		assert(seq.getSize() == count);
+		for (size_t i = 0; i < count; i++) {
+			assert(seq[i] == expected[i]);
+		}
+	}
+}
+
+void testSortArithmetic() {
+	compareWithStdSort<char>(-128, 127);
+	compareWithStdSort<uint8_t>(0, 255);
+	compareWithStdSort<int16_t>(-30000, 30000);
+	compareWithStdSort<int>(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+	compareWithStdSort<unsigned>(0, 50);
+	compareWithStdSort<long long>(std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max());
+	compareWithStdSort<uint64_t>(0, 1000);
+	compareWithStdSort<float>(-1e6f, 1e6f);
+	compareWithStdSort<double>(-1.0, 1.0);
+
+	// special floating point values in radix order
+	Sequence<double> doubles(300);
+	for (int i = 0; i < 300; i++) {
+		doubles.push_back((i % 2 == 0) ? i * 0.25 : -i * 0.25);
+	}
+	doubles.changeAt(5, std::numeric_limits<double>::infinity()).changeAt(7, -std::numeric_limits<double>::infinity());
+	doubles.changeAt(9, -0.0).changeAt(11, std::numeric_limits<double>::denorm_min());
+	doubles.sort();
+	assert(doubles[0] == -std::numeric_limits<double>::infinity() && doubles[299] == std::numeric_limits<double>::infinity());
+	assert(isSortedSequence(doubles));
+	// -0.0 and 0.0 are equal and keep their order
+	assert(!std::signbit(doubles[doubles.find(0.0)]) && std::signbit(doubles[doubles.find(0.0) + 1]));
+	assert(doubles[doubles.find(0.0) + 2] == std::numeric_limits<double>::denorm_min());
+}
+
+struct Record {
+	int key;
+	size_t order;
+};
+
+void testSortComparators() {
+	std::mt19937 random(5);
+	Sequence<int> seq(5000);
+	for (int i = 0; i < 5000; i++) {
+		seq.push_back(static_cast<int>(random() % 1000));
+	}
+	seq.sort(std::greater<>());
+	for (size_t i = 1; i < seq.getSize(); i++) {
+		assert(seq[i - 1] >= seq[i]);
+	}
+	assert(isSortedSequence(seq.sort(std::less<int>())));
+
+	// already sorted, reversed and constant inputs stay within the depth limit
+	Sequence<int> patterns(100000);
+	for (int i = 0; i < 100000; i++) {
+		patterns.push_back(100000 - i);
+	}
+	assert(isSortedSequence(patterns.sort([](int a, int b) { return a < b; })));
+	assert(isSortedSequence(patterns.sort([](int a, int b) { return a < b; })));
+	for (size_t i = 0; i < patterns.getSize(); i++) {
+		patterns.changeAt(i, (i % 2 == 0) ? 7 : static_cast<int>(i % 3));
+	}
+	assert(isSortedSequence(patterns.sort([](int a, int b) { return a < b; })));
+
+	Sequence<std::string> words(10);
+	words.push_back("pear").push_back("apple").push_back("fig").push_back("banana").push_back("apple");
+	words.sort();
+	assert(words[0] == "apple" && words[1] == "apple" && words[2] == "banana" && words[4] == "pear");
+	words.sort([](const std::string& a, const std::string& b) { return a.size() < b.size(); });
+	assert(words[0] == "fig" && words[4] == "banana");
+
+	Sequence<std::string> empty;
+	empty.sort().stableSort();
+	assert(empty.isEmpty());
+}
+
+void testStableSort() {
+	Sequence<Record> records(3000);
+	for (size_t i = 0; i < 3000; i++) {
+		records.push_back(Record{ static_cast<int>((i * 7919) % 50), i });
+	}
+	records.stableSort([](const Record& a, const Record& b) { return a.key < b.key; });
+	for (size_t i = 1; i < records.getSize(); i++) {
+		assert(records[i - 1].key < records[i].key || (records[i - 1].key == records[i].key && records[i - 1].order < records[i].order));
+	}
+
+	Sequence<int> numbers(1000);
+	for (int i = 0; i < 1000; i++) {
+		numbers.push_back(999 - i);
+	}
+	numbers.stableSort();
+	assert(numbers[0] == 0 && numbers[999] == 999 && isSortedSequence(numbers));
+
+	// the radix path keeps equal floating point values in order, -0.0 and 0.0 included
+	Sequence<double> zeros(300);
+	Sequence<float> floatZeros(300);
+	for (int i = 0; i < 300; i++) {
+		zeros.push_back((i % 2 == 0) ? -0.0 : 0.0);
+		floatZeros.push_back((i % 3 == 0) ? 0.0f : -0.0f);
+	}
+	zeros.push_back(-1.0).push_back(1.0);
+	Sequence<double> parallelZeros(zeros);
+	zeros.stableSort();
+	parallelZeros.stableSort(std::execution::par);
+	floatZeros.stableSort();
+	assert(zeros.front() == -1.0 && zeros.back() == 1.0 && parallelZeros == zeros);
+	for (size_t i = 0; i < 300; i++) {
+		assert(std::signbit(zeros[i + 1]) == (i % 2 == 0) && std::signbit(parallelZeros[i + 1]) == (i % 2 == 0));
+		assert(std::signbit(floatZeros[i]) == (i % 3 != 0));
+	}
+}
+
+void testParallelSort() {
+	const size_t count = Sequence<int>::parallelThreshold * 8 + 5;
+	std::mt19937 random(3);
+	Sequence<int> seq(count);
+	Sequence<std::string> words(count);
+	Sequence<Record> records(count);
+	for (size_t i = 0; i < count; i++) {
+		int value = static_cast<int>(random());
+		seq.push_back(value);
+		words.push_back(std::to_string(value % 100000));
+		records.push_back(Record{ value % 100, i });
+	}
+	Sequence<int> expected(seq);
+	expected.sort();
+
+	seq.sort(std::execution::par);
+	assert(seq == expected);
+	seq.sort(std::execution::par, std::greater<>());
+	for (size_t i = 1; i < count; i++) {
+		assert(seq[i - 1] >= seq[i]);
+	}
+	seq.stableSort(std::execution::par_unseq);
+	assert(seq == expected);
+
+	words.sort(std::execution::par);
+	assert(isSortedSequence(words));
+
+	records.stableSort(std::execution::par, [](const Record& a, const Record& b) { return a.key < b.key; });
+	for (size_t i = 1; i < count; i++) {
+		assert(records[i - 1].key < records[i].key || (records[i - 1].key == records[i].key && records[i - 1].order < records[i].order));
+	}
+
+	Sequence<double> doubles(count);
+	for (size_t i = 0; i < count; i++) {
+		doubles.push_back((i % 3 == 0) ? -static_cast<double>(i) : i * 0.5);
+	}
+	doubles.sort(std::execution::par);
+	assert(isSortedSequence(doubles) && doubles[0] == -static_cast<double>((count - 1) / 3 * 3));
+}
+
+size_t testSorting() {
+	runTest(testSortArithmetic);
+	runTest(testSortComparators);
+	runTest(testStableSort);
+	return runTest(testParallelSort);
+}
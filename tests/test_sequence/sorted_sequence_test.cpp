@@ -0,0 +1,142 @@
+#include "../../include/SortedSequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+template <class type, class Compare>
+bool inOrder(const SortedSequence<type, Compare>& seq) {
+	for (size_t i = 1; i < seq.getSize(); i++) {
+		if (seq.getCompare()(seq[i], seq[i - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void testSortedLookup() {
+	SortedSequence<int> empty;
+	assert(empty.lowerBound(3) == 0 && empty.upperBound(3) == 0 && empty.find(3) == 0 && !empty.contains(3));
+
+	int elements[] = { 9, 1, 5, 5, 3, 9, 9, 7 };
+	SortedSequence<int> seq(elements, 8);
+	assert(seq.getSize() == 8 && seq.front() == 1 && seq.back() == 9 && inOrder(seq));
+	assert(seq.lowerBound(5) == 2 && seq.upperBound(5) == 4 && seq.lowerBound(0) == 0 && seq.upperBound(10) == 8);
+	assert(seq.lowerBound(4) == 2 && seq.upperBound(4) == 2);
+	assert(seq.find(9) == 5 && seq.findFirst(9) == 5 && seq.findLast(9) == 7 && seq.containsLotsOf(9) == 3);
+	assert(seq.find(4) == 8 && seq.findLast(4) == 8 && !seq.contains(4) && seq.containsLotsOf(4) == 0);
+	assert(seq.equalRange(1) == std::make_pair(size_t(0), size_t(1)));
+
+	// every bound agrees with the standard library for every size up to 64
+	std::mt19937 random(9);
+	for (size_t count = 0; count <= 64; count++) {
+		std::vector<int> values;
+		for (size_t i = 0; i < count; i++) {
+			values.push_back(static_cast<int>(random() % 20));
+		}
+		SortedSequence<int> sorted(values.data(), count);
+		std::sort(values.begin(), values.end());
+		for (int value = -1; value <= 21; value++) {
+			size_t lower = std::lower_bound(values.begin(), values.end(), value) - values.begin();
+			size_t upper = std::upper_bound(values.begin(), values.end(), value) - values.begin();
+			assert(sorted.lowerBound(value) == lower && sorted.upperBound(value) == upper);
+			assert(sorted.containsLotsOf(value) == upper - lower && sorted.contains(value) == (upper > lower));
+			assert(sorted.find(value) == sorted.asSequence().find(value));
+		}
+	}
+
+	Sequence<std::string> words;
+	words.push_back("pear").push_back("fig").push_back("apple");
+	SortedSequence<std::string, std::greater<std::string>> descending(words);
+	assert(descending[0] == "pear" && descending[2] == "apple" && descending.find("fig") == 1 && descending.lowerBound("banana") == 2);
+}
+
+void testSortedInsertion() {
+	SortedSequence<int> seq(4, 4);
+	seq.push_back(1).push_back(4).push_back(2).push_back(8).push_back(4);
+	assert(seq.getSize() == 5 && seq[0] == 1 && seq[1] == 2 && seq[4] == 8 && inOrder(seq));
+	assert(seq.insert(3) == 2 && seq.insert(4) == 5 && seq.insert(0) == 0);
+	seq.insertAt(0, -5).insertAt(seq.getSize(), 100);
+	assert(seq.front() == -5 && seq.back() == 100 && inOrder(seq));
+
+	bool exceptionThrown = false;
+	try {
+		seq.insertAt(1, 50);
+	}
+	catch (std::invalid_argument&) {
+		exceptionThrown = true;
+	}
+	assert(exceptionThrown);
+	exceptionThrown = false;
+	try {
+		seq.insertAt(seq.getSize() + 1, 500);
+	}
+	catch (std::out_of_range&) {
+		exceptionThrown = true;
+	}
+	assert(exceptionThrown);
+
+	seq.removeAll(4);
+	assert(!seq.contains(4) && inOrder(seq) && seq.getSize() == 7);
+	seq.pop_front().pop_back().removeAt(0);
+	assert(seq.front() == 1 && seq.back() == 8);
+	assert(seq.removeIf([](int value) { return value % 2 == 0; }) == 2 && seq.getSize() == 2 && seq[1] == 3);
+}
+
+struct Entry {
+	int key;
+	int batch;
+};
+
+void testInsertSorted() {
+	auto byKey = [](const Entry& a, const Entry& b) { return a.key < b.key; };
+	SortedSequence<Entry, decltype(byKey)> entries(10, 10, byKey);
+	for (int key = 0; key < 20; key += 2) {
+		entries.push_back(Entry{ key, 0 });
+	}
+	// unsorted batch, with keys equal to present ones
+	Entry batch[] = { { 7, 1 }, { 4, 1 }, { -1, 1 }, { 30, 1 }, { 4, 2 } };
+	entries.insertSorted(batch, 5);
+	assert(entries.getSize() == 15 && inOrder(entries));
+	assert(entries[0].key == -1 && entries[14].key == 30);
+	size_t fours = entries.lowerBound(Entry{ 4, 0 });
+	assert(entries.containsLotsOf(Entry{ 4, 0 }) == 3 && entries[fours].batch == 0 && entries[fours + 1].batch == 1 && entries[fours + 2].batch == 2);
+
+	std::mt19937 random(4);
+	SortedSequence<int> numbers;
+	std::vector<int> expected;
+	for (int round = 0; round < 20; round++) {
+		Sequence<int> values;
+		for (int i = 0; i < 50; i++) {
+			int value = static_cast<int>(random() % 1000);
+			values.push_back(value);
+			expected.push_back(value);
+		}
+		if (round % 2 == 0) {
+			values.sort();
+		}
+		numbers.insertSorted(values);
+	}
+	std::sort(expected.begin(), expected.end());
+	assert(numbers.getSize() == expected.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		assert(numbers[i] == expected[i]);
+	}
+
+	// merging with itself doubles every element
+	SortedSequence<int> twice(numbers);
+	twice.insertSorted(twice);
+	assert(twice.getSize() == 2 * numbers.getSize() && twice.containsLotsOf(numbers[0]) == 2 * numbers.containsLotsOf(numbers[0]));
+	assert(inOrder(twice) && twice != numbers);
+	SortedSequence<int> copy(twice);
+	assert(copy == twice);
+}
+
+size_t testSortedSequence() {
+	runTest(testSortedLookup);
+	runTest(testSortedInsertion);
+	return runTest(testInsertSorted);
+}
@@ -0,0 +1,190 @@
+#include "../../include/Sequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <io.h>
+#define SEQUENCE_TEST_FILENO _fileno
+#define SEQUENCE_TEST_LSEEK _lseek
+#define SEQUENCE_TEST_WRITE _write
+#else
+#include <unistd.h>
+#define SEQUENCE_TEST_FILENO fileno
+#define SEQUENCE_TEST_LSEEK lseek
+#define SEQUENCE_TEST_WRITE write
+#endif
+
+template <class Action>
+size_t textErrorPosition(Action action) {
+	try {
+		action();
+	}
+	catch (const SequenceFormatError& error) {
+		return error.getPosition();
+	}
+	return static_cast<size_t>(-1);
+}
+
+void testTextStream() {
+	std::istringstream in("4  -7 +12\n0 2147483647 tail");
+	Sequence<int> numbers;
+	numbers.push_back(99);
+	in >> numbers;
+	assert(in && numbers.getSize() == 4 && numbers[0] == -7 && numbers[1] == 12 && numbers[3] == 2147483647);
+	assert(numbers.getCapacity() >= 4 && !numbers.contains(99));
+	// nothing after the last element was consumed
+	std::string rest;
+	in >> rest;
+	assert(rest == "tail");
+
+	std::istringstream two("2 1.5 -2e3 3 0.25 1e-2 .5");
+	Sequence<double> first;
+	Sequence<float> second;
+	two >> first >> second;
+	assert(first.getSize() == 2 && first[1] == -2000.0 && second.getSize() == 3 && second[0] == 0.25f && second[2] == 0.5f);
+	assert(two.eof() && !two.fail());
+
+	// characters keep their istream meaning
+	std::istringstream letters("3 a b c");
+	Sequence<char> chars;
+	letters >> chars;
+	assert(chars.getSize() == 3 && chars[2] == 'c');
+
+	std::istringstream broken("5 1 2 x 4 5");
+	Sequence<long long> partial;
+	broken >> partial;
+	assert(broken.fail() && !broken.eof() && partial.getSize() == 2);
+
+	std::istringstream shortInput("3 1 2");
+	shortInput >> partial;
+	assert(shortInput.fail() && shortInput.eof() && partial.getSize() == 2);
+
+	std::istringstream noCount("x 1");
+	Sequence<int> untouched;
+	untouched.push_back(5);
+	noCount >> untouched;
+	assert(noCount.fail() && untouched.getSize() == 1);
+
+	// a count far beyond the input only reserves a bounded amount and fails on the missing elements
+	std::istringstream inflated("999999999999999 1 2");
+	Sequence<int> few;
+	inflated >> few;
+	assert(inflated.fail() && inflated.eof() && few.getSize() == 2 && few.getCapacity() <= SequenceText::maxReserve);
+	assert(textErrorPosition([&] { std::istringstream in("999999999999999 1 2"); readText(in, few); }) == 19);
+}
+
+void testTextErrors() {
+	Sequence<int> numbers;
+	assert(textErrorPosition([&] { std::istringstream in("3 10 20x 30"); readText(in, numbers); }) == 5);
+	assert(textErrorPosition([&] { std::istringstream in("2 1 99999999999"); readText(in, numbers); }) == 4);
+	assert(textErrorPosition([&] { std::istringstream in("  "); readText(in, numbers); }) == 0);
+	assert(textErrorPosition([&] { std::istringstream in("3 1 2 "); readText(in, numbers); }) == 6);
+	assert(textErrorPosition([&] { std::istringstream in("-1 1"); readText(in, numbers); }) == 0);
+	Sequence<uint16_t> shorts;
+	assert(textErrorPosition([&] { std::istringstream in("2 0x1 7"); readText(in, shorts); }) == 2);
+
+	bool caught = false;
+	try {
+		std::istringstream in("1 abc");
+		readText(in, numbers);
+	}
+	catch (const SequenceFormatError& error) {
+		caught = std::string(error.what()).find("abc at byte 2") != std::string::npos;
+	}
+	assert(caught);
+}
+
+void testTextFileDescriptor() {
+	std::FILE* file = std::tmpfile();
+	assert(file != nullptr);
+	int fd = SEQUENCE_TEST_FILENO(file);
+
+	// enough numbers for several blocks, with tokens crossing the block boundaries
+	const int count = 50000;
+	std::string text = std::to_string(count);
+	for (int i = 0; i < count; i++) {
+		text += (i % 7 == 0) ? "\n" : " ";
+		text += std::to_string(i * 37 - 900000);
+	}
+	text += " 2 5 6";
+	assert(SEQUENCE_TEST_WRITE(fd, text.data(), static_cast<unsigned>(text.size())) == static_cast<long long>(text.size()));
+	SEQUENCE_TEST_LSEEK(fd, 0, SEEK_SET);
+
+	Sequence<int> numbers;
+	readText(fd, numbers);
+	assert(numbers.getSize() == count && numbers[0] == -900000 && numbers[count - 1] == (count - 1) * 37 - 900000);
+	// the bytes read past the last element were given back
+	Sequence<short> after;
+	readText(fd, after);
+	assert(after.getSize() == 2 && after[1] == 6);
+	assert(textErrorPosition([&] { readText(fd, after); }) == 0);
+	std::fclose(file);
+}
+
+void testTextFormat() {
+	Sequence<int> numbers(size_t(0), size_t(10));
+	numbers.push_back(-3).push_back(0).push_back(2147483647);
+	std::ostringstream plain;
+	plain << numbers;
+	assert(plain.str() == "Sequence (capacity = 10, size = 3): -3 0 2147483647 \n");
+
+	std::ostringstream limited;
+	numbers.print(limited, FormatOptions{ .separator = ", ", .limit = 2 });
+	numbers.print(limited, FormatOptions{ .separator = "|", .header = false });
+	assert(limited.str() == "Sequence (capacity = 10, size = 3): -3, 0, ..., \n-3|0|2147483647|\n");
+
+	// doubles follow the stream's precision and float field like operator<< on each element did
+	Sequence<double> values;
+	values.push_back(1.0 / 3).push_back(-2.5).push_back(1e21);
+	std::ostringstream general;
+	general << values;
+	std::ostringstream fixed;
+	fixed << std::fixed << std::setprecision(2) << values;
+	std::ostringstream reference;
+	reference << std::fixed << std::setprecision(2) << values[0] << ' ' << values[1] << ' ' << values[2] << ' ';
+	assert(general.str() == "Sequence (capacity = 100, size = 3): 0.333333 -2.5 1e+21 \n");
+	assert(fixed.str() == "Sequence (capacity = 100, size = 3): " + reference.str() + "\n");
+
+	// settings the fast path does not render are left to operator<<
+	std::ostringstream hex;
+	hex << std::hex << numbers;
+	assert(hex.str() == "Sequence (capacity = a, size = 3): fffffffd 0 7fffffff \n");
+
+	Sequence<std::string> words;
+	words.push_back("one").push_back("").push_back("three");
+	Sequence<bool> flags;
+	flags.push_back(true).push_back(false);
+	Sequence<Sequence<int>> nested;
+	nested.push_back(numbers);
+	std::ostringstream mixed;
+	mixed << words << flags << nested;
+	assert(mixed.str() == "Sequence (capacity = 100, size = 3): one  three \nSequence (capacity = 100, size = 2): 1 0 \n"
+		"Sequence (capacity = 100, size = 1): Sequence (capacity = 10, size = 3): -3 0 2147483647 \n \n");
+
+	// more output than one block
+	Sequence<long long> many;
+	for (long long i = 0; i < 30000; i++) {
+		many.push_back(i * 1000003);
+	}
+	std::ostringstream big;
+	big << many;
+	std::ostringstream manyReference;
+	manyReference << "Sequence (capacity = " << many.getCapacity() << ", size = 30000): ";
+	for (long long value : many) {
+		manyReference << value << ' ';
+	}
+	manyReference << '\n';
+	assert(big.str().size() > SequenceText::blockSize && big.str() == manyReference.str());
+}
+
+size_t testText() {
+	runTest(testTextStream);
+	runTest(testTextErrors);
+	runTest(testTextFormat);
+	return runTest(testTextFileDescriptor);
+}
@@ -0,0 +1,27 @@
+#ifndef TRACKED_ELEMENT_H
+#define TRACKED_ELEMENT_H
+
+#include <cstddef>
+
+// element type without a default constructor that counts its live instances, copies and moves
+struct TrackedElement {
+	static inline size_t alive = 0;
+	static inline size_t copies = 0;
+	static inline size_t moves = 0;
+
+	int value;
+
+	explicit TrackedElement(int value) : value(value) { ++alive; }
+	TrackedElement(const TrackedElement& other) : value(other.value) { ++alive; ++copies; }
+	TrackedElement(TrackedElement&& other) noexcept : value(other.value) { ++alive; ++moves; }
+	TrackedElement& operator=(const TrackedElement& other) { value = other.value; ++copies; return *this; }
+	TrackedElement& operator=(TrackedElement&& other) noexcept { value = other.value; ++moves; return *this; }
+	~TrackedElement() { --alive; }
+
+	bool operator==(const TrackedElement& other) const noexcept { return value == other.value; }
+	bool operator!=(const TrackedElement& other) const noexcept { return value != other.value; }
+
+	static void reset() noexcept { copies = 0; moves = 0; }
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "../../include/SortedSequence.h"
+#include "runTestMethods.h"
+#include "cassert"
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+static_assert(std::ranges::contiguous_range<SequenceView<int>> && std::ranges::borrowed_range<SequenceView<int>>);
+static_assert(std::is_trivially_copyable_v<SequenceView<std::string>> && sizeof(SequenceView<int>) == sizeof(void*) + sizeof(size_t));
+
+void testSlicing() {
+	Sequence<int> seq;
+	for (int i = 0; i < 10; i++) {
+		seq.push_back(i % 4);
+	}
+	SequenceView<int> middle = seq.slice(2, 7);
+	assert(middle.getSize() == 5 && middle.data() == seq.data() + 2);
+	assert(middle[0] == 2 && middle.front() == 2 && middle.back() == 2 && middle.at(4) == 2);
+	assert(middle.find(0) == 2 && middle.findLast(3) == 1 && middle.find(9) == 5);
+	assert(middle.contains(1) && !middle.contains(9) && middle.containsLotsOf(2) == 2);
+
+	SequenceView<int> head = seq.first(3);
+	SequenceView<int> tail = seq.last(3);
+	assert(head.getSize() == 3 && head[2] == 2 && tail.getSize() == 3 && tail[0] == 3 && tail.back() == 1);
+	assert(seq.first(0).isEmpty() && seq.last(10).getSize() == 10 && seq.slice(10, 10).isEmpty());
+
+	// views of views narrow the same elements
+	assert(middle.slice(1, 3).data() == seq.data() + 3 && middle.first(2).back() == 3 && middle.last(1)[0] == 2);
+
+	bool thrown = false;
+	try { (void)seq.slice(4, 3); }
+	catch (const std::out_of_range&) { thrown = true; }
+	assert(thrown);
+	thrown = false;
+	try { (void)seq.last(11); }
+	catch (const std::out_of_range&) { thrown = true; }
+	assert(thrown);
+	thrown = false;
+	try { (void)middle.at(5); }
+	catch (const std::out_of_range&) { thrown = true; }
+	assert(thrown);
+	thrown = false;
+	try { (void)SequenceView<int>().front(); }
+	catch (const std::out_of_range&) { thrown = true; }
+	assert(thrown);
+}
+
+void testViewComparison() {
+	Sequence<int> seq;
+	for (int i = 0; i < 8; i++) {
+		seq.push_back(i % 4);
+	}
+	assert(seq.first(4) == seq.last(4) && seq.first(4) != seq.first(3) && seq.slice(0, 2) != seq.slice(1, 3));
+	assert(SequenceView<int>() == seq.slice(3, 3));
+	// a whole sequence converts to a view of itself
+	SequenceView<int> whole = seq;
+	assert(whole.getSize() == 8 && whole == seq && seq.first(4) != seq);
+
+	Sequence<std::string> words;
+	words.push_back("a").push_back("b").push_back("a").push_back("b");
+	assert(words.first(2) == words.last(2) && words.slice(1, 3) != words.first(2));
+	assert(words.slice(1, 4).find("a") == 1 && words.last(3).containsLotsOf("b") == 2);
+
+	SortedSequence<int> sorted;
+	sorted.insert(5);
+	sorted.insert(1);
+	sorted.insert(3);
+	assert(sorted.first(2)[1] == 3 && sorted.last(1).front() == 5);
+}
+
+void testViewAsSpan() {
+	Sequence<int> seq;
+	for (int i = 1; i <= 6; i++) {
+		seq.push_back(i);
+	}
+	std::span<const int> span = seq.slice(1, 4);
+	assert(span.size() == 3 && span[0] == 2 && span.data() == seq.data() + 1);
+	SequenceView<int> back(span);
+	assert(back == seq.slice(1, 4));
+
+	SequenceView<int> tail = seq.last(3);
+	assert(std::accumulate(tail.begin(), tail.end(), 0) == 15 && *tail.rbegin() == 6);
+	int sum = 0;
+	for (int value : seq.first(2)) {
+		sum += value;
+	}
+	assert(sum == 3 && std::ranges::count_if(seq.slice(0, 6), [](int value) { return value > 3; }) == 3);
+}
+
+size_t testViews() {
+	runTest(testSlicing);
+	runTest(testViewComparison);
+	return runTest(testViewAsSpan);
+}